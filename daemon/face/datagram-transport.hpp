@@ -92,6 +92,11 @@ protected:
   resetRecentlyReceived();
 
 protected:
+  /**
+   * \brief Maximum number of datagrams read from the socket in one completion handler.
+   */
+  static constexpr size_t RECEIVE_BATCH_SIZE = 32;
+
   typename protocol::socket m_socket;
   typename protocol::endpoint m_sender;
 
@@ -118,6 +123,12 @@ DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol:
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
 
+  // needed to drain the socket in handleReceive() without blocking
+  m_socket.non_blocking(true, error);
+  if (error) {
+    NFD_LOG_FACE_WARN("Failed to set socket to non-blocking mode: " << error.message());
+  }
+
   m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
                               [this] (auto&&... args) {
                                 this->handleReceive(std::forward<decltype(args)>(args)...);
@@ -204,6 +215,22 @@ DatagramTransport<T, U>::handleReceive(const boost::system::error_code& error, s
 {
   receiveDatagram(ndn::make_span(m_receiveBuffer).first(nBytesReceived), error);
 
+  // Under load, more datagrams are usually queued on the socket already. Reading them here
+  // saves a trip through the event loop and a completion handler for each of them.
+  if (!error && m_socket.non_blocking()) {
+    for (size_t i = 1; i < RECEIVE_BATCH_SIZE && m_socket.is_open(); ++i) {
+      boost::system::error_code ec;
+      size_t nBytes = m_socket.receive_from(boost::asio::buffer(m_receiveBuffer), m_sender, 0, ec);
+      if (ec == boost::asio::error::would_block) {
+        break;
+      }
+      receiveDatagram(ndn::make_span(m_receiveBuffer).first(nBytes), ec);
+      if (ec) {
+        break;
+      }
+    }
+  }
+
   if (m_socket.is_open())
     m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
                                 [this] (auto&&... args) {
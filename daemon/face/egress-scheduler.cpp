@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "egress-scheduler.hpp"
+#include "common/global.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nfd::face {
+
+EgressScheduler::EgressScheduler(const Options& options, SendFunc send)
+  : m_options(options)
+  , m_send(std::move(send))
+{
+  BOOST_ASSERT(m_send != nullptr);
+  resetQueues();
+}
+
+void
+EgressScheduler::setOptions(const Options& options)
+{
+  if (!isEnabled() || options.rate == 0) {
+    // either there is nothing queued, or the new options disable the scheduler
+    m_refillEvent.cancel();
+    for (const auto& queue : m_queues) {
+      for (const auto& packet : queue.packets) {
+        m_send(packet);
+      }
+    }
+    m_options = options;
+    resetQueues();
+    return;
+  }
+
+  // bring the bucket up to date at the old rate, it must not refill on every config reload
+  refillTokens();
+  m_tokens = std::min(m_tokens, static_cast<int64_t>(options.burst) * NANO);
+
+  auto adopt = [] (Queue& to, Queue& from) {
+    to.packets.swap(from.packets);
+    to.nBytes = std::exchange(from.nBytes, 0);
+    to.deficit = std::exchange(from.deficit, 0);
+  };
+
+  // traffic classes are identified by their prefixes
+  std::vector<Queue> queues(options.classes.size() + 1);
+  adopt(queues[0], m_queues[0]);
+  for (size_t i = 0; i < options.classes.size(); ++i) {
+    queues[i + 1].weight = options.classes[i].weight;
+    auto old = std::find_if(m_options.classes.begin(), m_options.classes.end(),
+                            [&] (const auto& tc) { return tc.prefix == options.classes[i].prefix; });
+    if (old != m_options.classes.end()) {
+      adopt(queues[i + 1], m_queues[std::distance(m_options.classes.begin(), old) + 1]);
+    }
+  }
+
+  // packets of the classes that no longer exist are transmitted immediately
+  for (const auto& queue : m_queues) {
+    for (const auto& packet : queue.packets) {
+      m_send(packet);
+    }
+    m_nQueuedBytes -= queue.nBytes;
+  }
+
+  bool isSameClasses = std::equal(m_options.classes.begin(), m_options.classes.end(),
+                                  options.classes.begin(), options.classes.end(),
+                                  [] (const auto& a, const auto& b) { return a.prefix == b.prefix; });
+  if (!isSameClasses) {
+    m_current = 0;
+    m_hasRoundCredit = false;
+  }
+
+  m_queues = std::move(queues);
+  m_options = options;
+
+  // the pending refill was computed for the old rate
+  m_refillEvent.cancel();
+  if (m_nQueuedBytes > 0) {
+    transmit();
+  }
+}
+
+void
+EgressScheduler::resetQueues()
+{
+  m_queues.clear();
+  m_queues.resize(m_options.classes.size() + 1);
+  BOOST_ASSERT(m_options.rate <= MAX_RATE);
+  BOOST_ASSERT(m_options.burst <= MAX_BURST);
+  for (size_t i = 0; i < m_options.classes.size(); ++i) {
+    BOOST_ASSERT(m_options.classes[i].weight > 0);
+    m_queues[i + 1].weight = m_options.classes[i].weight;
+  }
+  m_nQueuedBytes = 0;
+  m_current = 0;
+  m_hasRoundCredit = false;
+
+  m_tokens = static_cast<int64_t>(m_options.burst) * NANO;
+  m_lastRefill = time::steady_clock::now();
+}
+
+size_t
+EgressScheduler::classify(const Name& name) const
+{
+  size_t trafficClass = 0;
+  size_t matchLength = 0;
+  for (size_t i = 0; i < m_options.classes.size(); ++i) {
+    const Name& prefix = m_options.classes[i].prefix;
+    if ((trafficClass == 0 || prefix.size() > matchLength) && prefix.isPrefixOf(name)) {
+      trafficClass = i + 1;
+      matchLength = prefix.size();
+    }
+  }
+  return trafficClass;
+}
+
+bool
+EgressScheduler::enqueue(const Block& packet, size_t trafficClass)
+{
+  if (!isEnabled()) {
+    m_send(packet);
+    return true;
+  }
+
+  BOOST_ASSERT(trafficClass < m_queues.size());
+  auto& queue = m_queues[trafficClass];
+  if (queue.nBytes + packet.size() > m_options.queueLimit) {
+    return false;
+  }
+
+  queue.packets.push_back(packet);
+  queue.nBytes += packet.size();
+  m_nQueuedBytes += packet.size();
+
+  if (!m_refillEvent) {
+    transmit();
+  }
+  return true;
+}
+
+void
+EgressScheduler::refillTokens()
+{
+  auto now = time::steady_clock::now();
+  auto elapsed = time::duration_cast<time::nanoseconds>(now - m_lastRefill).count();
+  m_lastRefill = now;
+
+  auto rate = static_cast<int64_t>(m_options.rate);
+  int64_t room = static_cast<int64_t>(m_options.burst) * NANO - m_tokens;
+  // compare before multiplying, so that a long idle period cannot overflow
+  if (elapsed > room / rate) {
+    m_tokens += room;
+  }
+  else {
+    m_tokens += elapsed * rate;
+  }
+}
+
+void
+EgressScheduler::transmit()
+{
+  refillTokens();
+
+  while (m_nQueuedBytes > 0) {
+    auto& queue = m_queues[m_current];
+    if (queue.packets.empty()) {
+      queue.deficit = 0;
+      m_current = (m_current + 1) % m_queues.size();
+      m_hasRoundCredit = false;
+      continue;
+    }
+
+    if (!m_hasRoundCredit) {
+      queue.deficit += QUANTUM * queue.weight;
+      m_hasRoundCredit = true;
+    }
+
+    size_t packetSize = queue.packets.front().size();
+    if (packetSize > queue.deficit) {
+      m_current = (m_current + 1) % m_queues.size();
+      m_hasRoundCredit = false;
+      continue;
+    }
+
+    // a packet larger than the bucket can still be sent once the bucket is full
+    int64_t needed = static_cast<int64_t>(std::min(packetSize, m_options.burst)) * NANO;
+    if (m_tokens < needed) {
+      auto rate = static_cast<int64_t>(m_options.rate);
+      time::nanoseconds wait((needed - m_tokens + rate - 1) / rate);
+      m_refillEvent = getScheduler().schedule(wait, [this] { transmit(); });
+      return;
+    }
+
+    Block packet = std::move(queue.packets.front());
+    queue.packets.pop_front();
+    queue.nBytes -= packetSize;
+    queue.deficit -= packetSize;
+    m_nQueuedBytes -= packetSize;
+    m_tokens -= static_cast<int64_t>(packetSize) * NANO;
+    m_send(packet);
+  }
+}
+
+} // namespace nfd::face
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
+#define NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
+
+#include "face-common.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <deque>
+#include <functional>
+
+namespace nfd::face {
+
+/**
+ * \brief Shapes the outgoing traffic of a face.
+ *
+ * Outgoing packets are placed into one of several traffic classes. Traffic classes are served
+ * in Deficit Round Robin order in proportion to their weights, and the aggregate rate is limited
+ * by a token bucket. Packets that would exceed the queue limit of their traffic class are dropped.
+ *
+ * When the rate is zero, the scheduler is disabled and every packet is transmitted immediately.
+ */
+class EgressScheduler : noncopyable
+{
+public:
+  /**
+   * \brief A traffic class selected by name prefix.
+   */
+  struct TrafficClass
+  {
+    /// Packets under this prefix belong to the class, unless a longer prefix also matches.
+    Name prefix;
+    /// Relative share of the rate; must be positive.
+    size_t weight = 1;
+  };
+
+  /**
+   * \brief %Options that control the behavior of EgressScheduler.
+   */
+  struct Options
+  {
+    /// Token bucket rate in bytes per second, up to #MAX_RATE; zero disables the scheduler.
+    uint64_t rate = 0;
+    /// Token bucket depth in bytes, up to #MAX_BURST, i.e., the largest burst sent at line rate.
+    size_t burst = 65536;
+    /// Maximum number of bytes queued in each traffic class.
+    size_t queueLimit = 262144;
+    /// Traffic classes in addition to the default class, which has a weight of 1.
+    std::vector<TrafficClass> classes;
+  };
+
+  using SendFunc = std::function<void(const Block&)>;
+
+  static constexpr uint64_t MAX_RATE = 100'000'000'000;
+  static constexpr size_t MAX_BURST = 1 << 30;
+
+  EgressScheduler(const Options& options, SendFunc send);
+
+  /**
+   * \brief Changes the options.
+   *
+   * Packets queued in the default class, or in a traffic class whose prefix is still
+   * configured, stay queued, and the token bucket keeps its level up to the new burst size.
+   * Packets queued in a removed traffic class, or all queued packets if the new options
+   * disable the scheduler, are transmitted immediately.
+   */
+  void
+  setOptions(const Options& options);
+
+  bool
+  isEnabled() const noexcept
+  {
+    return m_options.rate > 0;
+  }
+
+  /**
+   * \brief Returns the traffic class of a packet with the given name.
+   * \return index into Options::classes plus one, or zero for the default class
+   */
+  size_t
+  classify(const Name& name) const;
+
+  /**
+   * \brief Queues a packet for transmission in the specified traffic class.
+   * \retval false the packet has been dropped because its queue is full
+   */
+  bool
+  enqueue(const Block& packet, size_t trafficClass);
+
+  /**
+   * \brief Returns the number of bytes waiting for transmission.
+   */
+  size_t
+  getQueueLength() const noexcept
+  {
+    return m_nQueuedBytes;
+  }
+
+private:
+  void
+  resetQueues();
+
+  /** \brief Transmits queued packets until the queues are empty or the tokens run out.
+   */
+  void
+  transmit();
+
+  void
+  refillTokens();
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// Amount added to the deficit counter of a class per unit of weight in each round.
+  static constexpr size_t QUANTUM = ndn::MAX_NDN_PACKET_SIZE;
+
+private:
+  static constexpr int64_t NANO = 1'000'000'000;
+
+  struct Queue
+  {
+    std::deque<Block> packets;
+    size_t nBytes = 0;
+    size_t weight = 1;
+    size_t deficit = 0;
+  };
+
+  Options m_options;
+  SendFunc m_send;
+  std::vector<Queue> m_queues;
+  size_t m_nQueuedBytes = 0;
+  size_t m_current = 0;
+  bool m_hasRoundCredit = false;
+
+  /// Tokens in units of 10^-9 byte, so that refilling at any rate is exact.
+  int64_t m_tokens = 0;
+  time::steady_clock::time_point m_lastRefill;
+  ndn::scheduler::ScopedEventId m_refillEvent;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
@@ -24,10 +24,14 @@
  */
 
 #include "face-system.hpp"
+#include "face.hpp"
+#include "generic-link-service.hpp"
 #include "netdev-bound.hpp"
 #include "protocol-factory.hpp"
 #include "fw/face-table.hpp"
 
+#include <limits>
+
 namespace nfd::face {
 
 NFD_LOG_INIT(FaceSystem);
@@ -36,6 +40,8 @@ const std::string CFGSEC_FACESYSTEM = "face_system";
 const std::string CFGSEC_GENERAL = "general";
 const std::string CFGSEC_GENERAL_FQ = CFGSEC_FACESYSTEM + ".general";
 const std::string CFGSEC_NETDEVBOUND = "netdev_bound";
+const std::string CFGSEC_EGRESS = "egress";
+const std::string CFGSEC_EGRESS_FQ = CFGSEC_FACESYSTEM + ".egress";
 
 FaceSystem::FaceSystem(FaceTable& faceTable, shared_ptr<ndn::net::NetworkMonitor> netmon)
   : m_faceTable(faceTable)
@@ -48,6 +54,10 @@ FaceSystem::FaceSystem(FaceTable& faceTable, shared_ptr<ndn::net::NetworkMonitor
   }
 
   m_netdevBound = make_unique<NetdevBound>(pfCtorParams, *this);
+
+  m_afterAddFaceConn = m_faceTable.afterAdd.connect([this] (Face& face) {
+    applyLinkServiceOptions(face);
+  });
 }
 
 ProtocolFactoryCtorParams
@@ -111,12 +121,44 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
       if (key == "enable_congestion_marking") {
         context.generalConfig.wantCongestionMarking = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
       }
+      else if (key == "congestion_detection") {
+        auto value = pair.second.get_value<std::string>();
+        if (value == "queue_length") {
+          context.generalConfig.wantSojournTimeCongestionDetection = false;
+        }
+        else if (value == "sojourn_time") {
+          context.generalConfig.wantSojournTimeCongestionDetection = true;
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("Invalid value '" + value + "' for option '" + key +
+                                      "' in section '" + CFGSEC_GENERAL_FQ + "'"));
+        }
+      }
+      else if (key == "congestion_target_delay") {
+        auto ms = ConfigFile::parseNumber<uint32_t>(pair, CFGSEC_GENERAL_FQ);
+        ConfigFile::checkRange(ms, 1U, 1000U, key, CFGSEC_GENERAL_FQ);
+        context.generalConfig.congestionTargetDelay = time::milliseconds(ms);
+      }
       else {
         NDN_THROW(ConfigFile::Error("Unrecognized option " + CFGSEC_GENERAL_FQ + "." + key));
       }
     }
   }
 
+  // process egress section
+  EgressScheduler::Options egressOptions;
+  auto egressSection = configSection.get_child_optional(CFGSEC_EGRESS);
+  if (egressSection) {
+    egressOptions = parseEgressSection(*egressSection);
+  }
+  if (!isDryRun) {
+    m_generalConfig = context.generalConfig;
+    m_egressOptions = std::move(egressOptions);
+    for (Face& face : m_faceTable) {
+      applyLinkServiceOptions(face);
+    }
+  }
+
   // process in protocol factories
   for (const auto& [sectionName, factory] : m_factories) {
     std::set<std::string> oldProvidedSchemes = factory->getProvidedSchemes();
@@ -153,7 +195,7 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
     }
 
     if (sectionName == CFGSEC_GENERAL || sectionName == CFGSEC_NETDEVBOUND ||
-        m_factories.count(sectionName) > 0) {
+        sectionName == CFGSEC_EGRESS || m_factories.count(sectionName) > 0) {
       continue;
     }
 
@@ -161,4 +203,70 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
   }
 }
 
+EgressScheduler::Options
+FaceSystem::parseEgressSection(const ConfigSection& section)
+{
+  EgressScheduler::Options options;
+  for (const auto& pair : section) {
+    const std::string& key = pair.first;
+    if (key == "rate") {
+      options.rate = ConfigFile::parseNumber<uint64_t>(pair, CFGSEC_EGRESS_FQ);
+      ConfigFile::checkRange(options.rate, uint64_t(0), EgressScheduler::MAX_RATE, key, CFGSEC_EGRESS_FQ);
+    }
+    else if (key == "burst") {
+      options.burst = ConfigFile::parseNumber<size_t>(pair, CFGSEC_EGRESS_FQ);
+      ConfigFile::checkRange(options.burst, size_t(ndn::MAX_NDN_PACKET_SIZE),
+                             EgressScheduler::MAX_BURST, key, CFGSEC_EGRESS_FQ);
+    }
+    else if (key == "queue_limit") {
+      options.queueLimit = ConfigFile::parseNumber<size_t>(pair, CFGSEC_EGRESS_FQ);
+      ConfigFile::checkRange(options.queueLimit, size_t(ndn::MAX_NDN_PACKET_SIZE),
+                             std::numeric_limits<size_t>::max(), key, CFGSEC_EGRESS_FQ);
+    }
+    else if (key == "class") {
+      const std::string classSection = CFGSEC_EGRESS_FQ + ".class";
+      EgressScheduler::TrafficClass tc;
+      bool hasPrefix = false;
+      for (const auto& classPair : pair.second) {
+        if (classPair.first == "prefix") {
+          tc.prefix = Name(classPair.second.get_value<std::string>());
+          hasPrefix = true;
+        }
+        else if (classPair.first == "weight") {
+          tc.weight = ConfigFile::parseNumber<size_t>(classPair, classSection);
+          ConfigFile::checkRange(tc.weight, size_t(1), size_t(1000), classPair.first, classSection);
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("Unrecognized option " + classSection + "." + classPair.first));
+        }
+      }
+      if (!hasPrefix) {
+        NDN_THROW(ConfigFile::Error("Missing option " + classSection + ".prefix"));
+      }
+      options.classes.push_back(std::move(tc));
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unrecognized option " + CFGSEC_EGRESS_FQ + "." + key));
+    }
+  }
+  return options;
+}
+
+void
+FaceSystem::applyLinkServiceOptions(Face& face) const
+{
+  auto linkService = dynamic_cast<GenericLinkService*>(face.getLinkService());
+  if (linkService == nullptr) {
+    return;
+  }
+
+  auto options = linkService->getOptions();
+  options.wantSojournTimeCongestionDetection = m_generalConfig.wantSojournTimeCongestionDetection;
+  options.congestionTargetDelay = m_generalConfig.congestionTargetDelay;
+  if (face.getScope() != ndn::nfd::FACE_SCOPE_LOCAL) {
+    options.egressOptions = m_egressOptions;
+  }
+  linkService->setOptions(options);
+}
+
 } // namespace nfd::face
@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_FACE_FACE_SYSTEM_HPP
 #define NFD_DAEMON_FACE_FACE_SYSTEM_HPP
 
+#include "egress-scheduler.hpp"
 #include "common/config-file.hpp"
 
 #include <ndn-cxx/net/network-address.hpp>
@@ -41,6 +42,7 @@ class FaceTable;
 
 namespace face {
 
+class Face;
 class NetdevBound;
 class ProtocolFactory;
 struct ProtocolFactoryCtorParams;
@@ -95,6 +97,8 @@ public:
   struct GeneralConfig
   {
     bool wantCongestionMarking = true;
+    bool wantSojournTimeCongestionDetection = false;
+    time::nanoseconds congestionTargetDelay = 5_ms;
   };
 
   /** \brief Context for processing a config section in ProtocolFactory.
@@ -115,6 +119,14 @@ private:
   processConfig(const ConfigSection& configSection, bool isDryRun,
                 const std::string& filename);
 
+  static EgressScheduler::Options
+  parseEgressSection(const ConfigSection& section);
+
+  /** \brief Applies congestion detection and egress scheduling options to a face.
+   */
+  void
+  applyLinkServiceOptions(Face& face) const;
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief Config section name => protocol factory.
    */
@@ -130,6 +142,18 @@ private:
 
   FaceTable& m_faceTable;
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief Options from `general` section, as of the last configuration load.
+   */
+  GeneralConfig m_generalConfig;
+
+  /** \brief Egress scheduling options for non-local faces, from `egress` section.
+   */
+  EgressScheduler::Options m_egressOptions;
+
+private:
+  signal::ScopedConnection m_afterAddFaceConn;
 };
 
 } // namespace face
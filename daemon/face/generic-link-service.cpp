@@ -39,11 +39,17 @@ constexpr size_t CONGESTION_MARK_SIZE = tlv::sizeOfVarNumber(lp::tlv::Congestion
                                         tlv::sizeOfVarNumber(sizeof(uint64_t)) +        // length
                                         tlv::sizeOfNonNegativeInteger(UINT64_MAX);      // value
 
+// A drain rate measurement of the send queue starts only when the queue holds at least this
+// many bytes, so that the link stays busy during the measurement (RFC 8033 section 5.2)
+constexpr size_t DRAIN_RATE_MIN_QUEUE_LENGTH = 16384;
+constexpr time::nanoseconds DRAIN_RATE_SAMPLE_PERIOD = 10_ms;
+
 GenericLinkService::GenericLinkService(const GenericLinkService::Options& options)
   : m_options(options)
   , m_fragmenter(m_options.fragmenterOptions, this)
   , m_reassembler(m_options.reassemblerOptions, this)
   , m_reliability(m_options.reliabilityOptions, this)
+  , m_egress(m_options.egressOptions, [this] (const Block& packet) { this->sendPacket(packet); })
 {
   m_reassembler.beforeTimeout.connect([this] (auto&&...) { ++nReassemblyTimeouts; });
   m_reliability.onDroppedInterest.connect([this] (const auto& i) { notifyDroppedInterest(i); });
@@ -57,6 +63,7 @@ GenericLinkService::setOptions(const GenericLinkService::Options& options)
   m_fragmenter.setOptions(m_options.fragmenterOptions);
   m_reassembler.setOptions(m_options.reassemblerOptions);
   m_reliability.setOptions(m_options.reliabilityOptions);
+  m_egress.setOptions(m_options.egressOptions);
 }
 
 ssize_t
@@ -88,7 +95,7 @@ GenericLinkService::requestIdlePacket()
 }
 
 void
-GenericLinkService::sendLpPacket(lp::Packet&& pkt)
+GenericLinkService::sendLpPacket(lp::Packet&& pkt, size_t trafficClass)
 {
   const ssize_t mtu = getEffectiveMtu();
 
@@ -106,7 +113,13 @@ GenericLinkService::sendLpPacket(lp::Packet&& pkt)
     NFD_LOG_FACE_WARN("attempted to send packet over MTU limit");
     return;
   }
-  this->sendPacket(block);
+
+  if (!m_egress.enqueue(block, trafficClass)) {
+    ++nEgressDropped;
+    NFD_LOG_FACE_TRACE("egress queue of traffic class " << trafficClass << " is full: DROP");
+    return;
+  }
+  m_nSentBytes += block.size();
 }
 
 void
@@ -116,7 +129,7 @@ GenericLinkService::doSendInterest(const Interest& interest)
 
   encodeLpFields(interest, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), true);
+  this->sendNetPacket(std::move(lpPacket), true, interest.getName());
 }
 
 void
@@ -126,7 +139,7 @@ GenericLinkService::doSendData(const Data& data)
 
   encodeLpFields(data, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), false);
+  this->sendNetPacket(std::move(lpPacket), false, data.getName());
 }
 
 void
@@ -137,7 +150,7 @@ GenericLinkService::doSendNack(const lp::Nack& nack)
 
   encodeLpFields(nack, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), false);
+  this->sendNetPacket(std::move(lpPacket), false, nack.getInterest().getName());
 }
 
 void
@@ -182,7 +195,7 @@ GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lp
 }
 
 void
-GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
+GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest, const Name& name)
 {
   std::vector<lp::Packet> frags;
   ssize_t mtu = getEffectiveMtu();
@@ -234,8 +247,9 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
     m_reliability.handleOutgoing(frags, std::move(pkt), isInterest);
   }
 
+  size_t trafficClass = m_egress.classify(name);
   for (lp::Packet& frag : frags) {
-    this->sendLpPacket(std::move(frag));
+    this->sendLpPacket(std::move(frag), trafficClass);
   }
 }
 
@@ -243,19 +257,36 @@ void
 GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
 {
   ssize_t sendQueueLength = getTransport()->getSendQueueLength();
+  // Packets held back by the egress scheduler are part of the send queue
+  if (m_egress.isEnabled()) {
+    sendQueueLength = std::max<ssize_t>(sendQueueLength, 0) +
+                      static_cast<ssize_t>(m_egress.getQueueLength());
+  }
   // The transport must support retrieving the current send queue length
   if (sendQueueLength < 0) {
     return;
   }
 
-  if (sendQueueLength > 0) {
-    NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " threshold=" <<
-                       m_options.defaultCongestionThreshold << " capacity=" <<
-                       getTransport()->getSendQueueCapacity());
+  bool isCongested = false;
+  if (m_options.wantSojournTimeCongestionDetection) {
+    auto delay = getSendQueueDelay(static_cast<size_t>(sendQueueLength));
+    if (sendQueueLength > 0) {
+      NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " delay=" << delay <<
+                         " target=" << m_options.congestionTargetDelay);
+    }
+    isCongested = delay > m_options.congestionTargetDelay;
+  }
+  else {
+    if (sendQueueLength > 0) {
+      NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " threshold=" <<
+                         m_options.defaultCongestionThreshold << " capacity=" <<
+                         getTransport()->getSendQueueCapacity());
+    }
+    isCongested = static_cast<size_t>(sendQueueLength) > m_options.defaultCongestionThreshold;
   }
 
   // sendQueue is above target
-  if (static_cast<size_t>(sendQueueLength) > m_options.defaultCongestionThreshold) {
+  if (isCongested) {
     const auto now = time::steady_clock::now();
 
     if (m_nextMarkTime == time::steady_clock::time_point::max()) {
@@ -278,12 +309,62 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
   }
   else if (m_nextMarkTime != time::steady_clock::time_point::max()) {
     // Congestion incident has ended, so reset
-    NFD_LOG_FACE_DEBUG("Send queue length dropped below congestion threshold");
+    NFD_LOG_FACE_DEBUG("Send queue dropped below congestion target");
     m_nextMarkTime = time::steady_clock::time_point::max();
     m_nMarkedSinceInMarkingState = 0;
   }
 }
 
+time::nanoseconds
+GenericLinkService::getSendQueueDelay(size_t sendQueueLength)
+{
+  // Packets held by the egress scheduler are not timestamped by the transport
+  if (!m_egress.isEnabled()) {
+    auto sojournTime = getTransport()->getSendQueueSojournTime();
+    if (sojournTime) {
+      return *sojournTime;
+    }
+  }
+
+  // Otherwise, estimate the delay from the queue length and the drain rate, as in PIE (RFC 8033)
+  const auto now = time::steady_clock::now();
+  if (m_drainSampleStart == time::steady_clock::time_point::max()) {
+    if (sendQueueLength >= DRAIN_RATE_MIN_QUEUE_LENGTH) {
+      m_drainSampleStart = now;
+      m_drainSampleQueueLength = sendQueueLength;
+      m_drainSampleSentBytes = m_nSentBytes;
+    }
+  }
+  else if (sendQueueLength == 0) {
+    // the link may have been idle for part of the sample, discard it
+    m_drainSampleStart = time::steady_clock::time_point::max();
+  }
+  else if (now - m_drainSampleStart >= DRAIN_RATE_SAMPLE_PERIOD) {
+    // bytes that left the queue = bytes that entered it - growth of the queue
+    double nDeparted = static_cast<double>(m_nSentBytes - m_drainSampleSentBytes) +
+                       static_cast<double>(m_drainSampleQueueLength) -
+                       static_cast<double>(sendQueueLength);
+    double duration = time::duration_cast<time::duration<double>>(now - m_drainSampleStart).count();
+    double rate = std::max(nDeparted, 0.0) / duration;
+    m_drainRate = m_drainRate == 0.0 ? rate : 0.875 * m_drainRate + 0.125 * rate;
+    NFD_LOG_FACE_TRACE("drain rate sample=" << rate << " average=" << m_drainRate);
+
+    if (sendQueueLength >= DRAIN_RATE_MIN_QUEUE_LENGTH) {
+      m_drainSampleStart = now;
+      m_drainSampleQueueLength = sendQueueLength;
+      m_drainSampleSentBytes = m_nSentBytes;
+    }
+    else {
+      m_drainSampleStart = time::steady_clock::time_point::max();
+    }
+  }
+
+  if (m_drainRate <= 0.0) {
+    return 0_ns;
+  }
+  return time::nanoseconds(static_cast<time::nanoseconds::rep>(sendQueueLength / m_drainRate * 1e9));
+}
+
 void
 GenericLinkService::doReceivePacket(const Block& packet, const EndpointId& endpoint)
 {
@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_FACE_GENERIC_LINK_SERVICE_HPP
 #define NFD_DAEMON_FACE_GENERIC_LINK_SERVICE_HPP
 
+#include "egress-scheduler.hpp"
 #include "link-service.hpp"
 #include "lp-fragmenter.hpp"
 #include "lp-reassembler.hpp"
@@ -85,6 +86,9 @@ public:
 
   /// Count of outgoing LpPackets that were marked with congestion marks.
   PacketCounter nCongestionMarked;
+
+  /// Count of outgoing LpPackets dropped because the queue of their traffic class was full.
+  PacketCounter nEgressDropped;
 };
 
 /**
@@ -138,6 +142,24 @@ struct GenericLinkServiceOptions
    */
   size_t defaultCongestionThreshold = 65536;
 
+  /** \brief Detects congestion by the queueing delay instead of the send queue length.
+   *
+   *  Packets are marked if the queueing delay stays above #congestionTargetDelay for at least
+   *  one INTERVAL, as in CoDel. The delay is measured by the transport if it timestamps its
+   *  send queue, and is otherwise estimated from the queue length and its drain rate.
+   */
+  bool wantSojournTimeCongestionDetection = false;
+
+  /** \brief Target queueing delay when #wantSojournTimeCongestionDetection is enabled.
+   *
+   *  The default value (5 ms) is taken from RFC 8289 (CoDel).
+   */
+  time::nanoseconds congestionTargetDelay = 5_ms;
+
+  /** \brief Options for egress rate limiting and traffic classes.
+   */
+  EgressScheduler::Options egressOptions;
+
   /** \brief Enables self-learning forwarding support.
    */
   bool allowSelfLearning = true;
@@ -212,9 +234,11 @@ NFD_PROTECTED_WITH_TESTS_ELSE_PRIVATE: // send path
   requestIdlePacket();
 
   /** \brief Send an LpPacket.
+   *  \param pkt the LpPacket
+   *  \param trafficClass egress traffic class, as returned by EgressScheduler::classify()
    */
   void
-  sendLpPacket(lp::Packet&& pkt);
+  sendLpPacket(lp::Packet&& pkt, size_t trafficClass = 0);
 
   void
   doSendInterest(const Interest& interest) NFD_OVERRIDE_WITH_TESTS_ELSE_FINAL;
@@ -241,9 +265,10 @@ private: // send path
   /** \brief Send a complete network layer packet.
    *  \param pkt LpPacket containing a complete network layer packet
    *  \param isInterest whether the network layer packet is an Interest
+   *  \param name name of the network layer packet, which selects its egress traffic class
    */
   void
-  sendNetPacket(lp::Packet&& pkt, bool isInterest);
+  sendNetPacket(lp::Packet&& pkt, bool isInterest, const Name& name);
 
   /** \brief If the send queue is found to be congested, add a congestion mark to the packet
    *         according to CoDel.
@@ -252,6 +277,12 @@ private: // send path
   void
   checkCongestionLevel(lp::Packet& pkt);
 
+  /** \brief Returns the queueing delay experienced by packets in the send queue.
+   *  \param sendQueueLength current send queue length in bytes
+   */
+  time::nanoseconds
+  getSendQueueDelay(size_t sendQueueLength);
+
 private: // receive path
   void
   doReceivePacket(const Block& packet, const EndpointId& endpoint) NFD_OVERRIDE_WITH_TESTS_ELSE_FINAL;
@@ -311,6 +342,7 @@ NFD_PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   LpFragmenter m_fragmenter;
   LpReassembler m_reassembler;
   LpReliability m_reliability;
+  EgressScheduler m_egress;
   lp::Sequence m_lastSeqNo = static_cast<lp::Sequence>(-2);
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
@@ -319,6 +351,15 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /// Number of marked packets in the current incident of congestion
   size_t m_nMarkedSinceInMarkingState = 0;
 
+  /// Total bytes of LpPackets passed towards the transport
+  uint64_t m_nSentBytes = 0;
+  /// Estimated drain rate of the send queue in bytes per second, zero if not yet measured
+  double m_drainRate = 0.0;
+  /// Start of the current drain rate measurement, or time_point::max() if none
+  time::steady_clock::time_point m_drainSampleStart = time::steady_clock::time_point::max();
+  size_t m_drainSampleQueueLength = 0;
+  uint64_t m_drainSampleSentBytes = 0;
+
   friend LpReliability;
 };
 
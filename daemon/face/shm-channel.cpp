@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "shm-channel.hpp"
+#include "face.hpp"
+#include "generic-link-service.hpp"
+#include "shm-transport.hpp"
+#include "common/global.hpp"
+
+#include <boost/filesystem/exception.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(ShmChannel);
+
+namespace local = boost::asio::local;
+
+ShmChannel::ShmChannel(const shm::Endpoint& endpoint, uint32_t nSlots, bool wantCongestionMarking)
+  : m_endpoint(endpoint)
+  , m_nSlots(nSlots)
+  , m_wantCongestionMarking(wantCongestionMarking)
+  , m_acceptor(getGlobalIoService())
+{
+  BOOST_ASSERT(nSlots > 0 && (nSlots & (nSlots - 1)) == 0);
+
+  setUri(FaceUri("shm://" + m_endpoint.path()));
+  NFD_LOG_CHAN_INFO("Creating channel");
+}
+
+ShmChannel::~ShmChannel()
+{
+  if (isListening()) {
+    // use the non-throwing variants during destruction and ignore any errors
+    boost::system::error_code ec;
+    m_acceptor.close(ec);
+    NFD_LOG_CHAN_TRACE("Removing socket file");
+    boost::filesystem::remove(m_endpoint.path(), ec);
+  }
+}
+
+void
+ShmChannel::listen(const FaceCreatedCallback& onFaceCreated,
+                   const FaceCreationFailedCallback& onAcceptFailed)
+{
+  if (isListening()) {
+    NFD_LOG_CHAN_WARN("Already listening");
+    return;
+  }
+
+  namespace fs = boost::filesystem;
+
+  fs::path socketPath = m_endpoint.path();
+  fs::path parent = socketPath.parent_path();
+  if (!parent.empty() && fs::create_directories(parent)) {
+    NFD_LOG_CHAN_TRACE("Created directory " << parent);
+  }
+
+  boost::system::error_code ec;
+  fs::file_type type = fs::symlink_status(socketPath).type();
+  if (type == fs::socket_file) {
+    // same as UnixStreamChannel: do not steal the socket of another running instance
+    local::stream_protocol::socket socket(getGlobalIoService());
+    socket.connect(m_endpoint, ec);
+    if (!ec) {
+      ec = boost::system::errc::make_error_code(boost::system::errc::address_in_use);
+      NDN_THROW_NO_STACK(fs::filesystem_error("ShmChannel::listen", socketPath, ec));
+    }
+    else if (ec == boost::asio::error::connection_refused ||
+             ec == boost::asio::error::timed_out) {
+      NFD_LOG_CHAN_DEBUG("Removing stale socket file");
+      fs::remove(socketPath);
+    }
+  }
+  else if (type != fs::file_not_found) {
+    ec = boost::system::errc::make_error_code(boost::system::errc::not_a_socket);
+    NDN_THROW_NO_STACK(fs::filesystem_error("ShmChannel::listen", socketPath, ec));
+  }
+
+  try {
+    m_acceptor.open();
+    m_acceptor.bind(m_endpoint);
+    m_acceptor.listen();
+  }
+  catch (const boost::system::system_error& e) {
+    NDN_THROW_NO_STACK(fs::filesystem_error("ShmChannel::listen: "s + e.std::runtime_error::what(),
+                                            socketPath, e.code()));
+  }
+  m_isListening = true;
+
+  fs::permissions(socketPath, fs::owner_read | fs::group_read | fs::others_read |
+                              fs::owner_write | fs::group_write | fs::others_write);
+
+  accept(onFaceCreated, onAcceptFailed);
+  NFD_LOG_CHAN_DEBUG("Started listening");
+}
+
+void
+ShmChannel::accept(const FaceCreatedCallback& onFaceCreated,
+                   const FaceCreationFailedCallback& onAcceptFailed)
+{
+  m_acceptor.async_accept([=] (const boost::system::error_code& error,
+                               local::stream_protocol::socket socket) {
+    if (error) {
+      if (error != boost::asio::error::operation_aborted) {
+        NFD_LOG_CHAN_DEBUG("Accept failed: " << error.message());
+        if (onAcceptFailed)
+          onAcceptFailed(500, "Accept failed: " + error.message());
+      }
+      return;
+    }
+
+    NFD_LOG_CHAN_TRACE("Incoming connection via fd " << socket.native_handle());
+    createFace(std::move(socket), onFaceCreated, onAcceptFailed);
+
+    // prepare accepting the next connection
+    accept(onFaceCreated, onAcceptFailed);
+  });
+}
+
+void
+ShmChannel::createFace(local::stream_protocol::socket&& socket,
+                       const FaceCreatedCallback& onFaceCreated,
+                       const FaceCreationFailedCallback& onAcceptFailed)
+{
+  shared_ptr<Face> face;
+  try {
+    auto segment = make_unique<shm::Segment>(m_nSlots);
+    const shm::Segment& segmentRef = *segment;
+    int socketFd = socket.native_handle();
+    auto transport = make_unique<ShmTransport>(std::move(socket), std::move(segment));
+
+    GenericLinkService::Options options;
+    options.allowCongestionMarking = m_wantCongestionMarking;
+    auto linkService = make_unique<GenericLinkService>(options);
+    face = make_shared<Face>(std::move(linkService), std::move(transport));
+
+    // the application gets access to the segment only once the face that serves it exists
+    segmentRef.sendTo(socketFd);
+  }
+  catch (const shm::Segment::Error& e) {
+    // the connection is closed when the socket or the face goes out of scope
+    NFD_LOG_CHAN_WARN("Cannot create shared-memory face: " << e.what());
+    if (onAcceptFailed)
+      onAcceptFailed(500, "Cannot create shared-memory face: "s + e.what());
+    return;
+  }
+
+  face->setChannel(weak_from_this());
+
+  ++m_size;
+  connectFaceClosedSignal(*face, [this] { --m_size; });
+
+  onFaceCreated(face);
+}
+
+} // namespace nfd::face
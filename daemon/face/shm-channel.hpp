@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_SHM_CHANNEL_HPP
+#define NFD_DAEMON_FACE_SHM_CHANNEL_HPP
+
+#include "channel.hpp"
+
+#include <boost/asio/local/stream_protocol.hpp>
+
+namespace nfd::face::shm {
+using Endpoint = boost::asio::local::stream_protocol::endpoint;
+} // namespace nfd::face::shm
+
+namespace nfd::face {
+
+/**
+ * \brief A channel that accepts shared-memory faces from local applications.
+ *
+ * The channel listens on a Unix stream socket. For every incoming connection, it creates
+ * a shm::Segment, hands it to the application over the connection, and creates a face
+ * with a ShmTransport on top of the segment.
+ */
+class ShmChannel final : public Channel
+{
+public:
+  /**
+   * \brief Create a shared-memory channel for the specified \p endpoint.
+   *
+   * To enable the creation of faces upon incoming connections, one needs to
+   * explicitly call listen().
+   *
+   * \param endpoint Unix stream socket on which the channel listens
+   * \param nSlots number of slots in each ring of the created faces, must be a power of two
+   * \param wantCongestionMarking whether congestion marking is enabled on the created faces
+   */
+  ShmChannel(const shm::Endpoint& endpoint, uint32_t nSlots, bool wantCongestionMarking);
+
+  ~ShmChannel() final;
+
+  bool
+  isListening() const final
+  {
+    return m_isListening;
+  }
+
+  size_t
+  size() const final
+  {
+    return m_size;
+  }
+
+  /**
+   * \brief Start listening.
+   *
+   * Faces created in this way will have on-demand persistency.
+   *
+   * \param onFaceCreated  Callback to notify successful creation of the face
+   * \param onAcceptFailed Callback to notify when channel fails
+   * \throw boost::system::system_error
+   */
+  void
+  listen(const FaceCreatedCallback& onFaceCreated,
+         const FaceCreationFailedCallback& onAcceptFailed);
+
+private:
+  void
+  accept(const FaceCreatedCallback& onFaceCreated,
+         const FaceCreationFailedCallback& onAcceptFailed);
+
+  void
+  createFace(boost::asio::local::stream_protocol::socket&& socket,
+             const FaceCreatedCallback& onFaceCreated,
+             const FaceCreationFailedCallback& onAcceptFailed);
+
+private:
+  const shm::Endpoint m_endpoint;
+  const uint32_t m_nSlots;
+  const bool m_wantCongestionMarking;
+  bool m_isListening = false;
+  boost::asio::local::stream_protocol::acceptor m_acceptor;
+  size_t m_size = 0;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_SHM_CHANNEL_HPP
@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "shm-factory.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(ShmFactory);
+NFD_REGISTER_PROTOCOL_FACTORY(ShmFactory);
+
+const std::string&
+ShmFactory::getId() noexcept
+{
+  static std::string id("shm");
+  return id;
+}
+
+void
+ShmFactory::doProcessConfig(OptionalConfigSection configSection,
+                            FaceSystem::ConfigContext& context)
+{
+  // shm
+  // {
+  //   path /run/nfd/nfd-shm.sock
+  //   ring_size 256
+  // }
+
+  m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
+
+  if (!configSection) {
+    if (!context.isDryRun && !m_channels.empty()) {
+      NFD_LOG_WARN("Cannot disable shared-memory channel after initialization");
+    }
+    return;
+  }
+
+  std::string path = "/run/nfd/nfd-shm.sock";
+  uint32_t ringSize = DEFAULT_RING_SIZE;
+
+  for (const auto& [key, value] : *configSection) {
+    if (key == "path") {
+      path = value.get_value<std::string>();
+    }
+    else if (key == "ring_size") {
+      ringSize = ConfigFile::parseNumber<uint32_t>(value, key, "face_system.shm");
+      ConfigFile::checkRange<uint32_t>(ringSize, MIN_RING_SIZE, MAX_RING_SIZE, key, "face_system.shm");
+      if ((ringSize & (ringSize - 1)) != 0) {
+        NDN_THROW(ConfigFile::Error("Invalid value for option face_system.shm.ring_size: "
+                                    "must be a power of two"));
+      }
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unrecognized option face_system.shm." + key));
+    }
+  }
+
+  if (context.isDryRun) {
+    return;
+  }
+
+  auto channel = this->createChannel(path, ringSize);
+  if (!channel->isListening()) {
+    channel->listen(this->addFace, nullptr);
+  }
+}
+
+shared_ptr<ShmChannel>
+ShmFactory::createChannel(const std::string& socketPath, uint32_t nSlots)
+{
+  auto normalizedPath = boost::filesystem::weakly_canonical(boost::filesystem::absolute(socketPath));
+  shm::Endpoint endpoint(normalizedPath.string());
+
+  auto it = m_channels.find(endpoint);
+  if (it != m_channels.end())
+    return it->second;
+
+  auto channel = make_shared<ShmChannel>(endpoint, nSlots, m_wantCongestionMarking);
+  m_channels[endpoint] = channel;
+  return channel;
+}
+
+std::vector<shared_ptr<const Channel>>
+ShmFactory::doGetChannels() const
+{
+  return getChannelsFromMap(m_channels);
+}
+
+} // namespace nfd::face
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_SHM_FACTORY_HPP
+#define NFD_DAEMON_FACE_SHM_FACTORY_HPP
+
+#include "protocol-factory.hpp"
+#include "shm-channel.hpp"
+
+namespace nfd::face {
+
+/**
+ * \brief Protocol factory for shared-memory faces with local applications.
+ */
+class ShmFactory final : public ProtocolFactory
+{
+public:
+  static const std::string&
+  getId() noexcept;
+
+  using ProtocolFactory::ProtocolFactory;
+
+  /**
+   * \brief Create a shared-memory channel listening on the specified socket path.
+   *
+   * If this method is called twice with the same path, only one channel
+   * will be created. The second call will just retrieve the existing channel.
+   *
+   * \param socketPath path of the Unix stream socket on which the channel listens
+   * \param nSlots number of slots in each ring of the created faces, must be a power of two
+   */
+  shared_ptr<ShmChannel>
+  createChannel(const std::string& socketPath, uint32_t nSlots = DEFAULT_RING_SIZE);
+
+public:
+  static constexpr uint32_t DEFAULT_RING_SIZE = 256;
+  static constexpr uint32_t MIN_RING_SIZE = 16;
+  /** \brief Largest accepted `ring_size`.
+   *
+   *  Each connection maps a segment of 2 * ring_size slots of about 8.8 KB each,
+   *  so this bounds the memory any client of the socket can pin to about 72 MB.
+   */
+  static constexpr uint32_t MAX_RING_SIZE = 4096;
+
+private:
+  void
+  doProcessConfig(OptionalConfigSection configSection,
+                  FaceSystem::ConfigContext& context) final;
+
+  std::vector<shared_ptr<const Channel>>
+  doGetChannels() const final;
+
+private:
+  bool m_wantCongestionMarking = false;
+  std::map<shm::Endpoint, shared_ptr<ShmChannel>> m_channels;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_SHM_FACTORY_HPP
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "shm-segment.hpp"
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace nfd::face::shm {
+
+Segment::Segment(uint32_t nSlots)
+  : m_nSlots(nSlots)
+  , m_size(computeSegmentSize(nSlots))
+{
+  BOOST_ASSERT(nSlots > 0 && (nSlots & (nSlots - 1)) == 0);
+
+  try {
+    m_memfd = ::memfd_create("nfd-shm-face", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (m_memfd < 0) {
+      NDN_THROW_ERRNO(Error("Cannot create memfd"));
+    }
+    if (::ftruncate(m_memfd, static_cast<off_t>(m_size)) < 0) {
+      NDN_THROW_ERRNO(Error("Cannot resize memfd"));
+    }
+    // the application must not be able to truncate the segment under our mapping
+    if (::fcntl(m_memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+      NDN_THROW_ERRNO(Error("Cannot seal memfd"));
+    }
+
+    void* addr = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_memfd, 0);
+    if (addr == MAP_FAILED) {
+      NDN_THROW_ERRNO(Error("Cannot map memfd"));
+    }
+    m_header = new (addr) SegmentHeader{MAGIC, VERSION, 0, nSlots, static_cast<uint32_t>(SLOT_SIZE), {}};
+
+    for (int& fd : m_eventFds) {
+      fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      if (fd < 0) {
+        NDN_THROW_ERRNO(Error("Cannot create eventfd"));
+      }
+    }
+  }
+  catch (const Error&) {
+    close();
+    throw;
+  }
+}
+
+void
+Segment::sendTo(int socketFd) const
+{
+  uint64_t payload = m_size;
+  iovec iov{&payload, sizeof(payload)};
+
+  const int fds[] = {m_memfd, m_eventFds[Ring::TO_FORWARDER], m_eventFds[Ring::FROM_FORWARDER]};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+  ssize_t nSent = ::sendmsg(socketFd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+  if (nSent < 0) {
+    NDN_THROW_ERRNO(Error("Cannot send segment"));
+  }
+  if (static_cast<size_t>(nSent) != sizeof(payload)) {
+    NDN_THROW(Error("Cannot send segment: short write"));
+  }
+}
+
+Segment::~Segment()
+{
+  close();
+}
+
+void
+Segment::close() noexcept
+{
+  if (m_header != nullptr) {
+    ::munmap(m_header, m_size);
+    m_header = nullptr;
+  }
+  for (int& fd : m_eventFds) {
+    if (fd >= 0) {
+      ::close(fd);
+      fd = -1;
+    }
+  }
+  if (m_memfd >= 0) {
+    ::close(m_memfd);
+    m_memfd = -1;
+  }
+}
+
+} // namespace nfd::face::shm
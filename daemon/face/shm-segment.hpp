@@ -0,0 +1,347 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_SHM_SEGMENT_HPP
+#define NFD_DAEMON_FACE_SHM_SEGMENT_HPP
+
+#include "core/common.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace nfd::face::shm {
+
+/*
+ * A shared-memory face exchanges packets through a segment that consists of a SegmentHeader
+ * followed by the slots of two rings. Each ring is a single-producer single-consumer queue
+ * of fixed-size packet slots. Ring::TO_FORWARDER is written by the application and read by
+ * NFD, Ring::FROM_FORWARDER is written by NFD and read by the application.
+ *
+ * The segment lives in a memfd. It is handed to the application over a Unix stream socket,
+ * together with one eventfd per ring. After making a packet available, the producer of a
+ * ring signals the eventfd of that ring if the consumer has announced that it is about to
+ * wait, which means that no system call is made while both sides are busy.
+ *
+ * All integer fields are in host byte order, as both sides necessarily run on the same host.
+ */
+
+inline constexpr uint32_t MAGIC = 0x4d48534e; // "NSHM" in little endian
+inline constexpr uint16_t VERSION = 1;
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * \brief Size of the header that precedes the packet in each slot.
+ *
+ * The header holds the packet length as a uint32_t.
+ */
+inline constexpr size_t SLOT_HEADER_SIZE = 8;
+
+/**
+ * \brief Size of each slot, large enough for a packet of maximum size.
+ */
+inline constexpr size_t SLOT_SIZE = (SLOT_HEADER_SIZE + ndn::MAX_NDN_PACKET_SIZE + CACHE_LINE_SIZE - 1) /
+                                    CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+/**
+ * \brief Shared state of one ring.
+ *
+ * \c head and \c tail are free-running counters; the slot index is the counter
+ * modulo the number of slots, which is a power of two.
+ */
+struct RingHeader
+{
+  /// Number of packets written, only advanced by the producer.
+  alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> head{0};
+  /// Number of packets read, only advanced by the consumer.
+  alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> tail{0};
+  /// Nonzero if the consumer waits on the eventfd for new packets.
+  alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> wantNotify{0};
+};
+
+struct SegmentHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t nSlots;
+  uint32_t slotSize;
+  RingHeader rings[2];
+};
+
+/**
+ * \brief Returns the size of a segment with \p nSlots slots in each ring.
+ */
+constexpr size_t
+computeSegmentSize(uint32_t nSlots) noexcept
+{
+  return sizeof(SegmentHeader) + 2 * size_t(nSlots) * SLOT_SIZE;
+}
+
+/**
+ * \brief View of one ring of a segment.
+ *
+ * The peer has write access to the whole segment. Every index and length read from
+ * shared memory is therefore validated before use, and Error is thrown if it is invalid.
+ */
+class Ring
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  enum Direction {
+    TO_FORWARDER = 0,
+    FROM_FORWARDER = 1,
+  };
+
+  /**
+   * \param segment the mapped segment
+   * \param direction which ring of the segment
+   * \param nSlots number of slots in each ring, a power of two; NFD must pass the value it
+   *               created the segment with, never SegmentHeader::nSlots, which the peer can alter
+   */
+  Ring(SegmentHeader& segment, Direction direction, uint32_t nSlots) noexcept
+    : m_header(segment.rings[direction])
+    , m_slots(reinterpret_cast<uint8_t*>(&segment + 1) + direction * size_t(nSlots) * SLOT_SIZE)
+    , m_mask(nSlots - 1)
+  {
+    BOOST_ASSERT(nSlots > 0 && (nSlots & (nSlots - 1)) == 0);
+  }
+
+  /**
+   * \brief Returns the maximum size of a packet in a slot.
+   */
+  static constexpr size_t
+  getSlotCapacity() noexcept
+  {
+    return SLOT_SIZE - SLOT_HEADER_SIZE;
+  }
+
+public: // producer
+  /**
+   * \brief Appends \p packet to the ring.
+   * \retval false the ring is full
+   * \pre packet.size() <= getSlotCapacity()
+   */
+  bool
+  push(span<const uint8_t> packet) noexcept
+  {
+    BOOST_ASSERT(packet.size() <= getSlotCapacity());
+    uint32_t head = m_header.head.load(std::memory_order_relaxed);
+    if (head - m_header.tail.load(std::memory_order_acquire) > m_mask) {
+      return false;
+    }
+
+    uint8_t* slot = getSlot(head);
+    uint32_t length = static_cast<uint32_t>(packet.size());
+    std::memcpy(slot, &length, sizeof(length));
+    std::memcpy(slot + SLOT_HEADER_SIZE, packet.data(), packet.size());
+    m_header.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Returns whether the consumer must be notified after push().
+   */
+  bool
+  needsNotify() const noexcept
+  {
+    // pairs with the fence in prepareWait()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return m_header.wantNotify.load(std::memory_order_relaxed) != 0;
+  }
+
+  /**
+   * \brief Returns the number of packets read by the consumer.
+   */
+  uint32_t
+  getTail() const noexcept
+  {
+    return m_header.tail.load(std::memory_order_acquire);
+  }
+
+public: // consumer
+  /**
+   * \brief Returns the oldest packet in the ring, or an empty span if the ring is empty.
+   *
+   * The returned span points into shared memory and must be copied before use.
+   * \throw Error the producer has corrupted the ring
+   */
+  span<const uint8_t>
+  front() const
+  {
+    uint32_t tail = m_header.tail.load(std::memory_order_relaxed);
+    uint32_t nAvailable = m_header.head.load(std::memory_order_acquire) - tail;
+    if (nAvailable == 0) {
+      return {};
+    }
+    if (nAvailable > m_mask + 1) {
+      NDN_THROW(Error("Invalid ring head"));
+    }
+
+    const uint8_t* slot = getSlot(tail);
+    uint32_t length = 0;
+    std::memcpy(&length, slot, sizeof(length));
+    if (length == 0 || length > getSlotCapacity()) {
+      NDN_THROW(Error("Invalid packet length " + std::to_string(length)));
+    }
+    return {slot + SLOT_HEADER_SIZE, length};
+  }
+
+  /**
+   * \brief Releases the slot returned by front().
+   */
+  void
+  pop() noexcept
+  {
+    m_header.tail.store(m_header.tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * \brief Asks the producer for a notification of the next packet.
+   * \retval true the ring is still empty, the consumer can wait on the eventfd
+   * \retval false a packet arrived meanwhile and the request was withdrawn
+   */
+  bool
+  prepareWait() noexcept
+  {
+    m_header.wantNotify.store(1, std::memory_order_relaxed);
+    // pairs with the fence in needsNotify()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_header.head.load(std::memory_order_relaxed) != m_header.tail.load(std::memory_order_relaxed)) {
+      cancelWait();
+      return false;
+    }
+    return true;
+  }
+
+  void
+  cancelWait() noexcept
+  {
+    m_header.wantNotify.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  uint8_t*
+  getSlot(uint32_t index) const noexcept
+  {
+    return m_slots + (index & m_mask) * SLOT_SIZE;
+  }
+
+private:
+  RingHeader& m_header;
+  uint8_t* m_slots;
+  uint32_t m_mask;
+};
+
+/**
+ * \brief Owns a shared-memory segment and its eventfds.
+ */
+class Segment : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * \brief Creates and initializes a segment with \p nSlots slots in each ring.
+   * \pre \p nSlots is a power of two
+   * \throw Error a memfd or an eventfd cannot be created or mapped
+   */
+  explicit
+  Segment(uint32_t nSlots);
+
+  ~Segment();
+
+  int
+  getMemfd() const noexcept
+  {
+    return m_memfd;
+  }
+
+  int
+  getEventFd(Ring::Direction direction) const noexcept
+  {
+    return m_eventFds[direction];
+  }
+
+  size_t
+  size() const noexcept
+  {
+    return m_size;
+  }
+
+  /**
+   * \brief Returns the number of slots in each ring.
+   *
+   * This is a private copy, SegmentHeader::nSlots is only informational for the application.
+   */
+  uint32_t
+  getNSlots() const noexcept
+  {
+    return m_nSlots;
+  }
+
+  Ring
+  getRing(Ring::Direction direction) const noexcept
+  {
+    return Ring(*m_header, direction, m_nSlots);
+  }
+
+  /**
+   * \brief Hands the segment to the application connected to \p socketFd.
+   *
+   * A message whose payload is the segment size as a uint64_t is sent on the Unix stream
+   * socket, with the memfd and the eventfds of Ring::TO_FORWARDER and Ring::FROM_FORWARDER,
+   * in this order, attached as SCM_RIGHTS ancillary data.
+   * \throw Error the message cannot be sent
+   */
+  void
+  sendTo(int socketFd) const;
+
+private:
+  void
+  close() noexcept;
+
+private:
+  int m_memfd = -1;
+  int m_eventFds[2] = {-1, -1};
+  SegmentHeader* m_header = nullptr;
+  uint32_t m_nSlots = 0;
+  size_t m_size = 0;
+};
+
+} // namespace nfd::face::shm
+
+#endif // NFD_DAEMON_FACE_SHM_SEGMENT_HPP
@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "shm-transport.hpp"
+#include "common/global.hpp"
+
+#include <boost/asio/defer.hpp>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(ShmTransport);
+
+namespace local = boost::asio::local;
+using boost::asio::posix::stream_descriptor;
+
+ShmTransport::ShmTransport(local::stream_protocol::socket&& socket,
+                           unique_ptr<shm::Segment> segment)
+  : m_socket(std::move(socket))
+  , m_segment(std::move(segment))
+  , m_rxRing(m_segment->getRing(shm::Ring::TO_FORWARDER))
+  , m_txRing(m_segment->getRing(shm::Ring::FROM_FORWARDER))
+  , m_rxNotifier(getGlobalIoService())
+  , m_txNotifyFd(m_segment->getEventFd(shm::Ring::FROM_FORWARDER))
+  , m_txLengths(m_segment->getNSlots())
+{
+  // the segment keeps ownership of its eventfd, the descriptor closes its own copy
+  int rxNotifyFd = ::dup(m_segment->getEventFd(shm::Ring::TO_FORWARDER));
+  if (rxNotifyFd < 0) {
+    NDN_THROW_ERRNO(shm::Segment::Error("Cannot duplicate eventfd"));
+  }
+  m_rxNotifier.assign(rxNotifyFd);
+
+  this->setLocalUri(FaceUri("shm://" + m_socket.local_endpoint().path()));
+  this->setRemoteUri(FaceUri::fromFd(m_socket.native_handle()));
+  this->setScope(ndn::nfd::FACE_SCOPE_LOCAL);
+  this->setPersistency(ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+  this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  this->setMtu(static_cast<ssize_t>(shm::Ring::getSlotCapacity()));
+  this->setSendQueueCapacity(static_cast<ssize_t>(m_txLengths.size() * shm::Ring::getSlotCapacity()));
+
+  NFD_LOG_FACE_DEBUG("Creating transport with " << m_txLengths.size() << " slots per ring");
+
+  // Receive from the event loop, once the face that owns this transport is complete.
+  // A self-notification makes the first wait complete immediately.
+  ::eventfd_write(m_rxNotifier.native_handle(), 1);
+  waitForPackets();
+  waitForDisconnect();
+}
+
+ssize_t
+ShmTransport::getSendQueueLength()
+{
+  reclaimSendSlots();
+  return static_cast<ssize_t>(m_txQueueBytes);
+}
+
+void
+ShmTransport::doClose()
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  // Cancel all outstanding operations and close the descriptors.
+  // Closing the socket tells the application that the face is gone.
+  // Use the non-throwing variants and ignore errors, if any.
+  boost::system::error_code error;
+  m_rxNotifier.cancel(error);
+  m_rxNotifier.close(error);
+  m_socket.cancel(error);
+  m_socket.close(error);
+
+  // Ensure that the Transport stays alive at least
+  // until all pending handlers are dispatched
+  boost::asio::defer(getGlobalIoService(), [this] {
+    this->setState(TransportState::CLOSED);
+  });
+}
+
+void
+ShmTransport::doSend(const Block& packet)
+{
+  if (getState() != TransportState::UP) {
+    return;
+  }
+
+  if (!reclaimSendSlots()) {
+    handleError("Invalid tail of the send ring");
+    return;
+  }
+
+  if (!m_txRing.push(packet)) {
+    NFD_LOG_FACE_DEBUG("Send ring full, dropping packet");
+    return;
+  }
+  m_txLengths[m_txHead & (m_txLengths.size() - 1)] = static_cast<uint32_t>(packet.size());
+  ++m_txHead;
+  m_txQueueBytes += packet.size();
+
+  if (m_txRing.needsNotify()) {
+    ::eventfd_write(m_txNotifyFd, 1);
+  }
+}
+
+bool
+ShmTransport::reclaimSendSlots()
+{
+  uint32_t tail = m_txRing.getTail();
+  if (tail - m_txReclaimed > m_txHead - m_txReclaimed) {
+    return false;
+  }
+
+  for (; m_txReclaimed != tail; ++m_txReclaimed) {
+    m_txQueueBytes -= m_txLengths[m_txReclaimed & (m_txLengths.size() - 1)];
+  }
+  return true;
+}
+
+void
+ShmTransport::waitForPackets()
+{
+  m_rxNotifier.async_wait(stream_descriptor::wait_read,
+                          [this] (const auto& error) { this->handleNotification(error); });
+}
+
+void
+ShmTransport::handleNotification(const boost::system::error_code& error)
+{
+  if (error) {
+    // boost::asio::error::operation_aborted must be checked first: in that case, the Transport
+    // may already have been destructed, therefore it's unsafe to call getState() or do logging.
+    if (error != boost::asio::error::operation_aborted &&
+        getState() != TransportState::CLOSING &&
+        getState() != TransportState::FAILED &&
+        getState() != TransportState::CLOSED) {
+      handleError("Wait on eventfd failed: " + error.message());
+    }
+    return;
+  }
+
+  // reset the counter; a spurious wakeup leaves it at zero, which is harmless
+  eventfd_t count = 0;
+  ::eventfd_read(m_rxNotifier.native_handle(), &count);
+  m_rxRing.cancelWait();
+  receivePackets();
+}
+
+void
+ShmTransport::receivePackets()
+{
+  // process at most one ring's worth of packets per event loop iteration,
+  // so that a busy application cannot starve the other faces
+  for (size_t i = 0; i < m_txLengths.size(); ++i) {
+    span<const uint8_t> packet;
+    try {
+      packet = m_rxRing.front();
+    }
+    catch (const shm::Ring::Error& e) {
+      handleError(e.what());
+      return;
+    }
+
+    if (packet.empty()) {
+      if (m_rxRing.prepareWait()) {
+        waitForPackets();
+        return;
+      }
+      continue;
+    }
+
+    // copy out of shared memory before parsing, as the application can modify the slot at any time
+    auto buffer = std::make_shared<ndn::Buffer>(packet.begin(), packet.end());
+    m_rxRing.pop();
+    NFD_LOG_FACE_TRACE("Received: " << buffer->size() << " bytes");
+
+    Block element;
+    try {
+      element = Block(std::move(buffer));
+    }
+    catch (const tlv::Error& e) {
+      NFD_LOG_FACE_WARN("Failed to parse incoming packet: " << e.what());
+      continue;
+    }
+    this->receive(element);
+  }
+
+  // more packets may be pending, resume after the handlers that are already queued
+  ::eventfd_write(m_rxNotifier.native_handle(), 1);
+  waitForPackets();
+}
+
+void
+ShmTransport::waitForDisconnect()
+{
+  m_socket.async_read_some(boost::asio::buffer(m_controlBuffer),
+                           [this] (const auto& error, size_t) { this->handleControlRead(error); });
+}
+
+void
+ShmTransport::handleControlRead(const boost::system::error_code& error)
+{
+  if (error) {
+    if (error != boost::asio::error::operation_aborted &&
+        getState() != TransportState::CLOSING &&
+        getState() != TransportState::FAILED &&
+        getState() != TransportState::CLOSED) {
+      if (error == boost::asio::error::eof) {
+        this->setState(TransportState::CLOSING);
+        doClose();
+      }
+      else {
+        handleError("Receive operation on control socket failed: " + error.message());
+      }
+    }
+    return;
+  }
+
+  // no control messages are defined after the handshake, ignore anything the application sends
+  waitForDisconnect();
+}
+
+void
+ShmTransport::handleError(const std::string& errorMessage)
+{
+  NFD_LOG_FACE_ERROR(errorMessage);
+  this->setState(TransportState::FAILED);
+  doClose();
+}
+
+} // namespace nfd::face
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_SHM_TRANSPORT_HPP
+#define NFD_DAEMON_FACE_SHM_TRANSPORT_HPP
+
+#include "shm-segment.hpp"
+#include "transport.hpp"
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+#include <array>
+
+namespace nfd::face {
+
+/**
+ * \brief A Transport that communicates with a local application through shared memory.
+ *
+ * Packets are exchanged through the rings of a shm::Segment. The Unix stream socket over
+ * which the segment was handed to the application is kept open; the face is closed when
+ * the application closes its end.
+ *
+ * Packets sent while the application's ring is full are dropped.
+ */
+class ShmTransport final : public Transport
+{
+public:
+  ShmTransport(boost::asio::local::stream_protocol::socket&& socket,
+               unique_ptr<shm::Segment> segment);
+
+  ssize_t
+  getSendQueueLength() final;
+
+private:
+  void
+  doClose() final;
+
+  void
+  doSend(const Block& packet) final;
+
+  void
+  waitForPackets();
+
+  void
+  handleNotification(const boost::system::error_code& error);
+
+  void
+  receivePackets();
+
+  void
+  waitForDisconnect();
+
+  void
+  handleControlRead(const boost::system::error_code& error);
+
+  void
+  handleError(const std::string& errorMessage);
+
+  /**
+   * \brief Accounts for the packets consumed by the application since the last call.
+   * \retval false the application has corrupted the ring
+   */
+  bool
+  reclaimSendSlots();
+
+private:
+  boost::asio::local::stream_protocol::socket m_socket;
+  unique_ptr<shm::Segment> m_segment;
+  shm::Ring m_rxRing;
+  shm::Ring m_txRing;
+  boost::asio::posix::stream_descriptor m_rxNotifier;
+  int m_txNotifyFd;
+
+  std::array<uint8_t, 64> m_controlBuffer;
+  /// Lengths of the packets in the send ring, kept locally because the peer could alter them.
+  std::vector<uint32_t> m_txLengths;
+  uint32_t m_txHead = 0;
+  uint32_t m_txReclaimed = 0;
+  size_t m_txQueueBytes = 0;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_SHM_TRANSPORT_HPP
@@ -30,7 +30,9 @@
 #include "socket-utils.hpp"
 #include "common/global.hpp"
 
-#include <queue>
+#include <algorithm>
+#include <cstring>
+#include <deque>
 
 #include <boost/asio/defer.hpp>
 #include <boost/asio/write.hpp>
@@ -59,6 +61,9 @@ public:
   ssize_t
   getSendQueueLength() override;
 
+  std::optional<time::nanoseconds>
+  getSendQueueSojournTime() override;
+
 protected:
   void
   doClose() override;
@@ -92,6 +97,12 @@ protected:
   void
   resetReceiveBuffer();
 
+  /**
+   * \brief Moves the bytes not yet parsed to a slab that can receive a packet of maximum size.
+   */
+  void
+  switchReceiveSlab();
+
   void
   resetSendQueue();
 
@@ -99,15 +110,48 @@ protected:
   getSendQueueBytes() const;
 
 protected:
+  /**
+   * \brief Maximum number of queued packets written to the socket in one operation.
+   */
+  static constexpr size_t SEND_BATCH_SIZE = 64;
+
+  /**
+   * \brief Size of each receive slab.
+   */
+  static constexpr size_t RECEIVE_SLAB_SIZE = 2 * ndn::MAX_NDN_PACKET_SIZE;
+
+  /**
+   * \brief Received packets of at least this size share the receive slab instead of being copied.
+   *
+   * A packet shares the whole slab, so a small packet that is kept for a long time, e.g.,
+   * in the Content Store, would hold on to much more memory than its own size.
+   */
+  static constexpr size_t MIN_SHARED_PACKET_SIZE = 4096;
+
+  /**
+   * \brief Maximum number of slabs kept for reuse after their packets are released.
+   */
+  static constexpr size_t MAX_SPARE_SLABS = 4;
+
   typename protocol::socket m_socket;
 
   NFD_LOG_MEMBER_DECL();
 
 private:
-  uint8_t m_receiveBuffer[ndn::MAX_NDN_PACKET_SIZE];
-  size_t m_receiveBufferSize = 0;
-  std::queue<Block> m_sendQueue;
+  /// Slab being received into; Blocks of large received packets point into it.
+  shared_ptr<ndn::Buffer> m_slab;
+  /// Previous slabs, reused once no Block points into them.
+  std::vector<shared_ptr<ndn::Buffer>> m_spareSlabs;
+  /// Offset of the first byte in m_slab that has not been parsed.
+  size_t m_slabBegin = 0;
+  /// Offset of the end of the received bytes in m_slab.
+  size_t m_slabEnd = 0;
+  std::deque<Block> m_sendQueue;
+  /// Enqueue time of each packet in m_sendQueue.
+  std::deque<time::steady_clock::time_point> m_sendQueueTimes;
   size_t m_sendQueueBytes = 0;
+  /// Buffers of the packets at the front of m_sendQueue that are being written.
+  std::vector<boost::asio::const_buffer> m_sendBuffers;
 };
 
 
@@ -133,6 +177,16 @@ StreamTransport<T>::getSendQueueLength()
   return getSendQueueBytes() + std::max<ssize_t>(0, queueLength);
 }
 
+template<class T>
+std::optional<time::nanoseconds>
+StreamTransport<T>::getSendQueueSojournTime()
+{
+  if (m_sendQueueTimes.empty()) {
+    return std::nullopt;
+  }
+  return time::steady_clock::now() - m_sendQueueTimes.front();
+}
+
 template<class T>
 void
 StreamTransport<T>::doClose()
@@ -189,11 +243,11 @@ StreamTransport<T>::doSend(const Block& packet)
   if (getState() != TransportState::UP)
     return;
 
-  bool wasQueueEmpty = m_sendQueue.empty();
-  m_sendQueue.push(packet);
+  m_sendQueue.push_back(packet);
+  m_sendQueueTimes.push_back(time::steady_clock::now());
   m_sendQueueBytes += packet.size();
 
-  if (wasQueueEmpty)
+  if (m_sendBuffers.empty())
     sendFromQueue();
 }
 
@@ -201,7 +255,15 @@ template<class T>
 void
 StreamTransport<T>::sendFromQueue()
 {
-  boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
+  // packets queued while the previous write was in progress are written together,
+  // with a single gather-write system call
+  BOOST_ASSERT(m_sendBuffers.empty());
+  size_t nPackets = std::min(m_sendQueue.size(), SEND_BATCH_SIZE);
+  for (size_t i = 0; i < nPackets; ++i) {
+    m_sendBuffers.push_back(boost::asio::buffer(m_sendQueue[i]));
+  }
+
+  boost::asio::async_write(m_socket, m_sendBuffers,
                            [this] (auto&&... args) { this->handleSend(std::forward<decltype(args)>(args)...); });
 }
 
@@ -215,10 +277,12 @@ StreamTransport<T>::handleSend(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
 
-  BOOST_ASSERT(!m_sendQueue.empty());
-  BOOST_ASSERT(m_sendQueue.front().size() == nBytesSent);
+  BOOST_ASSERT(m_sendQueue.size() >= m_sendBuffers.size());
+  BOOST_ASSERT(boost::asio::buffer_size(m_sendBuffers) == nBytesSent);
+  m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + m_sendBuffers.size());
+  m_sendQueueTimes.erase(m_sendQueueTimes.begin(), m_sendQueueTimes.begin() + m_sendBuffers.size());
   m_sendQueueBytes -= nBytesSent;
-  m_sendQueue.pop();
+  m_sendBuffers.clear();
 
   if (!m_sendQueue.empty())
     sendFromQueue();
@@ -230,8 +294,15 @@ StreamTransport<T>::startReceive()
 {
   BOOST_ASSERT(getState() == TransportState::UP);
 
-  m_socket.async_receive(boost::asio::buffer(m_receiveBuffer + m_receiveBufferSize,
-                                             ndn::MAX_NDN_PACKET_SIZE - m_receiveBufferSize),
+  if (m_slab == nullptr || m_slab->size() - m_slabBegin < ndn::MAX_NDN_PACKET_SIZE) {
+    switchReceiveSlab();
+  }
+  else if (m_slabBegin == m_slabEnd && m_slab.use_count() == 1) {
+    // nothing is pending and no Block points into the slab, start over from its beginning
+    m_slabBegin = m_slabEnd = 0;
+  }
+
+  m_socket.async_receive(boost::asio::buffer(m_slab->data() + m_slabEnd, m_slab->size() - m_slabEnd),
                          [this] (auto&&... args) { this->handleReceive(std::forward<decltype(args)>(args)...); });
 }
 
@@ -245,39 +316,47 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
 
-  m_receiveBufferSize += nBytesReceived;
-  auto bufferView = ndn::make_span(m_receiveBuffer, m_receiveBufferSize);
-  size_t offset = 0;
-  bool isOk = true;
-  while (offset < bufferView.size()) {
-    Block element;
-    std::tie(isOk, element) = Block::fromBuffer(bufferView.subspan(offset));
-    if (!isOk)
+  m_slabEnd += nBytesReceived;
+  BOOST_ASSERT(m_slabEnd <= m_slab->size());
+
+  while (m_slabBegin < m_slabEnd) {
+    auto begin = m_slab->cbegin() + m_slabBegin;
+    auto end = m_slab->cbegin() + m_slabEnd;
+    auto pos = begin;
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (!tlv::readType(pos, end, type) || !tlv::readVarNumber(pos, end, length)) {
+      // incomplete or malformed header
+      break;
+    }
+    if (length > ndn::MAX_NDN_PACKET_SIZE ||
+        static_cast<size_t>(pos - begin) + length > ndn::MAX_NDN_PACKET_SIZE) {
+      NFD_LOG_FACE_ERROR("Received packet too large to process");
+      this->setState(TransportState::FAILED);
+      doClose();
+      return;
+    }
+    size_t elementSize = static_cast<size_t>(pos - begin) + static_cast<size_t>(length);
+    if (elementSize > m_slabEnd - m_slabBegin) {
+      // the rest of the packet has not arrived yet
       break;
+    }
 
-    offset += element.size();
-    BOOST_ASSERT(offset <= bufferView.size());
+    Block element = elementSize >= MIN_SHARED_PACKET_SIZE ?
+                    Block(m_slab, begin, begin + elementSize) :
+                    Block(span<const uint8_t>(&*begin, elementSize));
+    m_slabBegin += elementSize;
 
     this->receive(element);
   }
 
-  if (!isOk && m_receiveBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0) {
+  if (m_slabEnd - m_slabBegin >= ndn::MAX_NDN_PACKET_SIZE) {
     NFD_LOG_FACE_ERROR("Failed to parse incoming packet or packet too large to process");
     this->setState(TransportState::FAILED);
     doClose();
     return;
   }
 
-  if (offset > 0) {
-    if (offset != m_receiveBufferSize) {
-      std::copy(m_receiveBuffer + offset, m_receiveBuffer + m_receiveBufferSize, m_receiveBuffer);
-      m_receiveBufferSize -= offset;
-    }
-    else {
-      m_receiveBufferSize = 0;
-    }
-  }
-
   startReceive();
 }
 
@@ -316,16 +395,61 @@ template<class T>
 void
 StreamTransport<T>::resetReceiveBuffer()
 {
-  m_receiveBufferSize = 0;
+  if (m_slab != nullptr && m_slab.use_count() != 1) {
+    // received Blocks still point into the slab, it must not be written over
+    if (m_spareSlabs.size() < MAX_SPARE_SLABS) {
+      m_spareSlabs.push_back(std::move(m_slab));
+    }
+    m_slab = nullptr;
+  }
+  m_slabBegin = m_slabEnd = 0;
+}
+
+template<class T>
+void
+StreamTransport<T>::switchReceiveSlab()
+{
+  size_t nPending = m_slabEnd - m_slabBegin;
+
+  if (m_slab != nullptr && m_slab.use_count() == 1) {
+    // no Block points into the current slab, keep using it
+    std::memmove(m_slab->data(), m_slab->data() + m_slabBegin, nPending);
+  }
+  else {
+    auto it = std::find_if(m_spareSlabs.begin(), m_spareSlabs.end(),
+                           [] (const auto& slab) { return slab.use_count() == 1; });
+    shared_ptr<ndn::Buffer> next;
+    if (it != m_spareSlabs.end()) {
+      next = std::move(*it);
+      m_spareSlabs.erase(it);
+    }
+    else {
+      next = std::make_shared<ndn::Buffer>(RECEIVE_SLAB_SIZE);
+    }
+
+    if (m_slab != nullptr) {
+      std::copy_n(m_slab->data() + m_slabBegin, nPending, next->data());
+      if (m_spareSlabs.size() < MAX_SPARE_SLABS) {
+        m_spareSlabs.push_back(std::move(m_slab));
+      }
+    }
+    m_slab = std::move(next);
+  }
+
+  m_slabBegin = 0;
+  m_slabEnd = nPending;
 }
 
 template<class T>
 void
 StreamTransport<T>::resetSendQueue()
 {
-  std::queue<Block> emptyQueue;
-  std::swap(emptyQueue, m_sendQueue);
+  m_sendQueue.clear();
+  m_sendQueue.shrink_to_fit();
+  m_sendQueueTimes.clear();
+  m_sendQueueTimes.shrink_to_fit();
   m_sendQueueBytes = 0;
+  m_sendBuffers.clear();
 }
 
 template<class T>
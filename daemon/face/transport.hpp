@@ -328,6 +328,19 @@ public: // dynamic properties
     return QUEUE_UNSUPPORTED;
   }
 
+  /**
+   * \brief Returns how long the packet at the head of the send queue has been waiting.
+   *
+   * Transports that timestamp the packets in their own send queue can override this function.
+   * \return the waiting time, or std::nullopt if it is not measured, e.g., because the
+   *         transport's own queue is empty and any backlog is held by the kernel
+   */
+  virtual std::optional<time::nanoseconds>
+  getSendQueueSojournTime()
+  {
+    return std::nullopt;
+  }
+
 protected: // upper interface to be invoked by subclass
   /**
    * \brief Pass a received link-layer packet to the upper layer for further processing.
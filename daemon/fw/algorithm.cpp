@@ -56,26 +56,20 @@ findDuplicateNonce(const pit::Entry& pitEntry, Interest::Nonce nonce, const Face
 {
   int dnw = DUPLICATE_NONCE_NONE;
 
-  for (const pit::InRecord& inRecord : pitEntry.getInRecords()) {
-    if (inRecord.getLastNonce() == nonce) {
-      if (&inRecord.getFace() == &face) {
-        dnw |= DUPLICATE_NONCE_IN_SAME;
-      }
-      else {
-        dnw |= DUPLICATE_NONCE_IN_OTHER;
-      }
-    }
+  auto [isInSame, isInOther] = pitEntry.matchInRecordNonce(nonce, face);
+  if (isInSame) {
+    dnw |= DUPLICATE_NONCE_IN_SAME;
+  }
+  if (isInOther) {
+    dnw |= DUPLICATE_NONCE_IN_OTHER;
   }
 
-  for (const pit::OutRecord& outRecord : pitEntry.getOutRecords()) {
-    if (outRecord.getLastNonce() == nonce) {
-      if (&outRecord.getFace() == &face) {
-        dnw |= DUPLICATE_NONCE_OUT_SAME;
-      }
-      else {
-        dnw |= DUPLICATE_NONCE_OUT_OTHER;
-      }
-    }
+  auto [isOutSame, isOutOther] = pitEntry.matchOutRecordNonce(nonce, face);
+  if (isOutSame) {
+    dnw |= DUPLICATE_NONCE_OUT_SAME;
+  }
+  if (isOutOther) {
+    dnw |= DUPLICATE_NONCE_OUT_OTHER;
   }
 
   return dnw;
@@ -25,16 +25,56 @@
 
 #include "asf-measurements.hpp"
 #include "common/global.hpp"
+#include "common/logger.hpp"
 
 namespace nfd::fw::asf {
 
+NFD_LOG_INIT(AsfMeasurements);
+
+shared_ptr<ndn::util::RttEstimator>
+RttEstimatorPool::getSharedEstimator(FaceId faceId)
+{
+  auto& weak = m_shared[faceId];
+  if (auto estimator = weak.lock(); estimator != nullptr) {
+    return estimator;
+  }
+
+  auto estimator = make_shared<ndn::util::RttEstimator>(m_opts);
+  weak = estimator;
+
+  // An estimator is destroyed together with the last FaceInfo that uses it; drop the stale
+  // map entries occasionally so that face churn does not make the map grow without bound
+  if (m_shared.size() >= m_purgeThreshold) {
+    for (auto it = m_shared.begin(); it != m_shared.end();) {
+      if (it->second.expired()) {
+        it = m_shared.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+    m_purgeThreshold = std::max<size_t>(64, 2 * m_shared.size());
+  }
+  return estimator;
+}
+
+size_t
+RttEstimatorPool::getNSharedEstimators() const
+{
+  return std::count_if(m_shared.begin(), m_shared.end(),
+                       [] (const auto& p) { return !p.second.expired(); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 time::nanoseconds
 FaceInfo::scheduleTimeout(const Name& interestName, ndn::scheduler::EventCallback cb)
 {
   BOOST_ASSERT(!m_timeoutEvent);
   m_lastInterestName = interestName;
-  m_timeoutEvent = getScheduler().schedule(m_rttEstimator.getEstimatedRto(), std::move(cb));
-  return m_rttEstimator.getEstimatedRto();
+  m_timeoutEvent = getScheduler().schedule(m_rttEstimator->getEstimatedRto(), std::move(cb));
+  return m_rttEstimator->getEstimatedRto();
 }
 
 void
@@ -48,29 +88,101 @@ FaceInfo::cancelTimeout(const Name& prefix)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+NamespaceInfo::NamespaceInfo(shared_ptr<RttEstimatorPool> pool)
+  : m_pool(std::move(pool))
+{
+  if (m_pool) {
+    ++m_pool->nNamespaceInfos;
+    if (m_pool->isShared()) {
+      m_fiMap.emplace<std::unordered_map<FaceId, SharedFaceInfo>>();
+    }
+  }
+}
+
+NamespaceInfo::~NamespaceInfo()
+{
+  if (m_pool) {
+    --m_pool->nNamespaceInfos;
+    m_pool->nFaceInfos -= std::visit([] (const auto& fiMap) { return fiMap.size(); }, m_fiMap);
+  }
+}
+
 FaceInfo*
 NamespaceInfo::getFaceInfo(FaceId faceId)
 {
-  auto it = m_fiMap.find(faceId);
-  return it != m_fiMap.end() ? &it->second : nullptr;
+  auto now = time::steady_clock::now();
+  eraseExpiredFaceInfos(now);
+
+  return std::visit([&] (auto& fiMap) -> FaceInfo* {
+    auto it = fiMap.find(faceId);
+    if (it == fiMap.end()) {
+      return nullptr;
+    }
+    if (it->second.m_expiry <= now) {
+      eraseFaceInfo(fiMap, it);
+      return nullptr;
+    }
+    return &it->second;
+  }, m_fiMap);
 }
 
 FaceInfo&
 NamespaceInfo::getOrCreateFaceInfo(FaceId faceId)
 {
-  auto [it, isNew] = m_fiMap.try_emplace(faceId, m_rttEstimatorOpts);
-  auto& faceInfo = it->second;
-  if (isNew) {
-    extendFaceInfoLifetime(faceInfo, faceId);
+  auto* info = getFaceInfo(faceId);
+  if (info != nullptr) {
+    return *info;
+  }
+
+  FaceInfo* faceInfo = nullptr;
+  if (auto* sharedMap = std::get_if<std::unordered_map<FaceId, SharedFaceInfo>>(&m_fiMap)) {
+    faceInfo = &sharedMap->try_emplace(faceId, m_pool->getSharedEstimator(faceId)).first->second;
   }
-  return faceInfo;
+  else {
+    auto& privateMap = std::get<std::unordered_map<FaceId, PrivateFaceInfo>>(m_fiMap);
+    faceInfo = &privateMap.try_emplace(faceId, m_pool ? m_pool->getOptions() : nullptr).first->second;
+  }
+  if (m_pool) {
+    ++m_pool->nFaceInfos;
+  }
+  extendFaceInfoLifetime(*faceInfo);
+  return *faceInfo;
 }
 
 void
-NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info, FaceId faceId)
+NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info)
 {
-  info.m_measurementExpiration = getScheduler().schedule(AsfMeasurements::MEASUREMENTS_LIFETIME,
-                                                         [=] { m_fiMap.erase(faceId); });
+  info.m_expiry = time::steady_clock::now() + AsfMeasurements::MEASUREMENTS_LIFETIME;
+}
+
+void
+NamespaceInfo::eraseExpiredFaceInfos(time::steady_clock::time_point now)
+{
+  if (now < m_nextSweep) {
+    return;
+  }
+  m_nextSweep = now + AsfMeasurements::MEASUREMENTS_LIFETIME;
+
+  std::visit([&] (auto& fiMap) {
+    for (auto it = fiMap.begin(); it != fiMap.end();) {
+      if (it->second.m_expiry <= now) {
+        eraseFaceInfo(fiMap, it++);
+      }
+      else {
+        ++it;
+      }
+    }
+  }, m_fiMap);
+}
+
+template<typename FaceInfoMap>
+void
+NamespaceInfo::eraseFaceInfo(FaceInfoMap& fiMap, typename FaceInfoMap::iterator it)
+{
+  fiMap.erase(it);
+  if (m_pool) {
+    --m_pool->nFaceInfos;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -78,7 +190,7 @@ NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info, FaceId faceId)
 
 AsfMeasurements::AsfMeasurements(MeasurementsAccessor& measurements)
   : m_measurements(measurements)
-  , m_rttEstimatorOpts(make_shared<ndn::util::RttEstimator::Options>())
+  , m_pool(make_shared<RttEstimatorPool>(make_shared<ndn::util::RttEstimator::Options>()))
 {
 }
 
@@ -105,8 +217,11 @@ AsfMeasurements::getNamespaceInfo(const Name& prefix)
   // Set or update entry lifetime
   extendLifetime(*me);
 
-  NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>(m_rttEstimatorOpts).first;
+  auto [info, isNew] = me->insertStrategyInfo<NamespaceInfo>(m_pool);
   BOOST_ASSERT(info != nullptr);
+  if (isNew) {
+    afterNewNamespaceInfo();
+  }
   return info;
 }
 
@@ -129,8 +244,11 @@ AsfMeasurements::getOrCreateNamespaceInfo(const fib::Entry& fibEntry, const Name
   // Set or update entry lifetime
   extendLifetime(*me);
 
-  NamespaceInfo* info = me->insertStrategyInfo<NamespaceInfo>(m_rttEstimatorOpts).first;
+  auto [info, isNew] = me->insertStrategyInfo<NamespaceInfo>(m_pool);
   BOOST_ASSERT(info != nullptr);
+  if (isNew) {
+    afterNewNamespaceInfo();
+  }
   return *info;
 }
 
@@ -140,4 +258,48 @@ AsfMeasurements::extendLifetime(measurements::Entry& me)
   m_measurements.extendLifetime(me, MEASUREMENTS_LIFETIME);
 }
 
+void
+AsfMeasurements::afterNewNamespaceInfo()
+{
+  if (m_pool->nNamespaceInfos < m_nextMemoryReport) {
+    return;
+  }
+  m_nextMemoryReport = 2 * m_pool->nNamespaceInfos;
+  NFD_LOG_INFO("memory " << getMemoryReport());
+}
+
+AsfMeasurements::MemoryReport
+AsfMeasurements::getMemoryReport() const
+{
+  MemoryReport report;
+  report.nNamespaceInfos = m_pool->nNamespaceInfos;
+  report.nFaceInfos = m_pool->nFaceInfos;
+
+  // each FaceInfo is a node in an unordered_map
+  constexpr size_t nodeOverhead = 2 * sizeof(void*);
+  report.nBytes = report.nNamespaceInfos * sizeof(NamespaceInfo);
+  if (m_pool->isShared()) {
+    // each shared estimator is allocated together with its control block
+    constexpr size_t estimatorSize = sizeof(ndn::util::RttEstimator) + 2 * sizeof(long);
+    report.nRttEstimators = m_pool->getNSharedEstimators();
+    report.nBytes += report.nFaceInfos * (sizeof(std::pair<const FaceId, SharedFaceInfo>) + nodeOverhead) +
+                     report.nRttEstimators * estimatorSize;
+  }
+  else {
+    // each FaceInfo holds its own estimator
+    report.nRttEstimators = report.nFaceInfos;
+    report.nBytes += report.nFaceInfos * (sizeof(std::pair<const FaceId, PrivateFaceInfo>) + nodeOverhead);
+  }
+  return report;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const AsfMeasurements::MemoryReport& report)
+{
+  return os << "namespaces=" << report.nNamespaceInfos
+            << " face-infos=" << report.nFaceInfos
+            << " rtt-estimators=" << report.nRttEstimators
+            << " bytes=" << report.nBytes;
+}
+
 } // namespace nfd::fw::asf
@@ -33,21 +33,82 @@
 #include <ndn-cxx/util/rtt-estimator.hpp>
 
 #include <unordered_map>
+#include <variant>
 
 namespace nfd::fw::asf {
 
 /**
- * \brief Strategy information for each face in a namespace.
+ * \brief Provides the RTT estimators shared among namespaces and keeps track of memory usage.
+ *
+ * In the default mode, every FaceInfo owns a private estimator, i.e., RTT state is kept
+ * per (namespace, face) pair. In shared mode, all FaceInfo objects of the same face use a
+ * single estimator, so that only the last RTT sample, the timeout count, and the
+ * retransmission timer are stored per namespace. This reduces the memory footprint
+ * from O(namespaces * faces) estimators to O(faces) when many prefixes use ASF.
  */
-class FaceInfo
+class RttEstimatorPool : noncopyable
 {
 public:
   explicit
-  FaceInfo(shared_ptr<const ndn::util::RttEstimator::Options> opts)
-    : m_rttEstimator(std::move(opts))
+  RttEstimatorPool(shared_ptr<const ndn::util::RttEstimator::Options> opts = nullptr)
+    : m_opts(std::move(opts))
+  {
+  }
+
+  bool
+  isShared() const
+  {
+    return m_isShared;
+  }
+
+  /** \brief Enable or disable sharing of estimators among namespaces.
+   *
+   *  Only affects NamespaceInfo objects created afterwards.
+   */
+  void
+  setShared(bool isShared)
   {
+    m_isShared = isShared;
   }
 
+  /** \brief Return the options of all estimators.
+   */
+  const shared_ptr<const ndn::util::RttEstimator::Options>&
+  getOptions() const
+  {
+    return m_opts;
+  }
+
+  /** \brief Return the estimator shared by all namespaces for \p faceId.
+   */
+  shared_ptr<ndn::util::RttEstimator>
+  getSharedEstimator(FaceId faceId);
+
+  /** \brief Return the number of live estimators that are shared among namespaces.
+   */
+  size_t
+  getNSharedEstimators() const;
+
+private:
+  shared_ptr<const ndn::util::RttEstimator::Options> m_opts;
+  bool m_isShared = false;
+  std::unordered_map<FaceId, weak_ptr<ndn::util::RttEstimator>> m_shared;
+  size_t m_purgeThreshold = 64;
+
+public:
+  size_t nNamespaceInfos = 0;
+  size_t nFaceInfos = 0;
+};
+
+/**
+ * \brief Strategy information for each face in a namespace.
+ *
+ * The RTT estimator is stored by a derived class: PrivateFaceInfo keeps it inline,
+ * SharedFaceInfo refers to an estimator shared among namespaces.
+ */
+class FaceInfo : noncopyable
+{
+public:
   bool
   isTimeoutScheduled() const
   {
@@ -64,7 +125,7 @@ public:
   recordRtt(time::nanoseconds rtt)
   {
     m_lastRtt = rtt;
-    m_rttEstimator.addMeasurement(rtt);
+    m_rttEstimator->addMeasurement(rtt);
   }
 
   void
@@ -83,7 +144,7 @@ public:
   time::nanoseconds
   getSrtt() const
   {
-    return m_rttEstimator.getSmoothedRtt();
+    return m_rttEstimator->getSmoothedRtt();
   }
 
   size_t
@@ -98,24 +159,73 @@ public:
     m_nTimeouts = nTimeouts;
   }
 
+  const ndn::util::RttEstimator&
+  getRttEstimator() const
+  {
+    return *m_rttEstimator;
+  }
+
 public:
   static constexpr time::nanoseconds RTT_NO_MEASUREMENT = -1_ns;
   static constexpr time::nanoseconds RTT_TIMEOUT = -2_ns;
 
+protected:
+  explicit
+  FaceInfo(ndn::util::RttEstimator* estimator) noexcept
+    : m_rttEstimator(estimator)
+  {
+  }
+
+  ~FaceInfo() = default;
+
 private:
-  ndn::util::RttEstimator m_rttEstimator;
+  ndn::util::RttEstimator* m_rttEstimator;
   time::nanoseconds m_lastRtt = RTT_NO_MEASUREMENT;
   Name m_lastInterestName;
   size_t m_nTimeouts = 0;
 
-  // Timeout associated with measurement
-  ndn::scheduler::ScopedEventId m_measurementExpiration;
+  // Expiration of this measurement, checked lazily by NamespaceInfo
+  time::steady_clock::time_point m_expiry;
   friend class NamespaceInfo;
 
   // RTO associated with Interest
   ndn::scheduler::ScopedEventId m_timeoutEvent;
 };
 
+/**
+ * \brief FaceInfo that owns its RTT estimator.
+ */
+class PrivateFaceInfo final : public FaceInfo
+{
+public:
+  explicit
+  PrivateFaceInfo(shared_ptr<const ndn::util::RttEstimator::Options> opts)
+    : FaceInfo(&m_ownRttEstimator)
+    , m_ownRttEstimator(std::move(opts))
+  {
+  }
+
+private:
+  ndn::util::RttEstimator m_ownRttEstimator;
+};
+
+/**
+ * \brief FaceInfo that uses an RTT estimator shared among namespaces.
+ */
+class SharedFaceInfo final : public FaceInfo
+{
+public:
+  explicit
+  SharedFaceInfo(shared_ptr<ndn::util::RttEstimator> estimator)
+    : FaceInfo(estimator.get())
+    , m_sharedRttEstimator(std::move(estimator))
+  {
+  }
+
+private:
+  shared_ptr<ndn::util::RttEstimator> m_sharedRttEstimator;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -131,12 +241,20 @@ public:
     return 1030;
   }
 
+  /** \param pool where to obtain RTT estimators; if nullptr, each FaceInfo creates
+   *              a private estimator with default options
+   *
+   *  The FaceInfo objects of this namespace share estimators with other namespaces
+   *  if \p pool is in shared mode when this NamespaceInfo is created.
+   */
   explicit
-  NamespaceInfo(shared_ptr<const ndn::util::RttEstimator::Options> opts)
-    : m_rttEstimatorOpts(std::move(opts))
-  {
-  }
+  NamespaceInfo(shared_ptr<RttEstimatorPool> pool);
+
+  ~NamespaceInfo() override;
 
+  /** \brief Find the FaceInfo of \p faceId.
+   *  \retval nullptr no FaceInfo exists, or it has expired (in which case it is erased)
+   */
   FaceInfo*
   getFaceInfo(FaceId faceId);
 
@@ -144,7 +262,7 @@ public:
   getOrCreateFaceInfo(FaceId faceId);
 
   void
-  extendFaceInfoLifetime(FaceInfo& info, FaceId faceId);
+  extendFaceInfoLifetime(FaceInfo& info);
 
   bool
   isProbingDue() const
@@ -171,8 +289,21 @@ public:
   }
 
 private:
-  std::unordered_map<FaceId, FaceInfo> m_fiMap;
-  shared_ptr<const ndn::util::RttEstimator::Options> m_rttEstimatorOpts;
+  /** \brief Erase expired FaceInfo objects, at most once per measurements lifetime.
+   */
+  void
+  eraseExpiredFaceInfos(time::steady_clock::time_point now);
+
+  template<typename FaceInfoMap>
+  void
+  eraseFaceInfo(FaceInfoMap& fiMap, typename FaceInfoMap::iterator it);
+
+private:
+  // a namespace stores either PrivateFaceInfo or SharedFaceInfo objects, never both
+  std::variant<std::unordered_map<FaceId, PrivateFaceInfo>,
+               std::unordered_map<FaceId, SharedFaceInfo>> m_fiMap;
+  time::steady_clock::time_point m_nextSweep;
+  shared_ptr<RttEstimatorPool> m_pool;
   bool m_isProbingDue = false;
   bool m_isFirstProbeScheduled = false;
 };
@@ -201,18 +332,58 @@ public:
   NamespaceInfo&
   getOrCreateNamespaceInfo(const fib::Entry& fibEntry, const Name& prefix);
 
+  /** \brief Enable or disable sharing RTT estimators among namespaces.
+   *  \sa RttEstimatorPool
+   */
+  void
+  setSharedRttEstimation(bool isShared)
+  {
+    m_pool->setShared(isShared);
+  }
+
+  bool
+  isSharedRttEstimation() const
+  {
+    return m_pool->isShared();
+  }
+
+  /**
+   * \brief Approximate memory used by the measurements of this strategy instance.
+   *
+   * Byte counts are estimated from object sizes and do not include allocator overhead.
+   */
+  struct MemoryReport
+  {
+    size_t nNamespaceInfos = 0;
+    size_t nFaceInfos = 0;
+    size_t nRttEstimators = 0;
+    size_t nBytes = 0;
+  };
+
+  MemoryReport
+  getMemoryReport() const;
+
 private:
   void
   extendLifetime(measurements::Entry& me);
 
+  /** \brief Log the memory report each time the number of namespaces doubles.
+   */
+  void
+  afterNewNamespaceInfo();
+
 public:
   static constexpr time::microseconds MEASUREMENTS_LIFETIME = 5_min;
 
 private:
   MeasurementsAccessor& m_measurements;
-  shared_ptr<const ndn::util::RttEstimator::Options> m_rttEstimatorOpts;
+  shared_ptr<RttEstimatorPool> m_pool;
+  size_t m_nextMemoryReport = 1024;
 };
 
+std::ostream&
+operator<<(std::ostream& os, const AsfMeasurements::MemoryReport& report);
+
 } // namespace nfd::fw::asf
 
 #endif // NFD_DAEMON_FW_ASF_MEASUREMENTS_HPP
@@ -30,6 +30,8 @@
 
 #include <ndn-cxx/util/random.hpp>
 
+#include <boost/container/small_vector.hpp>
+
 namespace nfd::fw::asf {
 
 static_assert(ProbingModule::DEFAULT_PROBING_INTERVAL < AsfMeasurements::MEASUREMENTS_LIFETIME);
@@ -99,8 +101,11 @@ ProbingModule::FaceStatsProbingCompare::operator()(const FaceStats& lhs, const F
   return getFaceRankForProbing(lhs) < getFaceRankForProbing(rhs);
 }
 
+// Faces are ranked in a stack-allocated buffer; FIB entries rarely have more next hops than this
+using RankedFaces = boost::container::small_vector<FaceStats, 16>;
+
 static Face*
-chooseFace(const ProbingModule::FaceStatsProbingSet& rankedFaces)
+chooseFace(const RankedFaces& rankedFaces)
 {
   static std::uniform_real_distribution<> randDist;
   static auto& rng = ndn::random::getRandomNumberEngine();
@@ -142,7 +147,8 @@ Face*
 ProbingModule::getFaceToProbe(const Face& inFace, const Interest& interest,
                               const fib::Entry& fibEntry, const Face& faceUsed)
 {
-  FaceStatsProbingSet rankedFaces;
+  RankedFaces rankedFaces;
+  NamespaceInfo* nsInfo = nullptr;
 
   // Put eligible faces into rankedFaces. If one or more faces do not have an RTT measurement,
   // the lowest ranked one will always be returned.
@@ -156,13 +162,17 @@ ProbingModule::getFaceToProbe(const Face& inFace, const Interest& interest,
       continue;
     }
 
-    FaceInfo* info = m_measurements.getFaceInfo(fibEntry, interest.getName(), hopFace.getId());
+    if (nsInfo == nullptr) {
+      nsInfo = &m_measurements.getOrCreateNamespaceInfo(fibEntry, interest.getName());
+    }
+
+    FaceInfo* info = nsInfo->getFaceInfo(hopFace.getId());
     if (info == nullptr || info->getLastRtt() == FaceInfo::RTT_NO_MEASUREMENT) {
-      rankedFaces.insert({&hopFace, FaceInfo::RTT_NO_MEASUREMENT,
-                          FaceInfo::RTT_NO_MEASUREMENT, hop.getCost()});
+      rankedFaces.push_back({&hopFace, FaceInfo::RTT_NO_MEASUREMENT,
+                             FaceInfo::RTT_NO_MEASUREMENT, hop.getCost()});
     }
     else {
-      rankedFaces.insert({&hopFace, info->getLastRtt(), info->getSrtt(), hop.getCost()});
+      rankedFaces.push_back({&hopFace, info->getLastRtt(), info->getSrtt(), hop.getCost()});
     }
   }
 
@@ -171,11 +181,15 @@ ProbingModule::getFaceToProbe(const Face& inFace, const Interest& interest,
     return nullptr;
   }
 
-  // If the top face is unmeasured, immediately return it.
-  if (rankedFaces.begin()->rtt == FaceInfo::RTT_NO_MEASUREMENT) {
-    return rankedFaces.begin()->face;
+  // If the top face is unmeasured, immediately return it without sorting the rest.
+  FaceStatsProbingCompare compare;
+  auto top = std::min_element(rankedFaces.begin(), rankedFaces.end(), compare);
+  if (top->rtt == FaceInfo::RTT_NO_MEASUREMENT) {
+    return top->face;
   }
 
+  // Ranks are unique because FaceId is part of the ranking, so the order is the same as in a set
+  std::sort(rankedFaces.begin(), rankedFaces.end(), compare);
   return chooseFace(rankedFaces);
 }
 
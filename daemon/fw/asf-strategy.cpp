@@ -48,12 +48,14 @@ AsfStrategy::AsfStrategy(Forwarder& forwarder, const Name& name)
                                                                       m_probing.getProbingInterval().count());
   m_probing.setProbingInterval(time::milliseconds(probingInterval));
   m_nMaxTimeouts = params.getOrDefault<size_t>("max-timeouts", m_nMaxTimeouts);
+  m_measurements.setSharedRttEstimation(params.getOrDefault<bool>("shared-rtt", false));
 
   this->setInstanceName(makeInstanceName(name, getStrategyName()));
 
   NDN_LOG_DEBUG(*m_retxSuppression);
   NFD_LOG_DEBUG("probing-interval=" << m_probing.getProbingInterval()
-                << " max-timeouts=" << m_nMaxTimeouts);
+                << " max-timeouts=" << m_nMaxTimeouts
+                << " shared-rtt=" << m_measurements.isSharedRttEstimation());
 }
 
 const Name&
@@ -154,7 +156,7 @@ AsfStrategy::beforeSatisfyInterest(const Data& data, const FaceEndpoint& ingress
   }
 
   // Extend lifetime for measurements associated with Face
-  namespaceInfo->extendFaceInfoLifetime(*faceInfo, ingress.face.getId());
+  namespaceInfo->extendFaceInfoLifetime(*faceInfo);
   // Extend PIT entry timer to allow slower probes to arrive
   this->setExpiryTimer(pitEntry, 50_ms);
   faceInfo->cancelTimeout(data.getName());
@@ -183,7 +185,7 @@ AsfStrategy::forwardInterest(const Interest& interest, Face& outFace, const fib:
 
   // Refresh measurements since Face is being used for forwarding
   NamespaceInfo& namespaceInfo = m_measurements.getOrCreateNamespaceInfo(fibEntry, interestName);
-  namespaceInfo.extendFaceInfoLifetime(faceInfo, faceId);
+  namespaceInfo.extendFaceInfoLifetime(faceInfo);
 
   if (!faceInfo.isTimeoutScheduled()) {
     auto timeout = faceInfo.scheduleTimeout(interestName,
@@ -262,7 +264,11 @@ AsfStrategy::getBestFaceForForwarding(const Interest& interest, const Face& inFa
                                       const fib::Entry& fibEntry, const shared_ptr<pit::Entry>& pitEntry,
                                       bool isInterestNew)
 {
-  FaceStatsForwardingSet rankedFaces;
+  // Only the best face is needed, so keep track of it in a single pass instead of
+  // building a sorted container of all eligible faces for every Interest
+  std::optional<FaceStats> best;
+  FaceStatsForwardingCompare isBetter;
+  NamespaceInfo* nsInfo = nullptr;
 
   auto now = time::steady_clock::now();
   for (const auto& nh : fibEntry.getNextHops()) {
@@ -270,18 +276,23 @@ AsfStrategy::getBestFaceForForwarding(const Interest& interest, const Face& inFa
       continue;
     }
 
-    const FaceInfo* info = m_measurements.getFaceInfo(fibEntry, interest.getName(), nh.getFace().getId());
-    if (info == nullptr) {
-      rankedFaces.insert({&nh.getFace(), FaceInfo::RTT_NO_MEASUREMENT,
-                          FaceInfo::RTT_NO_MEASUREMENT, nh.getCost()});
+    // all next hops share the same NamespaceInfo, so look it up only once
+    if (nsInfo == nullptr) {
+      nsInfo = &m_measurements.getOrCreateNamespaceInfo(fibEntry, interest.getName());
     }
-    else {
-      rankedFaces.insert({&nh.getFace(), info->getLastRtt(), info->getSrtt(), nh.getCost()});
+
+    FaceStats stats{&nh.getFace(), FaceInfo::RTT_NO_MEASUREMENT, FaceInfo::RTT_NO_MEASUREMENT, nh.getCost()};
+    if (const FaceInfo* info = nsInfo->getFaceInfo(nh.getFace().getId()); info != nullptr) {
+      stats.rtt = info->getLastRtt();
+      stats.srtt = info->getSrtt();
+    }
+
+    if (!best || isBetter(stats, *best)) {
+      best = stats;
     }
   }
 
-  auto it = rankedFaces.begin();
-  return it != rankedFaces.end() ? it->face : nullptr;
+  return best ? best->face : nullptr;
 }
 
 void
@@ -306,7 +317,7 @@ AsfStrategy::onTimeoutOrNack(const Name& interestName, FaceId faceId, bool isNac
   if (nTimeouts < m_nMaxTimeouts && !isNack) {
     NFD_LOG_TRACE(interestName << " face=" << faceId << " timeout-count=" << nTimeouts << " ignoring");
     // Extend lifetime for measurements associated with Face
-    namespaceInfo->extendFaceInfoLifetime(faceInfo, faceId);
+    namespaceInfo->extendFaceInfoLifetime(faceInfo);
     faceInfo.cancelTimeout(interestName);
   }
   else {
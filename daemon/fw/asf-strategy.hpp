@@ -85,10 +85,9 @@ private:
   void
   sendNoRouteNack(Face& face, const shared_ptr<pit::Entry>& pitEntry);
 
-private:
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   AsfMeasurements m_measurements{getMeasurements()};
 
-NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   struct FaceStatsForwardingCompare
   {
     bool
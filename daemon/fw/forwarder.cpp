@@ -57,6 +57,9 @@ Forwarder::Forwarder(FaceTable& faceTable)
   , m_pit(m_nameTree)
   , m_measurements(m_nameTree)
   , m_strategyChoice(*this)
+  , m_segmentPrefetcher(m_measurements, [this] (const Interest& interest, FaceId downstream) {
+      sendPrefetchInterest(interest, downstream);
+    })
 {
   m_faceTable.afterAdd.connect([this] (const Face& face) {
     face.afterReceiveInterest.connect(
@@ -235,6 +238,9 @@ Forwarder::onContentStoreMiss(const Interest& interest, const FaceEndpoint& ingr
   // dispatch to strategy: after receive Interest
   m_strategyChoice.findEffectiveStrategy(*pitEntry)
     .afterReceiveInterest(interest, FaceEndpoint(ingress.face), pitEntry);
+
+  // read ahead if this continues a sequential segment fetch
+  m_segmentPrefetcher.afterContentStoreLookup(interest, ingress.face.getId(), nullptr);
 }
 
 void
@@ -256,6 +262,9 @@ Forwarder::onContentStoreHit(const Interest& interest, const FaceEndpoint& ingre
 
   // dispatch to strategy: after Content Store hit
   m_strategyChoice.findEffectiveStrategy(*pitEntry).afterContentStoreHit(data, ingress, pitEntry);
+
+  // keep the readahead window ahead of the consumer
+  m_segmentPrefetcher.afterContentStoreLookup(interest, ingress.face.getId(), &data);
 }
 
 pit::OutRecord*
@@ -567,7 +576,7 @@ Forwarder::onNewNextHop(const Name& prefix, const fib::NextHop& nextHop)
       // won't affect any PIT entries anywhere in that subtree, *unless* this is
       // the initial NTE from which the enumeration started (2nd condition), which
       // must always be considered
-      if (nte.getFibEntry() != nullptr && nte.getName().size() > prefix.size()) {
+      if (nte.getFibEntry() != nullptr && nte.getDepth() > prefix.size()) {
         return {false, false};
       }
       return {nte.hasPitEntries(), true};
@@ -621,6 +630,36 @@ Forwarder::insertDeadNonceList(pit::Entry& pitEntry, const Face* upstream)
   }
 }
 
+void
+Forwarder::sendPrefetchInterest(const Interest& interest, FaceId downstream)
+{
+  // already cached?
+  bool isCached = false;
+  m_cs.find(interest, [&] (auto&&...) { isCached = true; }, [] (auto&&...) {});
+  if (isCached) {
+    return;
+  }
+
+  // already pending, either for a consumer or for an earlier prefetch?
+  if (m_pit.find(interest) != nullptr) {
+    return;
+  }
+
+  const fib::Entry& fibEntry = m_fib.findLongestPrefixMatch(interest.getName());
+  const auto& nexthops = fibEntry.getNextHops();
+  auto it = std::find_if(nexthops.begin(), nexthops.end(), [downstream] (const auto& nh) {
+    return nh.getFace().getId() != downstream;
+  });
+  if (it == nexthops.end()) {
+    NFD_LOG_DEBUG("sendPrefetchInterest interest=" << interest.getName() << " no-nexthop");
+    return;
+  }
+
+  auto pitEntry = m_pit.insert(interest).first;
+  this->setExpiryTimer(pitEntry, interest.getInterestLifetime());
+  this->onOutgoingInterest(interest, it->getFace(), pitEntry);
+}
+
 void
 Forwarder::setConfigFile(ConfigFile& configFile)
 {
@@ -633,12 +672,16 @@ void
 Forwarder::processConfig(const ConfigSection& configSection, bool isDryRun, const std::string&)
 {
   Config config;
+  fw::SegmentPrefetcher::Config prefetchConfig;
 
   for (const auto& pair : configSection) {
     const std::string& key = pair.first;
     if (key == "default_hop_limit") {
       config.defaultHopLimit = ConfigFile::parseNumber<uint8_t>(pair, CFG_FORWARDER);
     }
+    else if (key == "cs_prefetch") {
+      prefetchConfig = parsePrefetchConfig(pair.second);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_FORWARDER + "." + key));
     }
@@ -646,7 +689,40 @@ Forwarder::processConfig(const ConfigSection& configSection, bool isDryRun, cons
 
   if (!isDryRun) {
     m_config = config;
+    m_segmentPrefetcher.setConfig(std::move(prefetchConfig));
+  }
+}
+
+fw::SegmentPrefetcher::Config
+Forwarder::parsePrefetchConfig(const ConfigSection& section)
+{
+  const std::string sectionName = CFG_FORWARDER + ".cs_prefetch";
+  fw::SegmentPrefetcher::Config config;
+
+  for (const auto& pair : section) {
+    const std::string& key = pair.first;
+    if (key == "prefix") {
+      config.prefixes.emplace_back(pair.second.get_value<std::string>());
+    }
+    else if (key == "window") {
+      config.window = ConfigFile::parseNumber<size_t>(pair, sectionName);
+      ConfigFile::checkRange(config.window, size_t(1), fw::SegmentPrefetcher::MAX_WINDOW,
+                             key, sectionName);
+    }
+    else if (key == "rate") {
+      config.rate = ConfigFile::parseNumber<size_t>(pair, sectionName);
+      ConfigFile::checkRange(config.rate, size_t(1), fw::SegmentPrefetcher::MAX_RATE,
+                             key, sectionName);
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unrecognized option " + sectionName + "." + key));
+    }
+  }
+
+  if (config.prefixes.empty()) {
+    NDN_THROW(ConfigFile::Error("Missing option " + sectionName + ".prefix"));
   }
+  return config;
 }
 
 } // namespace nfd
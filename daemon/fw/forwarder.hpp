@@ -28,6 +28,7 @@
 
 #include "face-table.hpp"
 #include "forwarder-counters.hpp"
+#include "segment-prefetcher.hpp"
 #include "unsolicited-data-policy.hpp"
 #include "common/config-file.hpp"
 #include "face/face-endpoint.hpp"
@@ -128,6 +129,12 @@ public:
     return m_networkRegionTable;
   }
 
+  fw::SegmentPrefetcher&
+  getSegmentPrefetcher() noexcept
+  {
+    return m_segmentPrefetcher;
+  }
+
   /** \brief Register handler for forwarder section of NFD configuration file.
    */
   void
@@ -221,10 +228,22 @@ private:
   void
   insertDeadNonceList(pit::Entry& pitEntry, const Face* upstream);
 
+  /** \brief Send a prefetch Interest on behalf of the Content Store.
+   *
+   *  The Interest is forwarded to the lowest-cost FIB nexthop other than \p downstream,
+   *  bypassing the strategy. Its PIT entry has no in-record, so the returned Data is
+   *  only admitted into the Content Store.
+   */
+  void
+  sendPrefetchInterest(const Interest& interest, FaceId downstream);
+
   void
   processConfig(const ConfigSection& configSection, bool isDryRun,
                 const std::string& filename);
 
+  static fw::SegmentPrefetcher::Config
+  parsePrefetchConfig(const ConfigSection& section);
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
    * \brief Configuration options from the `forwarder` section.
@@ -243,14 +262,15 @@ private:
   FaceTable& m_faceTable;
   unique_ptr<fw::UnsolicitedDataPolicy> m_unsolicitedDataPolicy;
 
-  NameTree           m_nameTree;
-  Fib                m_fib;
-  Pit                m_pit;
-  Cs                 m_cs;
-  Measurements       m_measurements;
-  StrategyChoice     m_strategyChoice;
-  DeadNonceList      m_deadNonceList;
-  NetworkRegionTable m_networkRegionTable;
+  NameTree              m_nameTree;
+  Fib                   m_fib;
+  Pit                   m_pit;
+  Cs                    m_cs;
+  Measurements          m_measurements;
+  StrategyChoice        m_strategyChoice;
+  DeadNonceList         m_deadNonceList;
+  NetworkRegionTable    m_networkRegionTable;
+  fw::SegmentPrefetcher m_segmentPrefetcher;
 
   // allow Strategy (base class) to enter pipelines
   friend ::nfd::fw::Strategy;
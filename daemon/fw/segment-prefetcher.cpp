@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "segment-prefetcher.hpp"
+#include "common/logger.hpp"
+
+namespace nfd::fw {
+
+NFD_LOG_INIT(SegmentPrefetcher);
+
+SegmentPrefetcher::SegmentPrefetcher(Measurements& measurements, SendInterest sendInterest)
+  : m_measurements(measurements)
+  , m_sendInterest(std::move(sendInterest))
+{
+  BOOST_ASSERT(m_sendInterest != nullptr);
+}
+
+void
+SegmentPrefetcher::setConfig(Config config)
+{
+  BOOST_ASSERT(config.window > 0 && config.window <= MAX_WINDOW);
+  BOOST_ASSERT(config.rate > 0 && config.rate <= MAX_RATE);
+
+  m_config = std::move(config);
+  m_tokens = static_cast<double>(m_config.window);
+  m_lastRefill = time::steady_clock::now();
+}
+
+bool
+SegmentPrefetcher::isEligible(const Name& name) const
+{
+  if (name.empty() || !name[-1].isSegment()) {
+    return false;
+  }
+  return std::any_of(m_config.prefixes.begin(), m_config.prefixes.end(),
+                     [&name] (const Name& prefix) { return prefix.isPrefixOf(name); });
+}
+
+void
+SegmentPrefetcher::afterContentStoreLookup(const Interest& interest, FaceId downstream,
+                                           const Data* data)
+{
+  const Name& name = interest.getName();
+  if (!this->isEligible(name)) {
+    return;
+  }
+
+  uint64_t segment = name[-1].toSegment();
+  Name prefix = name.getPrefix(-1);
+
+  measurements::Entry& me = m_measurements.get(prefix);
+  m_measurements.extendLifetime(me, STATE_LIFETIME);
+  auto* info = me.insertStrategyInfo<SegmentInfo>().first;
+
+  if (data != nullptr) {
+    auto finalBlock = data->getFinalBlock();
+    if (finalBlock && finalBlock->isSegment()) {
+      info->finalSegment = finalBlock->toSegment();
+    }
+  }
+
+  bool isSequential = info->lastSegment && segment == *info->lastSegment + 1;
+  info->lastSegment = segment;
+  if (!isSequential) {
+    // a seek or a new consumer: forget what was prefetched beyond the old position
+    info->highestPrefetched = segment;
+    return;
+  }
+
+  uint64_t first = std::max(segment, info->highestPrefetched) + 1;
+  uint64_t last = segment + std::min<uint64_t>(m_config.window,
+                                               std::numeric_limits<uint64_t>::max() - segment);
+  if (info->finalSegment) {
+    last = std::min(last, *info->finalSegment);
+  }
+
+  for (uint64_t s = first; s <= last && s > segment; ++s) {
+    if (!this->consumeToken()) {
+      NFD_LOG_DEBUG("prefetch " << prefix << " seg=" << s << " rate-limited");
+      break;
+    }
+
+    auto prefetch = make_shared<Interest>(Name(prefix).appendSegment(s));
+    prefetch->setMustBeFresh(interest.getMustBeFresh());
+    prefetch->setInterestLifetime(interest.getInterestLifetime());
+    prefetch->setHopLimit(interest.getHopLimit());
+
+    NFD_LOG_DEBUG("prefetch " << prefetch->getName() << " downstream=" << downstream);
+    info->highestPrefetched = s;
+    ++m_nPrefetched;
+    m_sendInterest(*prefetch, downstream);
+  }
+}
+
+bool
+SegmentPrefetcher::consumeToken()
+{
+  auto now = time::steady_clock::now();
+  auto elapsed = time::duration_cast<time::duration<double>>(now - m_lastRefill);
+  m_lastRefill = now;
+  m_tokens = std::min(m_tokens + elapsed.count() * static_cast<double>(m_config.rate),
+                      static_cast<double>(m_config.window));
+
+  if (m_tokens < 1.0) {
+    return false;
+  }
+  m_tokens -= 1.0;
+  return true;
+}
+
+} // namespace nfd::fw
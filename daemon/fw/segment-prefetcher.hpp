@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_SEGMENT_PREFETCHER_HPP
+#define NFD_DAEMON_FW_SEGMENT_PREFETCHER_HPP
+
+#include "strategy-info.hpp"
+#include "face/face-common.hpp"
+#include "table/measurements.hpp"
+
+#include <optional>
+
+namespace nfd::fw {
+
+/**
+ * \brief Prefetches upcoming segments of sequentially fetched content into the Content Store.
+ *
+ * SegmentPrefetcher observes Interests that reach the Content Store. When an Interest whose
+ * last name component is a segment number immediately follows the previous segment requested
+ * under the same prefix, the prefetcher asks the forwarder to retrieve the next `window`
+ * segments, so that they are already cached when the consumer asks for them.
+ *
+ * Per-prefix state is kept as a StrategyInfo item on the Measurements entry of the name
+ * without its segment component, and expires together with that entry.
+ * Prefetch Interests are rate-limited by a token bucket whose depth equals the window size.
+ */
+class SegmentPrefetcher : noncopyable
+{
+public:
+  static constexpr size_t DEFAULT_WINDOW = 4;
+  static constexpr size_t MAX_WINDOW = 64;
+  static constexpr size_t DEFAULT_RATE = 100;
+  static constexpr size_t MAX_RATE = 100000;
+
+  /// How long the per-prefix state is kept after the last segment Interest.
+  static constexpr time::nanoseconds STATE_LIFETIME = 30_s;
+
+  /**
+   * \brief Configuration options from the `forwarder.cs_prefetch` section.
+   */
+  struct Config
+  {
+    /// Prefixes under which prefetching is enabled; an empty list disables the prefetcher.
+    std::vector<Name> prefixes;
+    /// Number of segments requested ahead of the consumer.
+    size_t window = DEFAULT_WINDOW;
+    /// Maximum number of prefetch Interests per second.
+    size_t rate = DEFAULT_RATE;
+  };
+
+  /**
+   * \brief Callback to send a prefetch Interest.
+   *
+   * The Interest is created with make_shared. \p downstream is the face on which the
+   * triggering Interest was received; the prefetch Interest should not be sent to it.
+   */
+  using SendInterest = std::function<void(const Interest& interest, FaceId downstream)>;
+
+  SegmentPrefetcher(Measurements& measurements, SendInterest sendInterest);
+
+  const Config&
+  getConfig() const noexcept
+  {
+    return m_config;
+  }
+
+  /**
+   * \brief Replace the configuration and refill the token bucket.
+   */
+  void
+  setConfig(Config config);
+
+  /**
+   * \brief Notify the prefetcher of an Interest that has been looked up in the Content Store.
+   * \param interest the consumer Interest
+   * \param downstream face on which \p interest was received
+   * \param data the Data that satisfied \p interest from the Content Store, or nullptr on a miss
+   */
+  void
+  afterContentStoreLookup(const Interest& interest, FaceId downstream, const Data* data);
+
+  /**
+   * \brief Number of prefetch Interests handed to the SendInterest callback.
+   */
+  uint64_t
+  getNPrefetched() const noexcept
+  {
+    return m_nPrefetched;
+  }
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /**
+   * \brief Per-prefix sequential access state.
+   */
+  class SegmentInfo final : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1050;
+    }
+
+  public:
+    /// Segment number of the most recent consumer Interest.
+    std::optional<uint64_t> lastSegment;
+    /// Highest segment number covered by a prefetch Interest.
+    uint64_t highestPrefetched = 0;
+    /// Last segment number, learned from FinalBlockId of Data served from the Content Store.
+    std::optional<uint64_t> finalSegment;
+  };
+
+private:
+  /**
+   * \brief Take one token from the rate limiter.
+   * \retval false the bucket is empty and no Interest may be sent now
+   */
+  bool
+  consumeToken();
+
+  bool
+  isEligible(const Name& name) const;
+
+private:
+  Measurements& m_measurements;
+  SendInterest m_sendInterest;
+  Config m_config;
+
+  double m_tokens = 0.0;
+  time::steady_clock::time_point m_lastRefill;
+  uint64_t m_nPrefetched = 0;
+};
+
+} // namespace nfd::fw
+
+#endif // NFD_DAEMON_FW_SEGMENT_PREFETCHER_HPP
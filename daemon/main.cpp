@@ -24,6 +24,7 @@
  */
 
 #include "nfd.hpp"
+#include "mgmt/fib-manager.hpp"
 #include "rib/service.hpp"
 
 #include "common/global.hpp"
@@ -33,6 +34,7 @@
 
 #include <string.h> // for strsignal()
 
+#include <boost/asio/post.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/config.hpp>
 #include <boost/exception/diagnostic_information.hpp>
@@ -118,7 +120,7 @@ public:
     std::mutex m;
     std::condition_variable cv;
 
-    std::thread ribThread([configFile = m_configFile, &retval, &ribIo, mainIo, &cv, &m] {
+    std::thread ribThread([this, configFile = m_configFile, &retval, &ribIo, mainIo, &cv, &m] {
       {
         std::lock_guard<std::mutex> lock(m);
         ribIo = &getGlobalIoService();
@@ -131,6 +133,17 @@ public:
         ndn::KeyChain ribKeyChain;
         // must be created inside a separate thread
         rib::Service ribService(configFile, ribKeyChain);
+        // NFD-RIB runs in the same process as the forwarder, so FIB updates can be applied
+        // in bulk on the main thread instead of being sent as signed management commands
+        ribService.getFibUpdater().setDirectUpdateFunc(
+          [&fibManager = m_nfd.getFibManager()] (const auto& updates, auto done) {
+            boost::asio::post(getMainIoService(), [&fibManager, updates, done = std::move(done)] {
+              auto responses = fibManager.applyUpdates(updates);
+              boost::asio::post(getRibIoService(), [done, responses = std::move(responses)] {
+                done(responses);
+              });
+            });
+          });
         getGlobalIoService().run(); // ribIo is not thread-safe to use here
       }
       catch (const std::exception& e) {
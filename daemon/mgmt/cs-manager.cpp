@@ -24,6 +24,7 @@
  */
 
 #include "cs-manager.hpp"
+#include "common/logger.hpp"
 #include "fw/forwarder-counters.hpp"
 #include "table/cs.hpp"
 
@@ -33,6 +34,8 @@
 
 namespace nfd {
 
+NFD_LOG_INIT(CsManager);
+
 CsManager::CsManager(Cs& cs, const ForwarderCounters& fwCounters,
                      Dispatcher& dispatcher, CommandAuthenticator& authenticator)
   : ManagerBase("cs", dispatcher, authenticator)
@@ -111,6 +114,11 @@ CsManager::serveInfo(ndn::mgmt::StatusDatasetContext& context) const
   info.setNHits(m_fwCounters.nCsHits);
   info.setNMisses(m_fwCounters.nCsMisses);
 
+  // CsInfo has no field for these
+  const auto& digestCounters = m_cs.getDigestCounters();
+  NFD_LOG_INFO("implicit digests requested=" << digestCounters.nRequests <<
+               " computed=" << digestCounters.nComputations);
+
   context.append(info.wireEncode());
   context.end();
 }
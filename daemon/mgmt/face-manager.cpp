@@ -25,6 +25,7 @@
 
 #include "face-manager.hpp"
 
+#include "common/global.hpp"
 #include "common/logger.hpp"
 #include "face/generic-link-service.hpp"
 #include "face/protocol-factory.hpp"
@@ -42,6 +43,16 @@ namespace nfd {
 
 NFD_LOG_INIT(FaceManager);
 
+constexpr time::seconds COUNTER_NOTIFICATION_INTERVAL = 5_s;
+
+static uint64_t
+getByteCount(const Face& face)
+{
+  // every packet sent or received changes one of the byte counters
+  const auto& counters = face.getCounters();
+  return counters.nInBytes + counters.nOutBytes;
+}
+
 FaceManager::FaceManager(FaceSystem& faceSystem,
                          Dispatcher& dispatcher, CommandAuthenticator& authenticator)
   : ManagerBase("faces", dispatcher, authenticator)
@@ -66,13 +77,17 @@ FaceManager::FaceManager(FaceSystem& faceSystem,
 
   // register notification stream
   m_postNotification = registerNotificationStream("events");
+  m_postCounters = registerNotificationStream("counters");
   m_faceAddConn = m_faceTable.afterAdd.connect([this] (const Face& face) {
     connectFaceStateChangeSignal(face);
     notifyFaceEvent(face, ndn::nfd::FACE_EVENT_CREATED);
+    m_lastByteCounts[face.getId()] = getByteCount(face);
   });
   m_faceRemoveConn = m_faceTable.beforeRemove.connect([this] (const Face& face) {
     notifyFaceEvent(face, ndn::nfd::FACE_EVENT_DESTROYED);
+    m_lastByteCounts.erase(face.getId());
   });
+  scheduleCounterNotification();
 }
 
 void
@@ -500,6 +515,35 @@ FaceManager::notifyFaceEvent(const Face& face, ndn::nfd::FaceEventKind kind)
   m_postNotification(notification.wireEncode());
 }
 
+void
+FaceManager::notifyCounterChanges()
+{
+  auto now = time::steady_clock::now();
+  std::vector<Block> records;
+  for (const auto& face : m_faceTable) {
+    uint64_t byteCount = getByteCount(face);
+    auto& lastByteCount = m_lastByteCounts[face.getId()];
+    if (byteCount != lastByteCount) {
+      lastByteCount = byteCount;
+      records.push_back(makeFaceStatus(face, now).wireEncode());
+    }
+  }
+
+  if (!records.empty()) {
+    NFD_LOG_TRACE("notifyCounterChanges nFaces=" << records.size());
+    postRecords(m_postCounters, records);
+  }
+}
+
+void
+FaceManager::scheduleCounterNotification()
+{
+  m_counterNotificationEvent = getScheduler().schedule(COUNTER_NOTIFICATION_INTERVAL, [this] {
+    notifyCounterChanges();
+    scheduleCounterNotification();
+  });
+}
+
 void
 FaceManager::connectFaceStateChangeSignal(const Face& face)
 {
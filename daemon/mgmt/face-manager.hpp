@@ -30,7 +30,10 @@
 #include "face/face.hpp"
 #include "face/face-system.hpp"
 
+#include <ndn-cxx/util/scheduler.hpp>
+
 #include <map>
+#include <unordered_map>
 
 namespace nfd {
 
@@ -81,12 +84,28 @@ private: // NotificationStream
   void
   connectFaceStateChangeSignal(const Face& face);
 
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /**
+   * @brief Posts the FaceStatus of every face whose counters changed since the previous call
+   *        to the `faces/counters` notification stream.
+   */
+  void
+  notifyCounterChanges();
+
+private:
+  void
+  scheduleCounterNotification();
+
 private:
   FaceSystem& m_faceSystem;
   FaceTable& m_faceTable;
   ndn::mgmt::PostNotification m_postNotification;
+  ndn::mgmt::PostNotification m_postCounters;
   signal::ScopedConnection m_faceAddConn;
   signal::ScopedConnection m_faceRemoveConn;
+  /// FaceId => sum of byte counters at the previous counters notification
+  std::unordered_map<FaceId, uint64_t> m_lastByteCounts;
+  ndn::scheduler::ScopedEventId m_counterNotificationEvent;
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::map<FaceId, signal::ScopedConnection> m_faceStateChangeConn;
@@ -25,6 +25,7 @@
 
 #include "fib-manager.hpp"
 
+#include "common/global.hpp"
 #include "common/logger.hpp"
 #include "fw/face-table.hpp"
 #include "table/fib.hpp"
@@ -38,6 +39,25 @@ namespace nfd {
 
 NFD_LOG_INIT(FibManager);
 
+constexpr time::milliseconds CHANGE_NOTIFICATION_DELAY = 1_s;
+
+static ndn::nfd::FibEntry
+makeFibEntryRecord(const Name& prefix, const fib::Entry* entry)
+{
+  ndn::nfd::FibEntry record;
+  record.setPrefix(prefix);
+  if (entry != nullptr) {
+    const auto& nexthops = entry->getNextHops() |
+                           boost::adaptors::transformed([] (const fib::NextHop& nh) {
+                             return ndn::nfd::NextHopRecord()
+                                 .setFaceId(nh.getFace().getId())
+                                 .setCost(nh.getCost());
+                           });
+    record.setNextHopRecords(std::begin(nexthops), std::end(nexthops));
+  }
+  return record;
+}
+
 FibManager::FibManager(Fib& fib, const FaceTable& faceTable,
                        Dispatcher& dispatcher, CommandAuthenticator& authenticator)
   : ManagerBase("fib", dispatcher, authenticator)
@@ -49,7 +69,9 @@ FibManager::FibManager(Fib& fib, const FaceTable& faceTable,
   registerCommandHandler<ndn::nfd::FibRemoveNextHopCommand>("remove-nexthop",
     [this] (auto&&, auto&&, auto&&... args) { removeNextHop(std::forward<decltype(args)>(args)...); });
   registerStatusDatasetHandler("list",
-    [this] (auto&&, auto&&, auto&&... args) { listEntries(std::forward<decltype(args)>(args)...); });
+    [this] (auto&&... args) { listEntries(std::forward<decltype(args)>(args)...); });
+
+  m_postEntryChanges = registerNotificationStream("events");
 }
 
 void
@@ -57,48 +79,80 @@ FibManager::addNextHop(const Interest& interest, ControlParameters parameters,
                        const ndn::mgmt::CommandContinuation& done)
 {
   setFaceForSelfRegistration(interest, parameters);
-  const Name& prefix = parameters.getName();
-  FaceId faceId = parameters.getFaceId();
-  uint64_t cost = parameters.getCost();
 
+  auto response = doAddNextHop(parameters.getName(), parameters.getFaceId(), parameters.getCost());
+  if (response.getCode() == 200) {
+    response.setBody(parameters.wireEncode());
+  }
+  done(response);
+}
+
+void
+FibManager::removeNextHop(const Interest& interest, ControlParameters parameters,
+                          const ndn::mgmt::CommandContinuation& done)
+{
+  setFaceForSelfRegistration(interest, parameters);
+
+  done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
+
+  doRemoveNextHop(parameters.getName(), parameters.getFaceId());
+}
+
+std::vector<ControlResponse>
+FibManager::applyUpdates(const std::list<rib::FibUpdate>& updates)
+{
+  std::vector<ControlResponse> responses;
+  responses.reserve(updates.size());
+
+  for (const auto& update : updates) {
+    if (update.action == rib::FibUpdate::ADD_NEXTHOP) {
+      responses.push_back(doAddNextHop(update.name, update.faceId, update.cost));
+    }
+    else {
+      doRemoveNextHop(update.name, update.faceId);
+      responses.emplace_back(200, "Success");
+    }
+  }
+
+  NFD_LOG_DEBUG("applied " << updates.size() << " updates");
+  return responses;
+}
+
+ControlResponse
+FibManager::doAddNextHop(const Name& prefix, FaceId faceId, uint64_t cost)
+{
   if (prefix.size() > Fib::getMaxDepth()) {
     NFD_LOG_DEBUG("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost <<
                   "): FAIL prefix-too-long");
-    return done(ControlResponse(414, "FIB entry prefix cannot exceed " +
-                                std::to_string(Fib::getMaxDepth()) + " components"));
+    return ControlResponse(414, "FIB entry prefix cannot exceed " +
+                           std::to_string(Fib::getMaxDepth()) + " components");
   }
 
   Face* face = m_faceTable.get(faceId);
   if (face == nullptr) {
     NFD_LOG_DEBUG("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost <<
                   "): FAIL unknown-faceid");
-    return done(ControlResponse(410, "Face not found"));
+    return ControlResponse(410, "Face not found");
   }
 
   fib::Entry* entry = m_fib.insert(prefix).first;
   m_fib.addOrUpdateNextHop(*entry, *face, cost);
+  notifyEntryChange(prefix);
 
   NFD_LOG_TRACE("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost << "): OK");
-  return done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
+  return ControlResponse(200, "Success");
 }
 
 void
-FibManager::removeNextHop(const Interest& interest, ControlParameters parameters,
-                          const ndn::mgmt::CommandContinuation& done)
+FibManager::doRemoveNextHop(const Name& prefix, FaceId faceId)
 {
-  setFaceForSelfRegistration(interest, parameters);
-  const Name& prefix = parameters.getName();
-  FaceId faceId = parameters.getFaceId();
-
-  done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
-
   Face* face = m_faceTable.get(faceId);
   if (face == nullptr) {
     NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK no-face");
     return;
   }
 
-  fib::Entry* entry = m_fib.findExactMatch(parameters.getName());
+  fib::Entry* entry = m_fib.findExactMatch(prefix);
   if (entry == nullptr) {
     NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK no-entry");
     return;
@@ -111,31 +165,70 @@ FibManager::removeNextHop(const Interest& interest, ControlParameters parameters
       break;
     case Fib::RemoveNextHopResult::FIB_ENTRY_REMOVED:
       NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK entry-erased");
+      notifyEntryChange(prefix);
       break;
     case Fib::RemoveNextHopResult::NEXTHOP_REMOVED:
       NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK nexthop-removed");
+      notifyEntryChange(prefix);
       break;
   }
 }
 
 void
-FibManager::listEntries(ndn::mgmt::StatusDatasetContext& context)
+FibManager::listEntries(const Name& topPrefix, const Interest& interest,
+                        ndn::mgmt::StatusDatasetContext& context)
 {
-  for (const auto& entry : m_fib) {
-    const auto& nexthops = entry.getNextHops() |
-                           boost::adaptors::transformed([] (const fib::NextHop& nh) {
-                             return ndn::nfd::NextHopRecord()
-                                 .setFaceId(nh.getFace().getId())
-                                 .setCost(nh.getCost());
-                           });
-    context.append(ndn::nfd::FibEntry()
-                   .setPrefix(entry.getPrefix())
-                   .setNextHopRecords(std::begin(nexthops), std::end(nexthops))
-                   .wireEncode());
+  std::optional<DatasetPage> page;
+  try {
+    page = parseDatasetPage(topPrefix, "list", interest);
+  }
+  catch (const tlv::Error& e) {
+    return context.reject(ControlResponse(400, e.what()));
+  }
+
+  auto appendEntry = [&context] (const fib::Entry& entry) {
+    context.append(makeFibEntryRecord(entry.getPrefix(), &entry).wireEncode());
+  };
+
+  if (!page) {
+    m_fib.forEachEntry(appendEntry);
+  }
+  else {
+    // pages follow canonical name order, which does not change when the name tree
+    // hashtable is resized between two requests
+    auto range = m_fib.getOrderedRange(page->after);
+    size_t nEntries = 0;
+    for (auto it = range.begin(); it != range.end() && nEntries < DATASET_PAGE_SIZE;
+         ++it, ++nEntries) {
+      appendEntry(*it);
+    }
   }
   context.end();
 }
 
+void
+FibManager::notifyEntryChange(const Name& prefix)
+{
+  m_changedEntries.insert(prefix);
+  if (!m_entryChangeEvent) {
+    m_entryChangeEvent = getScheduler().schedule(CHANGE_NOTIFICATION_DELAY, [this] {
+      postEntryChanges();
+    });
+  }
+}
+
+void
+FibManager::postEntryChanges()
+{
+  std::vector<Block> records;
+  records.reserve(m_changedEntries.size());
+  for (const auto& prefix : m_changedEntries) {
+    records.push_back(makeFibEntryRecord(prefix, m_fib.findExactMatch(prefix)).wireEncode());
+  }
+  m_changedEntries.clear();
+  postRecords(m_postEntryChanges, records);
+}
+
 void
 FibManager::setFaceForSelfRegistration(const Interest& request, ControlParameters& parameters)
 {
@@ -27,6 +27,11 @@
 #define NFD_DAEMON_MGMT_FIB_MANAGER_HPP
 
 #include "manager-base.hpp"
+#include "rib/fib-update.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <set>
 
 namespace nfd {
 
@@ -46,6 +51,17 @@ public:
   FibManager(fib::Fib& fib, const FaceTable& faceTable,
              Dispatcher& dispatcher, CommandAuthenticator& authenticator);
 
+  /**
+   * @brief Apply next hop changes computed by the RIB service, bypassing command dispatch.
+   *
+   * Each update is processed like the corresponding add-nexthop or remove-nexthop command.
+   * A failed update does not prevent the following ones from being applied.
+   *
+   * @return one response per update, in the same order
+   */
+  std::vector<ControlResponse>
+  applyUpdates(const std::list<rib::FibUpdate>& updates);
+
 private:
   void
   addNextHop(const Interest& interest, ControlParameters parameters,
@@ -56,15 +72,39 @@ private:
                 const ndn::mgmt::CommandContinuation& done);
 
   void
-  listEntries(ndn::mgmt::StatusDatasetContext& context);
+  listEntries(const Name& topPrefix, const Interest& interest,
+              ndn::mgmt::StatusDatasetContext& context);
+
+  ControlResponse
+  doAddNextHop(const Name& prefix, FaceId faceId, uint64_t cost);
+
+  void
+  doRemoveNextHop(const Name& prefix, FaceId faceId);
 
 private:
   void
   setFaceForSelfRegistration(const Interest& request, ControlParameters& parameters);
 
+private: // NotificationStream
+  /**
+   * @brief Records that the entry of @p prefix has changed.
+   *
+   * Changes are coalesced for a short delay and then posted to the `fib/events` notification
+   * stream as FibEntry records with the current nexthops. An erased entry is represented
+   * by a record without nexthops.
+   */
+  void
+  notifyEntryChange(const Name& prefix);
+
+  void
+  postEntryChanges();
+
 private:
   fib::Fib& m_fib;
   const FaceTable& m_faceTable;
+  ndn::mgmt::PostNotification m_postEntryChanges;
+  std::set<Name> m_changedEntries;
+  ndn::scheduler::ScopedEventId m_entryChangeEvent;
 };
 
 } // namespace nfd
@@ -27,6 +27,10 @@
 
 namespace nfd {
 
+const name::Component DATASET_PAGE_COMPONENT("page");
+// leave room for the name and signature of the notification Data
+constexpr size_t MAX_NOTIFICATION_PAYLOAD = ndn::MAX_NDN_PACKET_SIZE - 800;
+
 ManagerBase::ManagerBase(std::string_view module, Dispatcher& dispatcher)
   : m_module(module)
   , m_dispatcher(dispatcher)
@@ -75,6 +79,52 @@ ManagerBase::extractSigner(const Interest& interest)
   }
 }
 
+std::optional<ManagerBase::DatasetPage>
+ManagerBase::parseDatasetPage(const Name& prefix, const std::string& verb,
+                              const Interest& interest) const
+{
+  const Name& name = interest.getName();
+  size_t pos = prefix.size() + makeRelPrefix(verb).size();
+  if (name.size() <= pos) {
+    return std::nullopt;
+  }
+
+  if (name[pos] != DATASET_PAGE_COMPONENT || name.size() > pos + 2) {
+    NDN_THROW(tlv::Error("Unrecognized dataset request suffix " + name.getSubName(pos).toUri()));
+  }
+
+  DatasetPage page;
+  if (name.size() == pos + 2) {
+    page.after.emplace(name[pos + 1].blockFromValue());
+  }
+  return page;
+}
+
+void
+ManagerBase::postRecords(const ndn::mgmt::PostNotification& post, const std::vector<Block>& records)
+{
+  Block payload(tlv::Content);
+  size_t payloadSize = 0;
+  auto flush = [&] {
+    if (payload.elements().empty()) {
+      return;
+    }
+    payload.encode();
+    post(payload);
+    payload = Block(tlv::Content);
+    payloadSize = 0;
+  };
+
+  for (const auto& record : records) {
+    if (payloadSize + record.size() > MAX_NOTIFICATION_PAYLOAD) {
+      flush();
+    }
+    payload.push_back(record);
+    payloadSize += record.size();
+  }
+  flush();
+}
+
 ndn::mgmt::Authorization
 ManagerBase::makeAuthorization(const std::string& verb)
 {
@@ -104,6 +104,50 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PROTECTED: // helpers
   static std::string
   extractSigner(const Interest& interest);
 
+  /**
+   * @brief Position in a paginated status dataset.
+   */
+  struct DatasetPage
+  {
+    /// name of the last entry in the previous page, or nullopt for the first page
+    std::optional<Name> after;
+  };
+
+  /**
+   * @brief Parses the pagination suffix of a status dataset request.
+   *
+   * A dataset that supports pagination is returned as a whole when requested under its
+   * usual name, e.g., `/localhost/nfd/fib/list`. Appending the component `page` requests
+   * the first page of at most #DATASET_PAGE_SIZE entries. Appending `page` and a component
+   * containing the TLV encoding of the last name received requests the following page.
+   * A page with fewer than #DATASET_PAGE_SIZE entries is the last one. Pages follow the
+   * canonical order of entry names, so a table that changes between two requests is still
+   * enumerated without skipping or repeating the entries present throughout.
+   *
+   * Serving a large table in pages bounds the work done by each request, so that other
+   * events are processed between the pages.
+   *
+   * @param prefix top prefix passed to the StatusDatasetHandler
+   * @param verb dataset verb
+   * @param interest dataset request
+   * @return nullopt if the whole dataset is requested
+   * @throw tlv::Error the suffix is malformed
+   */
+  std::optional<DatasetPage>
+  parseDatasetPage(const Name& prefix, const std::string& verb, const Interest& interest) const;
+
+  static constexpr size_t DATASET_PAGE_SIZE = 1000;
+
+  /**
+   * @brief Posts @p records to a notification stream.
+   *
+   * The records are packed into as few notifications as possible. Each notification is a
+   * Content element whose value is a concatenation of records, the same layout as the payload
+   * of a StatusDataset, so that it can be decoded in the same way.
+   */
+  static void
+  postRecords(const ndn::mgmt::PostNotification& post, const std::vector<Block>& records);
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
    * @brief Returns an authorization function for a specific management module and verb.
@@ -138,7 +182,7 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
    * @return the generated relative prefix
    */
   PartialName
-  makeRelPrefix(const std::string& verb)
+  makeRelPrefix(const std::string& verb) const
   {
     return PartialName(m_module).append(verb);
   }
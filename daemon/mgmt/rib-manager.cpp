@@ -27,6 +27,7 @@
 
 #include "common/global.hpp"
 #include "common/logger.hpp"
+#include "face/face-common.hpp"
 #include "rib/rib.hpp"
 #include "table/fib.hpp"
 
@@ -47,6 +48,40 @@ NFD_LOG_INIT(RibManager);
 const std::string MGMT_MODULE_NAME = "rib";
 const Name LOCALHOST_TOP_PREFIX = "/localhost/nfd";
 constexpr time::seconds ACTIVE_FACE_FETCH_INTERVAL = 5_min;
+constexpr time::milliseconds CHANGE_NOTIFICATION_DELAY = 1_s;
+
+/** \brief Determine whether routes via a face can be saved in a snapshot.
+ *  \tparam FaceInfo ndn::nfd::FaceStatus or ndn::nfd::FaceEventNotification
+ */
+template<typename FaceInfo>
+static bool
+canSnapshotRoutesOf(const FaceInfo& info)
+{
+  return info.getFaceId() > face::FACEID_RESERVED_MAX &&
+         info.getFacePersistency() != ndn::nfd::FACE_PERSISTENCY_ON_DEMAND;
+}
+
+static ndn::nfd::RibEntry
+makeRibEntryRecord(const Name& name, const rib::RibEntry* entry,
+                   const time::steady_clock::time_point& now)
+{
+  ndn::nfd::RibEntry record;
+  record.setName(name);
+  if (entry != nullptr) {
+    for (const Route& route : entry->getRoutes()) {
+      ndn::nfd::Route r;
+      r.setFaceId(route.faceId);
+      r.setOrigin(route.origin);
+      r.setCost(route.cost);
+      r.setFlags(route.flags);
+      if (route.expires) {
+        r.setExpirationPeriod(time::duration_cast<time::milliseconds>(*route.expires - now));
+      }
+      record.addRoute(r);
+    }
+  }
+  return record;
+}
 
 RibManager::RibManager(rib::Rib& rib, ndn::Face& face, ndn::KeyChain& keyChain,
                        ndn::nfd::Controller& nfdController, Dispatcher& dispatcher)
@@ -66,7 +101,15 @@ RibManager::RibManager(rib::Rib& rib, ndn::Face& face, ndn::KeyChain& keyChain,
   registerCommandHandler<ndn::nfd::RibUnregisterCommand>("unregister",
     [this] (auto&&, auto&&, auto&&... args) { unregisterEntry(std::forward<decltype(args)>(args)...); });
   registerStatusDatasetHandler("list",
-    [this] (auto&&, auto&&, auto&&... args) { listEntries(std::forward<decltype(args)>(args)...); });
+    [this] (auto&&... args) { listEntries(std::forward<decltype(args)>(args)...); });
+
+  m_postEntryChanges = registerNotificationStream("events");
+  m_afterAddRouteConn = m_rib.afterAddRoute.connect([this] (const rib::RibRouteRef& ref) {
+    notifyEntryChange(ref.entry->getName());
+  });
+  m_beforeRemoveRouteConn = m_rib.beforeRemoveRoute.connect([this] (const rib::RibRouteRef& ref) {
+    notifyEntryChange(ref.entry->getName());
+  });
 }
 
 void
@@ -189,6 +232,68 @@ RibManager::beginRibUpdate(const RibUpdate& update,
     });
 }
 
+void
+RibManager::beginAddRoutes(std::vector<std::pair<Name, Route>> routes)
+{
+  // in canonical order, the names under a prefix immediately follow that prefix
+  std::sort(routes.begin(), routes.end(), [] (const auto& a, const auto& b) {
+    return std::tie(a.second.faceId, a.first) < std::tie(b.second.faceId, b.first);
+  });
+
+  auto now = time::steady_clock::now();
+  std::vector<rib::RibUpdateBatch> batches;
+  size_t firstBatchOfFace = 0;
+  // names of the current face that are prefixes of the current name, shortest first
+  std::vector<Name> ancestors;
+  for (auto& item : routes) {
+    const Name& name = item.first;
+    Route& route = item.second;
+    if (batches.size() == firstBatchOfFace || batches.back().getFaceId() != route.faceId) {
+      firstBatchOfFace = batches.size();
+      ancestors.clear();
+    }
+    while (!ancestors.empty() && !ancestors.back().isPrefixOf(name)) {
+      ancestors.pop_back();
+    }
+    // a route goes one batch after the deepest of its ancestors
+    size_t batchIndex = firstBatchOfFace + ancestors.size();
+    ancestors.push_back(name);
+    if (batchIndex == batches.size()) {
+      batches.emplace_back(route.faceId);
+    }
+
+    if (route.expires) {
+      auto event = getScheduler().schedule(*route.expires - now,
+                                           [=] { m_rib.onRouteExpiration(name, route); });
+      route.setExpirationEvent(event);
+    }
+    NFD_LOG_DEBUG("Adding route " << name << " nexthop=" << route.faceId <<
+                  " origin=" << route.origin << " cost=" << route.cost);
+
+    RibUpdate update;
+    update.setAction(RibUpdate::REGISTER)
+          .setName(name)
+          .setRoute(route);
+    batches[batchIndex].add(update);
+  }
+
+  for (const auto& batch : batches) {
+    uint64_t faceId = batch.getFaceId();
+    size_t nRoutes = batch.size();
+    m_rib.beginApplyBatch(batch,
+      [=] {
+        NFD_LOG_DEBUG("RIB update succeeded for " << nRoutes << " routes via face " << faceId);
+      },
+      [=] (uint32_t code, const std::string& error) {
+        NFD_LOG_DEBUG("RIB update failed for " << nRoutes << " routes via face " << faceId <<
+                      " (" << code << " " << error << ")");
+
+        // Since the FIB rejected the update, clean up invalid routes
+        scheduleActiveFaceFetch(1_s);
+      });
+  }
+}
+
 void
 RibManager::registerTopPrefix(const Name& topPrefix)
 {
@@ -263,29 +368,58 @@ RibManager::unregisterEntry(const Interest& interest, ControlParameters paramete
 }
 
 void
-RibManager::listEntries(ndn::mgmt::StatusDatasetContext& context)
+RibManager::listEntries(const Name& topPrefix, const Interest& interest,
+                        ndn::mgmt::StatusDatasetContext& context)
 {
+  std::optional<DatasetPage> page;
+  try {
+    page = parseDatasetPage(topPrefix, "list", interest);
+  }
+  catch (const tlv::Error& e) {
+    return context.reject(ControlResponse(400, e.what()));
+  }
+
+  auto first = m_rib.begin();
+  size_t maxEntries = m_rib.size();
+  if (page) {
+    first = page->after ? m_rib.upper_bound(*page->after) : m_rib.begin();
+    maxEntries = DATASET_PAGE_SIZE;
+  }
+
   auto now = time::steady_clock::now();
-  for (const auto& kv : m_rib) {
-    const rib::RibEntry& entry = *kv.second;
-    ndn::nfd::RibEntry item;
-    item.setName(entry.getName());
-    for (const Route& route : entry.getRoutes()) {
-      ndn::nfd::Route r;
-      r.setFaceId(route.faceId);
-      r.setOrigin(route.origin);
-      r.setCost(route.cost);
-      r.setFlags(route.flags);
-      if (route.expires) {
-        r.setExpirationPeriod(time::duration_cast<time::milliseconds>(*route.expires - now));
-      }
-      item.addRoute(r);
-    }
-    context.append(item.wireEncode());
+  size_t nEntries = 0;
+  for (auto it = first; it != m_rib.end() && nEntries < maxEntries; ++it, ++nEntries) {
+    context.append(makeRibEntryRecord(it->first, it->second.get(), now).wireEncode());
   }
   context.end();
 }
 
+void
+RibManager::notifyEntryChange(const Name& name)
+{
+  m_changedEntries.insert(name);
+  if (!m_entryChangeEvent) {
+    m_entryChangeEvent = getScheduler().schedule(CHANGE_NOTIFICATION_DELAY, [this] {
+      postEntryChanges();
+    });
+  }
+}
+
+void
+RibManager::postEntryChanges()
+{
+  auto now = time::steady_clock::now();
+  std::vector<Block> records;
+  records.reserve(m_changedEntries.size());
+  for (const auto& name : m_changedEntries) {
+    auto it = m_rib.find(name);
+    const rib::RibEntry* entry = it == m_rib.end() ? nullptr : it->second.get();
+    records.push_back(makeRibEntryRecord(name, entry, now).wireEncode());
+  }
+  m_changedEntries.clear();
+  postRecords(m_postEntryChanges, records);
+}
+
 void
 RibManager::setFaceForSelfRegistration(const Interest& request, ControlParameters& parameters)
 {
@@ -420,6 +554,121 @@ RibManager::slFindAnn(const Name& name, const SlFindAnnCallback& cb) const
   cb(pa);
 }
 
+void
+RibManager::saveSnapshot(const std::string& path) const
+{
+  if (!m_hasFaceUris) {
+    // every route would be dropped for lack of a face URI, keep the previous snapshot instead
+    NFD_LOG_DEBUG("Active faces not known yet, not saving snapshot to " << path);
+    return;
+  }
+
+  auto steadyNow = time::steady_clock::now();
+  auto systemNow = time::system_clock::now();
+
+  std::vector<rib::snapshot::Record> records;
+  records.reserve(m_rib.size() + m_pendingSnapshot.size());
+  for (const auto& [name, entry] : m_rib) {
+    for (const Route& route : *entry) {
+      auto face = m_faceUris.find(route.faceId);
+      if (face == m_faceUris.end() || route.announcement) {
+        continue;
+      }
+
+      auto& record = records.emplace_back();
+      record.name = name;
+      record.remoteUri = face->second.first;
+      record.localUri = face->second.second;
+      record.origin = route.origin;
+      record.cost = route.cost;
+      record.flags = route.flags;
+      if (route.expires) {
+        record.expires = systemNow + time::duration_cast<time::system_clock::duration>(
+                                       *route.expires - steadyNow);
+      }
+    }
+  }
+  // routes that have not been restored yet are kept for the next start
+  records.insert(records.end(), m_pendingSnapshot.begin(), m_pendingSnapshot.end());
+
+  rib::snapshot::save(path, records);
+  NFD_LOG_INFO("Saved " << records.size() << " routes to " << path);
+}
+
+void
+RibManager::restoreSnapshot(const std::string& path)
+{
+  // FaceIds are assigned anew after a restart, so routes can only be added once faces are known;
+  // saving a snapshot needs the face URIs too, even if there is nothing to restore
+  fetchActiveFaces();
+
+  m_pendingSnapshot = rib::snapshot::load(path);
+  NFD_LOG_INFO("Loaded " << m_pendingSnapshot.size() << " routes from " << path);
+
+  m_pendingSnapshotTimeout = getScheduler().schedule(SNAPSHOT_RESTORE_TIMEOUT, [this] {
+    for (const auto& record : m_pendingSnapshot) {
+      NFD_LOG_DEBUG("Discarding " << record << ": face not found");
+    }
+    NFD_LOG_INFO("Discarding " << m_pendingSnapshot.size() <<
+                 " routes from snapshot: face not found");
+    m_pendingSnapshot.clear();
+  });
+}
+
+void
+RibManager::applySnapshot()
+{
+  if (m_pendingSnapshot.empty()) {
+    return;
+  }
+
+  std::map<std::pair<std::string, std::string>, uint64_t> faceIds;
+  for (const auto& [faceId, uris] : m_faceUris) {
+    faceIds.emplace(uris, faceId);
+  }
+
+  auto now = time::system_clock::now();
+  auto steadyNow = time::steady_clock::now();
+  std::vector<std::pair<Name, Route>> routes;
+  size_t nExpired = 0;
+  auto isApplied = [&] (const rib::snapshot::Record& record) {
+    auto face = faceIds.find({record.remoteUri, record.localUri});
+    if (face == faceIds.end()) {
+      // the face may still be created, keep the route until SNAPSHOT_RESTORE_TIMEOUT
+      return false;
+    }
+
+    Route route;
+    route.faceId = face->second;
+    route.origin = record.origin;
+    route.cost = record.cost;
+    route.flags = static_cast<decltype(route.flags)>(record.flags);
+    if (record.expires) {
+      auto expires = time::duration_cast<time::nanoseconds>(*record.expires - now);
+      if (expires <= 0_ns) {
+        NFD_LOG_DEBUG("Discarding " << record << ": expired");
+        ++nExpired;
+        return true;
+      }
+      route.expires = steadyNow + expires;
+    }
+    routes.emplace_back(record.name, std::move(route));
+    return true;
+  };
+  auto notApplied = std::remove_if(m_pendingSnapshot.begin(), m_pendingSnapshot.end(), isApplied);
+  m_pendingSnapshot.erase(notApplied, m_pendingSnapshot.end());
+  if (m_pendingSnapshot.empty()) {
+    m_pendingSnapshotTimeout.cancel();
+  }
+
+  if (routes.empty() && nExpired == 0) {
+    return;
+  }
+  NFD_LOG_INFO("Restoring " << routes.size() << " routes from snapshot, " << nExpired <<
+               " expired, " << m_pendingSnapshot.size() << " waiting for their faces");
+  beginAddRoutes(std::move(routes));
+}
+
 void
 RibManager::fetchActiveFaces()
 {
@@ -449,12 +698,20 @@ RibManager::removeInvalidFaces(const std::vector<ndn::nfd::FaceStatus>& activeFa
   NFD_LOG_DEBUG("Checking for invalid face registrations");
 
   std::set<uint64_t> activeIds;
+  m_faceUris.clear();
+  m_hasFaceUris = true;
   for (const auto& faceStatus : activeFaces) {
     activeIds.insert(faceStatus.getFaceId());
+    if (canSnapshotRoutesOf(faceStatus)) {
+      m_faceUris.try_emplace(faceStatus.getFaceId(),
+                             faceStatus.getRemoteUri(), faceStatus.getLocalUri());
+    }
   }
   boost::asio::defer(getGlobalIoService(),
                      [this, active = std::move(activeIds)] { m_rib.beginRemoveFailedFaces(active); });
 
+  applySnapshot();
+
   // Reschedule the check for future clean up
   scheduleActiveFaceFetch(ACTIVE_FACE_FETCH_INTERVAL);
 }
@@ -466,9 +723,20 @@ RibManager::onNotification(const ndn::nfd::FaceEventNotification& notification)
 
   if (notification.getKind() == ndn::nfd::FACE_EVENT_DESTROYED) {
     NFD_LOG_DEBUG("Received notification for destroyed FaceId " << notification.getFaceId());
+    m_faceUris.erase(notification.getFaceId());
     boost::asio::defer(getGlobalIoService(),
                        [this, id = notification.getFaceId()] { m_rib.beginRemoveFace(id); });
   }
+  else if (canSnapshotRoutesOf(notification)) {
+    m_faceUris.insert_or_assign(notification.getFaceId(),
+                                std::pair(notification.getRemoteUri(), notification.getLocalUri()));
+    if (notification.getKind() == ndn::nfd::FACE_EVENT_CREATED) {
+      applySnapshot();
+    }
+  }
+  else {
+    m_faceUris.erase(notification.getFaceId());
+  }
 }
 
 } // namespace nfd
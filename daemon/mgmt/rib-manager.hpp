@@ -27,6 +27,7 @@
 #define NFD_DAEMON_MGMT_RIB_MANAGER_HPP
 
 #include "manager-base.hpp"
+#include "rib/rib-snapshot.hpp"
 #include "rib/route.hpp"
 
 #include <ndn-cxx/mgmt/nfd/controller.hpp>
@@ -36,10 +37,14 @@
 #include <ndn-cxx/security/validator-config.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
 
+#include <map>
+#include <set>
+
 namespace nfd {
 
 namespace rib {
 class Rib;
+class RibEntry;
 class RibUpdate;
 } // namespace rib
 
@@ -159,6 +164,34 @@ public: // self-learning support
   void
   slFindAnn(const Name& name, const SlFindAnnCallback& cb) const;
 
+public: // snapshot support
+  /** \brief Write the routes in the RIB to a snapshot file.
+   *
+   *  Only routes whose nexthop is a persistent or permanent face are saved, because they are
+   *  recorded by face URIs and the URIs of on-demand faces do not identify the same peer after
+   *  a restart. Routes created by prefix announcements are not saved either.
+   *
+   *  Nothing is written until the face dataset has been retrieved once, because the face
+   *  URIs of existing routes are unknown until then.
+   *
+   *  \throw rib::snapshot::Error the snapshot cannot be written
+   */
+  void
+  saveSnapshot(const std::string& path) const;
+
+  /** \brief Restore the routes in a snapshot file.
+   *
+   *  The snapshot is read immediately. Each route is added to the RIB and FIB as soon as a
+   *  face with the same URIs is known, either from the face dataset or from a face creation
+   *  notification, using the current FaceId of that face. Routes whose face does not appear
+   *  within SNAPSHOT_RESTORE_TIMEOUT, or which have expired, are discarded.
+   *  The face dataset is requested even if the snapshot cannot be read.
+   *
+   *  \throw rib::snapshot::Error the snapshot cannot be read
+   */
+  void
+  restoreSnapshot(const std::string& path);
+
 private: // RIB and FibUpdater actions
   enum class RibUpdateResult
   {
@@ -193,6 +226,16 @@ private: // RIB and FibUpdater actions
   beginRibUpdate(const rib::RibUpdate& update,
                  const std::function<void(RibUpdateResult)>& done);
 
+  /** \brief Start adding many routes to RIB and FIB.
+   *
+   *  The routes are grouped into as few RibUpdateBatches as possible: each batch holds the
+   *  routes of one face whose names are not prefixes of each other, so that FibUpdater can
+   *  compute their FIB updates together.
+   *  \param routes route names and parameters; routes may contain absolute expiration times
+   */
+  void
+  beginAddRoutes(std::vector<std::pair<Name, rib::Route>> routes);
+
 private: // management Dispatcher related
   void
   registerTopPrefix(const Name& topPrefix);
@@ -212,7 +255,8 @@ private: // management Dispatcher related
   /** \brief Serve rib/list dataset.
    */
   void
-  listEntries(ndn::mgmt::StatusDatasetContext& context);
+  listEntries(const Name& topPrefix, const Interest& interest,
+              ndn::mgmt::StatusDatasetContext& context);
 
   void
   setFaceForSelfRegistration(const Interest& request, ControlParameters& parameters);
@@ -220,6 +264,19 @@ private: // management Dispatcher related
   ndn::mgmt::Authorization
   makeAuthorization(const std::string& verb) final;
 
+private: // NotificationStream
+  /** \brief Record that the RIB entry of \p name has changed.
+   *
+   *  Changes are coalesced for a short delay and then posted to the `rib/events` notification
+   *  stream as RibEntry records with the current routes. An erased entry is represented by
+   *  a record without routes.
+   */
+  void
+  notifyEntryChange(const Name& name);
+
+  void
+  postEntryChanges();
+
 private: // Face monitor
   void
   fetchActiveFaces();
@@ -237,9 +294,18 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   onNotification(const ndn::nfd::FaceEventNotification& notification);
 
+  /** \brief Restore the pending snapshot routes whose face is known.
+   */
+  void
+  applySnapshot();
+
 public:
   static inline const Name LOCALHOP_TOP_PREFIX{"/localhop/nfd"};
 
+  /** \brief How long routes restored from a snapshot wait for their faces to appear.
+   */
+  static constexpr time::seconds SNAPSHOT_RESTORE_TIMEOUT = 30_min;
+
 private:
   rib::Rib& m_rib;
   ndn::KeyChain& m_keyChain;
@@ -253,6 +319,20 @@ private:
   bool m_isLocalhopEnabled;
 
   ndn::scheduler::ScopedEventId m_activeFaceFetchEvent;
+
+  ndn::mgmt::PostNotification m_postEntryChanges;
+  signal::ScopedConnection m_afterAddRouteConn;
+  signal::ScopedConnection m_beforeRemoveRouteConn;
+  std::set<Name> m_changedEntries;
+  ndn::scheduler::ScopedEventId m_entryChangeEvent;
+
+  /// persistent and permanent faces: FaceId => (remote URI, local URI)
+  std::map<uint64_t, std::pair<std::string, std::string>> m_faceUris;
+  /// whether m_faceUris has been filled from the face dataset at least once
+  bool m_hasFaceUris = false;
+  /// routes waiting to be restored until their faces are known
+  std::vector<rib::snapshot::Record> m_pendingSnapshot;
+  ndn::scheduler::ScopedEventId m_pendingSnapshotTimeout;
 };
 
 std::ostream&
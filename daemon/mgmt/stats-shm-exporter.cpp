@@ -0,0 +1,333 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stats-shm-exporter.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+#include "fw/face-table.hpp"
+#include "fw/forwarder.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nfd {
+
+NFD_LOG_INIT(StatsShmExporter);
+
+const std::string CFG_STATS_EXPORT = "stats_export";
+constexpr time::milliseconds DEFAULT_INTERVAL = 1_s;
+constexpr size_t INITIAL_FACE_CAPACITY = 256;
+
+static uint64_t
+toNanoseconds(time::system_clock::time_point tp)
+{
+  return static_cast<uint64_t>(time::duration_cast<time::nanoseconds>(tp.time_since_epoch()).count());
+}
+
+namespace stats_shm {
+
+std::optional<Snapshot>
+readSnapshot(const void* segment, size_t mappedSize, int maxRetries)
+{
+  if (segment == nullptr || mappedSize < sizeof(Header)) {
+    return std::nullopt;
+  }
+
+  const auto* header = static_cast<const Header*>(segment);
+  const auto* records = reinterpret_cast<const FaceRecord*>(header + 1);
+
+  for (int i = 0; i <= maxRetries; ++i) {
+    uint64_t seq1 = header->sequence.load(std::memory_order_acquire);
+    if (seq1 % 2 != 0) {
+      continue;
+    }
+
+    if (header->magic != MAGIC || header->version != VERSION ||
+        header->segmentSize > mappedSize) {
+      return std::nullopt;
+    }
+
+    Snapshot snapshot;
+    std::memcpy(&snapshot.forwarder, &header->forwarder, sizeof(ForwarderRecord));
+    auto nFaces = std::min<uint64_t>(header->nFaces, header->faceCapacity);
+    if (computeSegmentSize(nFaces) > mappedSize) {
+      continue;
+    }
+    snapshot.faces.resize(nFaces);
+    std::memcpy(snapshot.faces.data(), records, nFaces * sizeof(FaceRecord));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t seq2 = header->sequence.load(std::memory_order_relaxed);
+    if (seq1 == seq2) {
+      return snapshot;
+    }
+  }
+
+  return std::nullopt;
+}
+
+} // namespace stats_shm
+
+StatsShmExporter::StatsShmExporter(Forwarder& forwarder, const FaceTable& faceTable)
+  : m_forwarder(forwarder)
+  , m_faceTable(faceTable)
+  , m_startTimestamp(time::system_clock::now())
+  , m_interval(DEFAULT_INTERVAL)
+{
+}
+
+StatsShmExporter::~StatsShmExporter()
+{
+  disable();
+}
+
+void
+StatsShmExporter::setConfigFile(ConfigFile& configFile)
+{
+  configFile.addSectionHandler(CFG_STATS_EXPORT, [this] (auto&&... args) {
+    processConfig(std::forward<decltype(args)>(args)...);
+  });
+}
+
+void
+StatsShmExporter::processConfig(const ConfigSection& section, bool isDryRun, const std::string&)
+{
+  std::string shmName;
+  auto interval = DEFAULT_INTERVAL;
+
+  for (const auto& [key, value] : section) {
+    if (key == "shm_name") {
+      shmName = value.get_value<std::string>();
+      // POSIX requires a portable name to begin with a slash and contain no other slashes
+      if (shmName.size() < 2 || shmName.front() != '/' ||
+          shmName.find('/', 1) != std::string::npos) {
+        NDN_THROW(ConfigFile::Error("Invalid value for option 'shm_name' in section '" +
+                                    CFG_STATS_EXPORT + "'"));
+      }
+    }
+    else if (key == "interval") {
+      auto ms = ConfigFile::parseNumber<uint32_t>(value, key, CFG_STATS_EXPORT);
+      ConfigFile::checkRange<uint32_t>(ms, 10, 3600000, key, CFG_STATS_EXPORT);
+      interval = time::milliseconds(ms);
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_STATS_EXPORT + "." + key));
+    }
+  }
+
+  if (shmName.empty()) {
+    NDN_THROW(ConfigFile::Error("Missing option 'shm_name' in section '" + CFG_STATS_EXPORT + "'"));
+  }
+
+  if (isDryRun) {
+    return;
+  }
+
+  try {
+    enable(shmName, interval);
+  }
+  catch (const Error& e) {
+    NDN_THROW_NESTED(ConfigFile::Error(e.what()));
+  }
+}
+
+void
+StatsShmExporter::enable(const std::string& shmName, time::milliseconds interval)
+{
+  m_interval = interval;
+
+  if (shmName != m_shmName) {
+    disable();
+
+    int fd = ::shm_open(shmName.data(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+      NDN_THROW_ERRNO(Error("Cannot open shared memory object " + shmName));
+    }
+    m_fd = fd;
+    m_shmName = shmName;
+
+    try {
+      remap(std::max(INITIAL_FACE_CAPACITY, m_faceTable.size()));
+    }
+    catch (const Error&) {
+      disable();
+      throw;
+    }
+    NFD_LOG_INFO("Exporting statistics to shared memory object " << m_shmName);
+  }
+
+  update();
+  scheduleUpdate();
+}
+
+void
+StatsShmExporter::disable()
+{
+  m_updateEvent.cancel();
+
+  if (m_segment != nullptr) {
+    ::munmap(m_segment, m_segmentSize);
+    m_segment = nullptr;
+    m_segmentSize = 0;
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+  if (!m_shmName.empty()) {
+    ::shm_unlink(m_shmName.data());
+    m_shmName.clear();
+  }
+}
+
+void
+StatsShmExporter::remap(size_t faceCapacity)
+{
+  BOOST_ASSERT(m_fd >= 0);
+
+  // grow geometrically so that face churn does not cause frequent resizing
+  if (m_segment != nullptr) {
+    faceCapacity = std::max<size_t>(faceCapacity, 2 * getHeader()->faceCapacity);
+  }
+  size_t newSize = stats_shm::computeSegmentSize(faceCapacity);
+
+  if (::ftruncate(m_fd, static_cast<off_t>(newSize)) < 0) {
+    NDN_THROW_ERRNO(Error("Cannot resize shared memory object " + m_shmName));
+  }
+
+  void* segment = ::mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (segment == MAP_FAILED) {
+    NDN_THROW_ERRNO(Error("Cannot map shared memory object " + m_shmName));
+  }
+
+  if (m_segment != nullptr) {
+    ::munmap(m_segment, m_segmentSize);
+  }
+  else {
+    // the object may be left over from a previous instance that was interrupted mid-update
+    auto* header = static_cast<stats_shm::Header*>(segment);
+    uint64_t seq = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(seq + seq % 2, std::memory_order_relaxed);
+  }
+  m_segment = segment;
+  m_segmentSize = newSize;
+
+  auto* header = getHeader();
+  header->magic = stats_shm::MAGIC;
+  header->version = stats_shm::VERSION;
+  header->segmentSize = newSize;
+  header->faceCapacity = faceCapacity;
+}
+
+void
+StatsShmExporter::update()
+{
+  if (m_segment == nullptr) {
+    return;
+  }
+
+  uint64_t seq = getHeader()->sequence.load(std::memory_order_relaxed);
+  getHeader()->sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  if (m_faceTable.size() > getHeader()->faceCapacity) {
+    try {
+      // the sequence number is odd, so readers of the old mapping back off during the resize
+      remap(m_faceTable.size());
+    }
+    catch (const Error& e) {
+      NFD_LOG_ERROR(e.what() << ", disabling statistics export");
+      disable();
+      return;
+    }
+  }
+
+  auto* header = getHeader();
+  auto& fw = header->forwarder;
+  fw.startTimestamp = toNanoseconds(m_startTimestamp);
+  fw.updateTimestamp = toNanoseconds(time::system_clock::now());
+
+  fw.nNameTreeEntries = m_forwarder.getNameTree().size();
+  fw.nFibEntries = m_forwarder.getFib().size();
+  fw.nPitEntries = m_forwarder.getPit().size();
+  fw.nMeasurementsEntries = m_forwarder.getMeasurements().size();
+  fw.nCsEntries = m_forwarder.getCs().size();
+
+  const auto& counters = m_forwarder.getCounters();
+  fw.nInInterests = counters.nInInterests;
+  fw.nOutInterests = counters.nOutInterests;
+  fw.nInData = counters.nInData;
+  fw.nOutData = counters.nOutData;
+  fw.nInNacks = counters.nInNacks;
+  fw.nOutNacks = counters.nOutNacks;
+  fw.nSatisfiedInterests = counters.nSatisfiedInterests;
+  fw.nUnsatisfiedInterests = counters.nUnsatisfiedInterests;
+  fw.nUnsolicitedData = counters.nUnsolicitedData;
+  fw.nCsHits = counters.nCsHits;
+  fw.nCsMisses = counters.nCsMisses;
+  const auto& digestCounters = m_forwarder.getCs().getDigestCounters();
+  fw.nCsDigestRequests = digestCounters.nRequests;
+  fw.nCsDigestComputations = digestCounters.nComputations;
+
+  auto* record = reinterpret_cast<stats_shm::FaceRecord*>(header + 1);
+  for (const Face& face : m_faceTable) {
+    const auto& fc = face.getCounters();
+    record->faceId = face.getId();
+    record->nInInterests = fc.nInInterests;
+    record->nOutInterests = fc.nOutInterests;
+    record->nInterestsExceededRetx = fc.nInterestsExceededRetx;
+    record->nInData = fc.nInData;
+    record->nOutData = fc.nOutData;
+    record->nInNacks = fc.nInNacks;
+    record->nOutNacks = fc.nOutNacks;
+    record->nInPackets = fc.nInPackets;
+    record->nOutPackets = fc.nOutPackets;
+    record->nInBytes = fc.nInBytes;
+    record->nOutBytes = fc.nOutBytes;
+    record->nInHopLimitZero = fc.nInHopLimitZero;
+    record->nOutHopLimitZero = fc.nOutHopLimitZero;
+    ++record;
+  }
+  header->nFaces = m_faceTable.size();
+
+  header->sequence.store(seq + 2, std::memory_order_release);
+}
+
+void
+StatsShmExporter::scheduleUpdate()
+{
+  m_updateEvent = getScheduler().schedule(m_interval, [this] {
+    update();
+    if (isEnabled()) {
+      scheduleUpdate();
+    }
+  });
+}
+
+} // namespace nfd
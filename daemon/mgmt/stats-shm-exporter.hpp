@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_MGMT_STATS_SHM_EXPORTER_HPP
+#define NFD_DAEMON_MGMT_STATS_SHM_EXPORTER_HPP
+
+#include "common/config-file.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <atomic>
+
+namespace nfd {
+
+class FaceTable;
+class Forwarder;
+
+/**
+ * \brief Layout of the shared memory statistics segment.
+ *
+ * The segment starts with a Header, followed by Header::faceCapacity FaceRecord slots,
+ * of which the first Header::nFaces are valid. All integers are in host byte order.
+ *
+ * The segment is protected by a sequence lock: the writer makes Header::sequence odd
+ * before modifying the segment and even again afterwards. A reader must load the sequence
+ * number, copy the fields it needs, and retry if the sequence number was odd or has changed
+ * in the meantime. readSnapshot() implements this protocol.
+ *
+ * The segment may grow when the number of faces exceeds the current capacity.
+ * A reader whose mapping is smaller than Header::segmentSize must remap the segment.
+ */
+namespace stats_shm {
+
+/// Value of Header::magic, "NFDS" in little-endian byte order.
+inline constexpr uint32_t MAGIC = 0x5344464E;
+/// Value of Header::version; incremented on every incompatible layout change.
+inline constexpr uint32_t VERSION = 2;
+
+/**
+ * \brief Forwarder-wide counters and table sizes.
+ */
+struct ForwarderRecord
+{
+  uint64_t startTimestamp;  ///< NFD start time, in nanoseconds since the Unix epoch
+  uint64_t updateTimestamp; ///< time of last update, in nanoseconds since the Unix epoch
+
+  uint64_t nNameTreeEntries;
+  uint64_t nFibEntries;
+  uint64_t nPitEntries;
+  uint64_t nMeasurementsEntries;
+  uint64_t nCsEntries;
+
+  uint64_t nInInterests;
+  uint64_t nOutInterests;
+  uint64_t nInData;
+  uint64_t nOutData;
+  uint64_t nInNacks;
+  uint64_t nOutNacks;
+  uint64_t nSatisfiedInterests;
+  uint64_t nUnsatisfiedInterests;
+  uint64_t nUnsolicitedData;
+  uint64_t nCsHits;
+  uint64_t nCsMisses;
+  uint64_t nCsDigestRequests;     ///< implicit digests needed by the ContentStore
+  uint64_t nCsDigestComputations; ///< implicit digests computed by the ContentStore
+};
+
+/**
+ * \brief Per-face counters.
+ */
+struct FaceRecord
+{
+  uint64_t faceId;
+
+  uint64_t nInInterests;
+  uint64_t nOutInterests;
+  uint64_t nInterestsExceededRetx;
+  uint64_t nInData;
+  uint64_t nOutData;
+  uint64_t nInNacks;
+  uint64_t nOutNacks;
+  uint64_t nInPackets;
+  uint64_t nOutPackets;
+  uint64_t nInBytes;
+  uint64_t nOutBytes;
+  uint64_t nInHopLimitZero;
+  uint64_t nOutHopLimitZero;
+};
+
+struct Header
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t segmentSize;             ///< total size of the segment in bytes
+  std::atomic<uint64_t> sequence;   ///< sequence lock, odd while an update is in progress
+  ForwarderRecord forwarder;
+  uint64_t faceCapacity;            ///< number of FaceRecord slots following the header
+  uint64_t nFaces;                  ///< number of valid FaceRecord slots
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t));
+static_assert(sizeof(Header) % alignof(FaceRecord) == 0);
+
+/**
+ * \brief Return the size in bytes of a segment holding \p faceCapacity face records.
+ */
+constexpr size_t
+computeSegmentSize(size_t faceCapacity) noexcept
+{
+  return sizeof(Header) + faceCapacity * sizeof(FaceRecord);
+}
+
+/**
+ * \brief A consistent copy of the segment contents.
+ */
+struct Snapshot
+{
+  ForwarderRecord forwarder;
+  std::vector<FaceRecord> faces;
+};
+
+/**
+ * \brief Copy a consistent snapshot out of a mapped statistics segment.
+ * \param segment start of the mapping
+ * \param mappedSize size of the mapping in bytes
+ * \param maxRetries how many times to retry if a concurrent update is detected
+ * \return the snapshot, or nullopt if the segment is invalid, has grown beyond
+ *         \p mappedSize (caller should remap it), or no consistent copy could be obtained
+ */
+std::optional<Snapshot>
+readSnapshot(const void* segment, size_t mappedSize, int maxRetries = 100);
+
+} // namespace stats_shm
+
+/**
+ * \brief Exports forwarder and face counters through a read-only POSIX shared memory segment.
+ *
+ * External monitors can `shm_open` and `mmap` the segment to collect statistics without
+ * issuing management Interests, which saves signing and forwarding work in NFD.
+ * The segment is refreshed periodically from the forwarding thread; the hot path only
+ * increments the regular counters and is not affected.
+ *
+ * This class handles the `stats_export` configuration file section:
+ * \code{.unparsed}
+ * stats_export
+ * {
+ *   shm_name /nfd-stats ; name of the POSIX shared memory object
+ *   interval 1000       ; update interval in milliseconds
+ * }
+ * \endcode
+ *
+ * Export is disabled if the section is omitted. During a configuration reload, the export
+ * is re-enabled with the new settings if the section is present and left unchanged otherwise.
+ */
+class StatsShmExporter : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  StatsShmExporter(Forwarder& forwarder, const FaceTable& faceTable);
+
+  ~StatsShmExporter();
+
+  void
+  setConfigFile(ConfigFile& configFile);
+
+  /**
+   * \brief Create (or reuse) the shared memory object \p shmName and start periodic updates.
+   * \throw Error the shared memory object cannot be created or mapped
+   */
+  void
+  enable(const std::string& shmName, time::milliseconds interval);
+
+  /**
+   * \brief Stop updates, unmap and unlink the shared memory object.
+   */
+  void
+  disable();
+
+  bool
+  isEnabled() const noexcept
+  {
+    return m_segment != nullptr;
+  }
+
+  const std::string&
+  getShmName() const noexcept
+  {
+    return m_shmName;
+  }
+
+  /**
+   * \brief Write the current counters into the segment.
+   */
+  void
+  update();
+
+private:
+  void
+  processConfig(const ConfigSection& section, bool isDryRun, const std::string& filename);
+
+  void
+  remap(size_t faceCapacity);
+
+  void
+  scheduleUpdate();
+
+  stats_shm::Header*
+  getHeader() const noexcept
+  {
+    return static_cast<stats_shm::Header*>(m_segment);
+  }
+
+private:
+  Forwarder& m_forwarder;
+  const FaceTable& m_faceTable;
+  const time::system_clock::time_point m_startTimestamp;
+
+  std::string m_shmName;
+  time::milliseconds m_interval;
+  int m_fd = -1;
+  void* m_segment = nullptr;
+  size_t m_segmentSize = 0;
+  ndn::scheduler::ScopedEventId m_updateEvent;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_MGMT_STATS_SHM_EXPORTER_HPP
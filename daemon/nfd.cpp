@@ -38,6 +38,7 @@
 #include "mgmt/forwarder-status-manager.hpp"
 #include "mgmt/general-config-section.hpp"
 #include "mgmt/log-config-section.hpp"
+#include "mgmt/stats-shm-exporter.hpp"
 #include "mgmt/strategy-choice-manager.hpp"
 #include "mgmt/tables-config-section.hpp"
 
@@ -146,6 +147,7 @@ Nfd::initializeManagement()
                                        *m_dispatcher, *m_authenticator);
   m_strategyChoiceManager = make_unique<StrategyChoiceManager>(m_forwarder->getStrategyChoice(),
                                                                *m_dispatcher, *m_authenticator);
+  m_statsExporter = make_unique<StatsShmExporter>(*m_forwarder, *m_faceTable);
 
   ConfigFile config(&ignoreRibAndLogSections);
   general::setConfigFile(config);
@@ -157,6 +159,7 @@ Nfd::initializeManagement()
 
   m_authenticator->setConfigFile(config);
   m_faceSystem->setConfigFile(config);
+  m_statsExporter->setConfigFile(config);
 
   // parse config file
   if (!m_configFile.empty()) {
@@ -192,6 +195,7 @@ Nfd::reloadConfigFile()
 
   m_authenticator->setConfigFile(config);
   m_faceSystem->setConfigFile(config);
+  m_statsExporter->setConfigFile(config);
 
   if (!m_configFile.empty()) {
     config.parse(m_configFile, false);
@@ -45,6 +45,7 @@ class FaceManager;
 class FibManager;
 class CsManager;
 class StrategyChoiceManager;
+class StatsShmExporter;
 
 namespace face {
 class Face;
@@ -94,6 +95,16 @@ public:
   void
   reloadConfigFile();
 
+  /**
+   * \brief Returns the FIB manager.
+   * \pre initialize() has been called
+   */
+  FibManager&
+  getFibManager() const noexcept
+  {
+    return *m_fibManager;
+  }
+
 private:
   explicit
   Nfd(ndn::KeyChain& keyChain);
@@ -125,6 +136,7 @@ private:
   unique_ptr<FibManager> m_fibManager;
   unique_ptr<CsManager> m_csManager;
   unique_ptr<StrategyChoiceManager> m_strategyChoiceManager;
+  unique_ptr<StatsShmExporter> m_statsExporter;
 
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
   ndn::scheduler::ScopedEventId m_reloadConfigEvent;
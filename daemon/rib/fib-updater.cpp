@@ -59,6 +59,8 @@ FibUpdater::computeAndSendFibUpdates(const RibUpdateBatch& batch,
   m_updatesForNonBatchFaceId.clear();
 
   computeUpdates(batch);
+  // the index is only needed while computing; sending modifies the lists
+  m_updateIndex.clear();
 
   sendUpdatesForBatchFaceId(onSuccess, onFailure);
 }
@@ -82,6 +84,9 @@ FibUpdater::computeUpdates(const RibUpdateBatch& batch)
 
         // Do not apply updates with the same face ID as the destroyed face
         // since they will be rejected by the FIB
+        for (const FibUpdate& batchUpdate : m_updatesForBatchFaceId) {
+          m_updateIndex.erase({batchUpdate.name, batchUpdate.faceId});
+        }
         m_updatesForBatchFaceId.clear();
         break;
     }
@@ -188,6 +193,13 @@ FibUpdater::sendUpdates(const FibUpdateList& updates,
 {
   NFD_LOG_DEBUG("Applying " << updates.size() << " FIB update(s)");
 
+  if (m_directUpdate) {
+    m_directUpdate(updates, [=, updates = updates] (const auto& responses) {
+      onDirectUpdatesApplied(updates, responses, onSuccess, onFailure);
+    });
+    return;
+  }
+
   for (const FibUpdate& update : updates) {
     NFD_LOG_DEBUG("Sending " << update);
 
@@ -259,14 +271,14 @@ FibUpdater::onUpdateSuccess(const FibUpdate& update,
                             const FibUpdateFailureCallback& onFailure)
 {
   if (update.faceId == m_batchFaceId) {
-    m_updatesForBatchFaceId.remove(update);
+    eraseFibUpdate(m_updatesForBatchFaceId, update);
 
     if (m_updatesForBatchFaceId.size() == 0) {
       sendUpdatesForNonBatchFaceId(onSuccess, onFailure);
     }
   }
   else {
-    m_updatesForNonBatchFaceId.remove(update);
+    eraseFibUpdate(m_updatesForNonBatchFaceId, update);
 
     if (m_updatesForNonBatchFaceId.size() == 0) {
       onSuccess(m_inheritedRoutes);
@@ -292,7 +304,7 @@ FibUpdater::onUpdateError(const FibUpdate& update,
       onFailure(code, response.getText());
     }
     else {
-      m_updatesForNonBatchFaceId.remove(update);
+      eraseFibUpdate(m_updatesForNonBatchFaceId, update);
 
       if (m_updatesForNonBatchFaceId.size() == 0) {
         onSuccess(m_inheritedRoutes);
@@ -304,25 +316,59 @@ FibUpdater::onUpdateError(const FibUpdate& update,
   }
 }
 
+void
+FibUpdater::onDirectUpdatesApplied(const FibUpdateList& updates,
+                                   const std::vector<ndn::nfd::ControlResponse>& responses,
+                                   const FibUpdateSuccessCallback& onSuccess,
+                                   const FibUpdateFailureCallback& onFailure)
+{
+  BOOST_ASSERT(responses.size() == updates.size());
+
+  auto update = updates.begin();
+  for (const auto& response : responses) {
+    if (response.getCode() == 200) {
+      onUpdateSuccess(*update, onSuccess, onFailure);
+    }
+    else {
+      // direct updates cannot time out, so the error is never retried
+      onUpdateError(*update, onSuccess, onFailure, response, MAX_NUM_TIMEOUTS);
+      if (update->faceId == m_batchFaceId) {
+        // the whole batch has failed
+        return;
+      }
+    }
+    ++update;
+  }
+}
+
+void
+FibUpdater::eraseFibUpdate(FibUpdateList& updates, const FibUpdate& update)
+{
+  // updates are unique, and responses mostly arrive in the order the updates were sent,
+  // so the search usually ends at the first element
+  auto it = std::find(updates.begin(), updates.end(), update);
+  if (it != updates.end()) {
+    updates.erase(it);
+  }
+}
+
 void
 FibUpdater::addFibUpdate(const FibUpdate& update)
 {
   FibUpdateList& updates = (update.faceId == m_batchFaceId) ? m_updatesForBatchFaceId :
                                                               m_updatesForNonBatchFaceId;
 
-  // If an update with the same name and route already exists, replace it
-  auto it = std::find_if(updates.begin(), updates.end(),
-    [&update] (const FibUpdate& other) {
-      return update.name == other.name && update.faceId == other.faceId;
-    });
-
-  if (it != updates.end()) {
-    FibUpdate& existingUpdate = *it;
-    existingUpdate.action = update.action;
-    existingUpdate.cost = update.cost;
+  // If an update with the same name and route already exists, replace it.
+  // The index avoids a linear search, which would make computing the updates for a route
+  // that is inherited by many descendants quadratic in the number of descendants.
+  auto [indexIt, isNew] = m_updateIndex.try_emplace({update.name, update.faceId});
+  if (isNew) {
+    indexIt->second = updates.insert(updates.end(), update);
   }
   else {
-    updates.push_back(update);
+    FibUpdate& existingUpdate = *indexIt->second;
+    existingUpdate.action = update.action;
+    existingUpdate.cost = update.cost;
   }
 }
 
@@ -51,6 +51,16 @@ public:
   using FibUpdateSuccessCallback = std::function<void(RibUpdateList inheritedRoutes)>;
   using FibUpdateFailureCallback = std::function<void(uint32_t code, const std::string& error)>;
 
+  /**
+   * \brief Asynchronously applies a list of FIB updates in the forwarder.
+   *
+   * The function must eventually invoke the continuation on the RIB thread, passing one
+   * response per update in the same order as \p updates. Processing may stop after a failed
+   * update, in which case fewer responses are returned.
+   */
+  using DirectUpdateFunc = std::function<void(const FibUpdateList& updates,
+                                              std::function<void(std::vector<ndn::nfd::ControlResponse>)>)>;
+
   FibUpdater(Rib& rib, ndn::nfd::Controller& controller);
 
 #ifdef NFD_WITH_TESTS
@@ -69,6 +79,18 @@ public:
                            const FibUpdateSuccessCallback& onSuccess,
                            const FibUpdateFailureCallback& onFailure);
 
+  /** \brief Apply FIB updates through \p func instead of sending FIB management commands.
+   *
+   *  When the RIB service runs in the same process as the forwarder, this avoids signing,
+   *  dispatching, and validating one command per next hop change: all updates of a batch
+   *  are applied in a single step. Passing nullptr reverts to management commands.
+   */
+  void
+  setDirectUpdateFunc(DirectUpdateFunc func)
+  {
+    m_directUpdate = std::move(func);
+  }
+
 private:
   /**
    * \brief Determines the type of action that will be performed on the RIB and calls the
@@ -183,6 +205,15 @@ NFD_PROTECTED_WITH_TESTS_ELSE_PRIVATE:
                 const FibUpdateFailureCallback& onFailure,
                 const ndn::nfd::ControlResponse& response, uint32_t nTimeouts);
 
+  /**
+   * \brief Processes the responses of updates applied through the direct update function.
+   */
+  void
+  onDirectUpdatesApplied(const FibUpdateList& updates,
+                         const std::vector<ndn::nfd::ControlResponse>& responses,
+                         const FibUpdateSuccessCallback& onSuccess,
+                         const FibUpdateFailureCallback& onFailure);
+
 private:
   /**
    * \brief Adds the update to an update list based on its Face ID.
@@ -195,6 +226,12 @@ private:
   void
   addFibUpdate(const FibUpdate& update);
 
+  /**
+   * \brief Removes an acknowledged update from \p updates.
+   */
+  static void
+  eraseFibUpdate(FibUpdateList& updates, const FibUpdate& update);
+
   /**
    * \brief Creates records of the passed routes added to the entry and creates FIB updates.
    */
@@ -277,7 +314,10 @@ private:
 private:
   const Rib& m_rib;
   ndn::nfd::Controller& m_controller;
+  DirectUpdateFunc m_directUpdate;
   uint64_t m_batchFaceId;
+  /// (name, FaceId) => update in one of the update lists, used while computing updates
+  std::map<std::pair<Name, uint64_t>, FibUpdateList::iterator> m_updateIndex;
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   FibUpdateList m_updatesForBatchFaceId;
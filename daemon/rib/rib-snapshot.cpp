@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rib-snapshot.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+#include <iterator>
+
+namespace nfd::rib::snapshot {
+
+// TLV-TYPE numbers are local to the snapshot file
+enum : uint32_t {
+  RibSnapshot    = 128,
+  RouteRecord    = 129,
+  RemoteUri      = 130,
+  LocalUri       = 131,
+  Origin         = 132,
+  Cost           = 133,
+  Flags          = 134,
+  ExpirationTime = 135,
+};
+
+std::ostream&
+operator<<(std::ostream& os, const Record& record)
+{
+  os << "Record(" << record.name << ", remote=" << record.remoteUri
+     << ", local=" << record.localUri << ", origin=" << record.origin
+     << ", cost=" << record.cost << ", flags=" << record.flags;
+  if (record.expires) {
+    os << ", expires=" << time::toIsoString(*record.expires);
+  }
+  return os << ")";
+}
+
+template<ndn::encoding::Tag TAG>
+static size_t
+encodeRecord(ndn::EncodingImpl<TAG>& encoder, const Record& record)
+{
+  size_t totalLength = 0;
+  if (record.expires) {
+    auto timestamp = time::toUnixTimestamp(*record.expires).count();
+    totalLength += ndn::encoding::prependNonNegativeIntegerBlock(encoder, ExpirationTime, timestamp);
+  }
+  totalLength += ndn::encoding::prependNonNegativeIntegerBlock(encoder, Flags, record.flags);
+  totalLength += ndn::encoding::prependNonNegativeIntegerBlock(encoder, Cost, record.cost);
+  totalLength += ndn::encoding::prependNonNegativeIntegerBlock(encoder, Origin, record.origin);
+  totalLength += ndn::encoding::prependStringBlock(encoder, LocalUri, record.localUri);
+  totalLength += ndn::encoding::prependStringBlock(encoder, RemoteUri, record.remoteUri);
+  totalLength += record.name.wireEncode(encoder);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(RouteRecord);
+  return totalLength;
+}
+
+static Record
+decodeRecord(const Block& block)
+{
+  block.parse();
+  const auto& elements = block.elements();
+  if (elements.size() < 6 || elements.size() > 7 ||
+      elements[0].type() != tlv::Name || elements[1].type() != RemoteUri ||
+      elements[2].type() != LocalUri || elements[3].type() != Origin ||
+      elements[4].type() != Cost || elements[5].type() != Flags ||
+      (elements.size() == 7 && elements[6].type() != ExpirationTime)) {
+    NDN_THROW(Error("Malformed RouteRecord"));
+  }
+
+  Record record;
+  record.name.wireDecode(elements[0]);
+  record.remoteUri = ndn::encoding::readString(elements[1]);
+  record.localUri = ndn::encoding::readString(elements[2]);
+  record.origin = ndn::encoding::readNonNegativeIntegerAs<ndn::nfd::RouteOrigin>(elements[3]);
+  record.cost = ndn::encoding::readNonNegativeInteger(elements[4]);
+  record.flags = ndn::encoding::readNonNegativeInteger(elements[5]);
+  if (elements.size() == 7) {
+    auto timestamp = ndn::encoding::readNonNegativeInteger(elements[6]);
+    record.expires = time::fromUnixTimestamp(time::milliseconds(timestamp));
+  }
+  return record;
+}
+
+Block
+encode(const std::vector<Record>& records)
+{
+  ndn::EncodingBuffer encoder;
+  size_t totalLength = 0;
+  for (auto it = records.rbegin(); it != records.rend(); ++it) {
+    totalLength += encodeRecord(encoder, *it);
+  }
+  encoder.prependVarNumber(totalLength);
+  encoder.prependVarNumber(RibSnapshot);
+  return encoder.block();
+}
+
+std::vector<Record>
+decode(const Block& block)
+{
+  if (block.type() != RibSnapshot) {
+    NDN_THROW(Error("Expecting RibSnapshot, got TLV-TYPE " + std::to_string(block.type())));
+  }
+
+  std::vector<Record> records;
+  try {
+    block.parse();
+    records.reserve(block.elements().size());
+    for (const auto& element : block.elements()) {
+      if (element.type() != RouteRecord) {
+        NDN_THROW(Error("Unexpected TLV-TYPE " + std::to_string(element.type()) + " in RibSnapshot"));
+      }
+      records.push_back(decodeRecord(element));
+    }
+  }
+  catch (const tlv::Error& e) {
+    NDN_THROW_NESTED(Error("Malformed RibSnapshot: "s + e.what()));
+  }
+  return records;
+}
+
+void
+save(const std::string& path, const std::vector<Record>& records)
+{
+  Block block = encode(records);
+  std::string tmpPath = path + ".tmp";
+
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+    file.close();
+    if (!file) {
+      NDN_THROW(Error("Cannot write " + tmpPath));
+    }
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    NDN_THROW(Error("Cannot rename " + tmpPath + " to " + path + ": " + ec.message()));
+  }
+}
+
+std::vector<Record>
+load(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    NDN_THROW(Error("Cannot open " + path));
+  }
+
+  auto buffer = make_shared<ndn::Buffer>(std::istreambuf_iterator<char>(file),
+                                         std::istreambuf_iterator<char>());
+  if (file.bad()) {
+    NDN_THROW(Error("Cannot read " + path));
+  }
+
+  try {
+    return decode(Block(std::move(buffer)));
+  }
+  catch (const tlv::Error& e) {
+    NDN_THROW_NESTED(Error("Malformed RIB snapshot " + path + ": " + e.what()));
+  }
+}
+
+} // namespace nfd::rib::snapshot
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_RIB_RIB_SNAPSHOT_HPP
+#define NFD_DAEMON_RIB_RIB_SNAPSHOT_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/encoding/nfd-constants.hpp>
+
+/**
+ * \brief Persistent snapshot of the RIB, used to restore routes after a restart.
+ *
+ * FaceIds are not preserved across restarts, so each route identifies its nexthop by the
+ * remote and local URIs of the face. The snapshot is a single TLV block:
+ * \code{.unparsed}
+ * RibSnapshot = RIB-SNAPSHOT-TYPE TLV-LENGTH
+ *                 *RouteRecord
+ * RouteRecord = ROUTE-RECORD-TYPE TLV-LENGTH
+ *                 Name
+ *                 RemoteUri
+ *                 LocalUri
+ *                 Origin
+ *                 Cost
+ *                 Flags
+ *                 [ExpirationTime] ; milliseconds since the Unix epoch
+ * \endcode
+ */
+namespace nfd::rib::snapshot {
+
+class Error : public std::runtime_error
+{
+public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * \brief A route in a RIB snapshot.
+ */
+struct Record
+{
+  Name name;
+  std::string remoteUri;
+  std::string localUri;
+  ndn::nfd::RouteOrigin origin = ndn::nfd::ROUTE_ORIGIN_APP;
+  uint64_t cost = 0;
+  uint64_t flags = 0;
+  std::optional<time::system_clock::time_point> expires;
+
+  friend bool
+  operator==(const Record& lhs, const Record& rhs)
+  {
+    return lhs.name == rhs.name &&
+           lhs.remoteUri == rhs.remoteUri &&
+           lhs.localUri == rhs.localUri &&
+           lhs.origin == rhs.origin &&
+           lhs.cost == rhs.cost &&
+           lhs.flags == rhs.flags &&
+           lhs.expires == rhs.expires;
+  }
+};
+
+std::ostream&
+operator<<(std::ostream& os, const Record& record);
+
+/**
+ * \brief Encode \p records into a snapshot block.
+ */
+Block
+encode(const std::vector<Record>& records);
+
+/**
+ * \brief Decode a snapshot block.
+ * \throw Error the block is not a valid snapshot
+ */
+std::vector<Record>
+decode(const Block& block);
+
+/**
+ * \brief Write \p records to the file at \p path.
+ *
+ * The snapshot is first written to a temporary file, which then replaces \p path,
+ * so that an interrupted write does not leave a truncated snapshot behind.
+ * \throw Error the file cannot be written
+ */
+void
+save(const std::string& path, const std::vector<Record>& records);
+
+/**
+ * \brief Read the snapshot stored at \p path.
+ * \throw Error the file cannot be read or does not contain a valid snapshot
+ */
+std::vector<Record>
+load(const std::string& path);
+
+} // namespace nfd::rib::snapshot
+
+#endif // NFD_DAEMON_RIB_RIB_SNAPSHOT_HPP
@@ -237,10 +237,9 @@ Rib::findDescendantsForNonInsertedName(const Name& prefix) const
 {
   std::list<shared_ptr<RibEntry>> children;
 
-  for (const auto& [name, ribEntry] : m_rib) {
-    if (prefix.isPrefixOf(name)) {
-      children.push_back(ribEntry);
-    }
+  // all names under prefix are contiguous in the table, starting at prefix itself
+  for (auto it = m_rib.lower_bound(prefix); it != m_rib.end() && prefix.isPrefixOf(it->first); ++it) {
+    children.push_back(it->second);
   }
 
   return children;
@@ -341,6 +340,17 @@ Rib::beginApplyUpdate(const RibUpdate& update,
   sendBatchFromQueue();
 }
 
+void
+Rib::beginApplyBatch(const RibUpdateBatch& batch,
+                     const Rib::UpdateSuccessCallback& onSuccess,
+                     const Rib::UpdateFailureCallback& onFailure)
+{
+  BOOST_ASSERT(m_fibUpdater != nullptr);
+  BOOST_ASSERT(batch.size() > 0);
+  m_updateBatches.push_back({batch, onSuccess, onFailure});
+  sendBatchFromQueue();
+}
+
 void
 Rib::beginRemoveFace(uint64_t faceId)
 {
@@ -403,8 +413,9 @@ Rib::sendBatchFromQueue()
   UpdateQueueItem item = std::move(m_updateBatches.front());
   m_updateBatches.pop_front();
 
-  // Until task #1698, each RibUpdateBatch contains exactly one RIB update
-  BOOST_ASSERT(item.batch.size() == 1);
+  // Until task #1698, a RibUpdateBatch contains several RIB updates only if they are
+  // independent of each other (see beginApplyBatch)
+  BOOST_ASSERT(item.batch.size() >= 1);
 
   m_fibUpdater->computeAndSendFibUpdates(item.batch,
     [this, batch = item.batch, successCb = item.managerSuccessCallback] (const auto& routes) {
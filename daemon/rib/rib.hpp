@@ -85,6 +85,15 @@ public:
   Route*
   findLongestPrefix(const Name& prefix, const Route& route) const;
 
+  /** \brief Returns an iterator to the first entry whose name follows \p prefix
+   *         in canonical order.
+   */
+  const_iterator
+  upper_bound(const Name& prefix) const
+  {
+    return m_rib.upper_bound(prefix);
+  }
+
   const_iterator
   begin() const
   {
@@ -129,6 +138,18 @@ public:
                    const UpdateSuccessCallback& onSuccess,
                    const UpdateFailureCallback& onFailure);
 
+  /** \brief Passes a RibUpdateBatch with several updates to FibUpdater.
+   *
+   *  FibUpdater computes the FIB updates of a batch from the RIB state before the batch,
+   *  so the updates in \p batch must not depend on each other.
+   *  \pre \p batch only contains REGISTER updates, and none of their names is a prefix of
+   *       (or equal to) another name in \p batch
+   */
+  void
+  beginApplyBatch(const RibUpdateBatch& batch,
+                  const UpdateSuccessCallback& onSuccess,
+                  const UpdateFailureCallback& onFailure);
+
   /** \brief Starts the FIB update process when a face has been destroyed.
    */
   void
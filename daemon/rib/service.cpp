@@ -48,9 +48,11 @@ const std::string CFG_LOCALHOP_SECURITY = "localhop_security";
 const std::string CFG_PA_VALIDATION = "prefix_announcement_validation";
 const std::string CFG_PREFIX_PROPAGATE = "auto_prefix_propagate";
 const std::string CFG_READVERTISE_NLSR = "readvertise_nlsr";
+const std::string CFG_SNAPSHOT = "snapshot";
 const Name READVERTISE_NLSR_PREFIX = "/localhost/nlsr";
 constexpr uint64_t PROPAGATE_DEFAULT_COST = 15;
 constexpr time::milliseconds PROPAGATE_DEFAULT_TIMEOUT = 10_s;
+constexpr time::seconds SNAPSHOT_DEFAULT_INTERVAL = 5_min;
 
 static ConfigSection
 loadConfigSectionFromFile(const std::string& filename)
@@ -85,6 +87,31 @@ makeLocalNfdTransport(const ConfigSection& config)
   }
 }
 
+static std::pair<std::string, time::seconds>
+parseSnapshotConfig(const ConfigSection& section)
+{
+  const std::string sectionName = CFG_RIB + "." + CFG_SNAPSHOT;
+  std::string path;
+  time::seconds interval = SNAPSHOT_DEFAULT_INTERVAL;
+
+  for (const auto& [key, value] : section) {
+    if (key == "path") {
+      path = value.get_value<std::string>();
+    }
+    else if (key == "interval") {
+      interval = time::seconds(ConfigFile::parseNumber<uint32_t>(value, key, sectionName));
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unrecognized option " + sectionName + "." + key));
+    }
+  }
+
+  if (path.empty()) {
+    NDN_THROW(ConfigFile::Error("Missing option 'path' in section '" + sectionName + "'"));
+  }
+  return {path, interval};
+}
+
 Service::Service(const std::string& configFile, ndn::KeyChain& keyChain)
   : Service(keyChain, makeLocalNfdTransport(loadConfigSectionFromFile(configFile)),
             [&configFile] (ConfigFile& config, bool isDryRun) {
@@ -132,6 +159,9 @@ Service::Service(ndn::KeyChain& keyChain, shared_ptr<ndn::Transport> localNfdTra
 
 Service::~Service()
 {
+  if (!m_snapshotPath.empty()) {
+    saveSnapshot();
+  }
   s_instance = nullptr;
 }
 
@@ -183,6 +213,9 @@ Service::checkConfig(const ConfigSection& section, const std::string& filename)
     else if (key == CFG_READVERTISE_NLSR) {
       ConfigFile::parseYesNo(item, CFG_RIB + "." + CFG_READVERTISE_NLSR);
     }
+    else if (key == CFG_SNAPSHOT) {
+      parseSnapshotConfig(value);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_RIB + "." + key));
     }
@@ -199,6 +232,7 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
 {
   bool wantPrefixPropagate = false;
   bool wantReadvertiseNlsr = false;
+  bool wantSnapshot = false;
 
   for (const auto& item : section) {
     const std::string& key = item.first;
@@ -237,6 +271,22 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
     else if (key == CFG_READVERTISE_NLSR) {
       wantReadvertiseNlsr = ConfigFile::parseYesNo(item, CFG_RIB + "." + CFG_READVERTISE_NLSR);
     }
+    else if (key == CFG_SNAPSHOT) {
+      wantSnapshot = true;
+      bool isFirstSnapshotConfig = m_snapshotPath.empty();
+      std::tie(m_snapshotPath, m_snapshotInterval) = parseSnapshotConfig(value);
+
+      if (isFirstSnapshotConfig) {
+        try {
+          m_ribManager.restoreSnapshot(m_snapshotPath);
+        }
+        catch (const snapshot::Error& e) {
+          // a missing snapshot is normal on the first start
+          NFD_LOG_WARN("Cannot restore RIB snapshot: " << e.what());
+        }
+      }
+      scheduleSnapshot();
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_RIB + "." + key));
     }
@@ -259,6 +309,37 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
     NFD_LOG_DEBUG("Disabling readvertise-to-nlsr");
     m_readvertiseNlsr.reset();
   }
+
+  if (!wantSnapshot && !m_snapshotPath.empty()) {
+    NFD_LOG_DEBUG("Disabling RIB snapshot");
+    m_snapshotPath.clear();
+    m_snapshotEvent.cancel();
+  }
+}
+
+void
+Service::scheduleSnapshot()
+{
+  if (m_snapshotInterval == 0_s) {
+    m_snapshotEvent.cancel();
+    return;
+  }
+
+  m_snapshotEvent = getScheduler().schedule(m_snapshotInterval, [this] {
+    saveSnapshot();
+    scheduleSnapshot();
+  });
+}
+
+void
+Service::saveSnapshot()
+{
+  try {
+    m_ribManager.saveSnapshot(m_snapshotPath);
+  }
+  catch (const snapshot::Error& e) {
+    NFD_LOG_ERROR("Cannot save RIB snapshot: " << e.what());
+  }
 }
 
 } // namespace nfd::rib
@@ -88,6 +88,12 @@ public:
     return m_ribManager;
   }
 
+  FibUpdater&
+  getFibUpdater() noexcept
+  {
+    return m_fibUpdater;
+  }
+
 private:
   template<typename ConfigParseFunc>
   Service(ndn::KeyChain& keyChain, shared_ptr<ndn::Transport> localNfdTransport,
@@ -102,6 +108,12 @@ private:
   void
   applyConfig(const ConfigSection& section, const std::string& filename);
 
+  void
+  scheduleSnapshot();
+
+  void
+  saveSnapshot();
+
 private:
   static inline Service* s_instance = nullptr;
 
@@ -115,6 +127,10 @@ private:
   unique_ptr<Readvertise> m_readvertisePropagation;
   ndn::mgmt::Dispatcher m_dispatcher;
   RibManager m_ribManager;
+
+  std::string m_snapshotPath;
+  time::seconds m_snapshotInterval = 0_s;
+  ndn::scheduler::ScopedEventId m_snapshotEvent;
 };
 
 } // namespace nfd::rib
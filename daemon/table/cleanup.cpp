@@ -25,39 +25,21 @@
 
 #include "cleanup.hpp"
 
-#include <map>
-
 namespace nfd {
 
 void
 cleanupOnFaceRemoval(NameTree& nt, Fib& fib, Pit& pit, const Face& face)
 {
-  std::multimap<size_t, const name_tree::Entry*> maybeEmptyNtes;
-
-  // visit FIB and PIT entries in one pass of NameTree enumeration
-  for (const name_tree::Entry& nte : nt) {
-    fib::Entry* fibEntry = nte.getFibEntry();
-    if (fibEntry != nullptr) {
-      fib.removeNextHop(*fibEntry, face);
+  pit.deleteInOutRecords(face);
+
+  for (fib::Entry* fibEntry : fib.findEntriesWithNextHop(face)) {
+    name_tree::Entry* nte = nt.getEntry(*fibEntry);
+    if (fib.removeNextHop(*fibEntry, face) == Fib::RemoveNextHopResult::FIB_ENTRY_REMOVED) {
+      // this cannot erase the NameTree entry of another FIB entry in the list,
+      // because an entry with a FIB entry is never empty
+      nt.eraseIfEmpty(nte);
     }
-
-    for (const auto& pitEntry : nte.getPitEntries()) {
-      pit.deleteInOutRecords(pitEntry.get(), face);
-    }
-
-    if (!nte.hasTableEntries()) {
-      maybeEmptyNtes.emplace(nte.getName().size(), &nte);
-    }
-  }
-
-  // try to erase longer names first, so that children are erased before parent is checked
-  for (auto i = maybeEmptyNtes.rbegin(); i != maybeEmptyNtes.rend(); ++i) {
-    nt.eraseIfEmpty(const_cast<name_tree::Entry*>(i->second), false);
   }
-
-  BOOST_ASSERT(nt.size() == 0 ||
-               std::none_of(nt.begin(), nt.end(),
-                            [] (const name_tree::Entry& nte) { return nte.isEmpty(); }));
 }
 
 } // namespace nfd
@@ -34,15 +34,10 @@ namespace nfd {
 
 /** \brief Cleanup tables when a face is destroyed.
  *
- *  This function enumerates the NameTree, calls Fib::removeNextHop() for each FIB entry,
- *  calls Pit::deleteInOutRecords() for each PIT entry, and finally
- *  deletes any name tree entries that have become empty.
- *
- *  \note It's a design choice to let Fib and Pit classes decide what to do with each entry.
- *        This function is only responsible for implementing the enumeration procedure.
- *        The benefit of having this function instead of doing the enumeration in Fib and Pit
- *        classes is to perform both FIB and PIT cleanups in one pass of NameTree enumeration,
- *        so as to reduce performance overhead.
+ *  This function calls Pit::deleteInOutRecords() and Fib::removeNextHop() for the PIT and FIB
+ *  entries that refer to \p face, and deletes any name tree entries that have become empty.
+ *  The entries are found through the per-face indexes of Fib and Pit, so that the cost is
+ *  proportional to the number of entries that refer to \p face, not to the size of the tables.
  */
 void
 cleanupOnFaceRemoval(NameTree& nt, Fib& fib, Pit& pit, const Face& face);
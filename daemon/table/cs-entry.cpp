@@ -25,6 +25,10 @@
 
 #include "cs-entry.hpp"
 
+#include <ndn-cxx/util/sha256.hpp>
+
+#include <cstring>
+
 namespace nfd::cs {
 
 Entry::Entry(shared_ptr<const Data> data, bool isUnsolicited)
@@ -46,10 +50,52 @@ Entry::updateFreshUntil()
   m_freshUntil = time::steady_clock::now() + m_data->getFreshnessPeriod();
 }
 
+span<const uint8_t>
+Entry::getImplicitDigest(DigestCounters* counters) const
+{
+  if (counters != nullptr) {
+    ++counters->nRequests;
+  }
+  if (m_digest == nullptr) {
+    // OpenSSL selects a SHA extension or SIMD implementation of SHA-256 when the CPU has one
+    m_digest = ndn::util::Sha256::computeDigest(m_data->wireEncode());
+    if (counters != nullptr) {
+      ++counters->nComputations;
+    }
+  }
+  return *m_digest;
+}
+
+/** \brief Compare an ImplicitSha256DigestComponent with a digest.
+ */
+static int
+compareDigest(const name::Component& comp, span<const uint8_t> digest)
+{
+  BOOST_ASSERT(comp.isImplicitSha256Digest());
+  if (comp.value_size() != digest.size()) {
+    return comp.value_size() < digest.size() ? -1 : 1;
+  }
+  int cmp = std::memcmp(comp.value(), digest.data(), digest.size());
+  return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+}
+
 bool
-Entry::canSatisfy(const Interest& interest) const
+Entry::canSatisfy(const Interest& interest, DigestCounters* counters) const
 {
-  if (!interest.matchesData(*m_data)) {
+  const Name& interestName = interest.getName();
+  const Name& dataName = m_data->getName();
+  if (interestName.size() == dataName.size() + 1 && interestName[-1].isImplicitSha256Digest()) {
+    // Interest carries an implicit digest: compare it without building the full name
+    if (interestName.compare(0, dataName.size(), dataName) != 0 ||
+        compareDigest(interestName[-1], this->getImplicitDigest(counters)) != 0) {
+      return false;
+    }
+    if (interest.getMustBeFresh() && m_data->getFreshnessPeriod() <= 0_ms) {
+      return false;
+    }
+  }
+  // otherwise, matchesData does not need the implicit digest
+  else if (!interest.matchesData(*m_data)) {
     return false;
   }
 
@@ -61,8 +107,9 @@ Entry::canSatisfy(const Interest& interest) const
 }
 
 static int
-compareQueryWithData(const Name& queryName, const Data& data)
+compareQueryWithData(const Name& queryName, const Entry& entry, DigestCounters* counters)
 {
+  const Data& data = entry.getData();
   bool queryIsFullName = !queryName.empty() && queryName[-1].isImplicitSha256Digest();
 
   int cmp = queryIsFullName ?
@@ -74,7 +121,7 @@ compareQueryWithData(const Name& queryName, const Data& data)
   }
 
   if (queryIsFullName) { // Name without digest equals, compare digest
-    return queryName[-1].compare(data.getFullName()[-1]);
+    return compareDigest(queryName[-1], entry.getImplicitDigest(counters));
   }
   else { // queryName is a proper prefix of Data fullName
     return -1;
@@ -82,32 +129,52 @@ compareQueryWithData(const Name& queryName, const Data& data)
 }
 
 static int
-compareDataWithData(const Data& lhs, const Data& rhs)
+compareEntryWithEntry(const Entry& lhs, const Entry& rhs, DigestCounters* counters)
 {
   int cmp = lhs.getName().compare(rhs.getName());
   if (cmp != 0) {
     return cmp;
   }
-
-  return lhs.getFullName()[-1].compare(rhs.getFullName()[-1]);
+  auto lhsDigest = lhs.getImplicitDigest(counters);
+  auto rhsDigest = rhs.getImplicitDigest(counters);
+  BOOST_ASSERT(lhsDigest.size() == rhsDigest.size());
+  return std::memcmp(lhsDigest.data(), rhsDigest.data(), lhsDigest.size());
 }
 
 bool
 operator<(const Entry& entry, const Name& queryName)
 {
-  return compareQueryWithData(queryName, entry.getData()) > 0;
+  return compareQueryWithData(queryName, entry, nullptr) > 0;
 }
 
 bool
 operator<(const Name& queryName, const Entry& entry)
 {
-  return compareQueryWithData(queryName, entry.getData()) < 0;
+  return compareQueryWithData(queryName, entry, nullptr) < 0;
 }
 
 bool
 operator<(const Entry& lhs, const Entry& rhs)
 {
-  return compareDataWithData(lhs.getData(), rhs.getData()) < 0;
+  return compareEntryWithEntry(lhs, rhs, nullptr) < 0;
+}
+
+bool
+EntryCompare::operator()(const Entry& lhs, const Entry& rhs) const
+{
+  return compareEntryWithEntry(lhs, rhs, m_counters) < 0;
+}
+
+bool
+EntryCompare::operator()(const Entry& entry, const Name& queryName) const
+{
+  return compareQueryWithData(queryName, entry, m_counters) > 0;
+}
+
+bool
+EntryCompare::operator()(const Name& queryName, const Entry& entry) const
+{
+  return compareQueryWithData(queryName, entry, m_counters) < 0;
 }
 
 } // namespace nfd::cs
@@ -27,11 +27,22 @@
 #define NFD_DAEMON_TABLE_CS_ENTRY_HPP
 
 #include "core/common.hpp"
+#include "common/counter.hpp"
 
 #include <set>
 
 namespace nfd::cs {
 
+/** \brief Counts how often ContentStore entries need the implicit digest of their Data.
+ */
+struct DigestCounters
+{
+  /// number of times an implicit digest was needed
+  PacketCounter nRequests;
+  /// number of times an implicit digest was computed, i.e., was not already cached
+  PacketCounter nComputations;
+};
+
 /** \brief A ContentStore entry.
  */
 class Entry
@@ -54,6 +65,8 @@ public: // exposed through ContentStore enumeration
   }
 
   /** \brief Return full name (including implicit digest) of the stored Data.
+   *  \note This caches a copy of the full name in the Data. Use getImplicitDigest()
+   *        when only the digest is needed.
    */
   const Name&
   getFullName() const
@@ -61,6 +74,16 @@ public: // exposed through ContentStore enumeration
     return m_data->getFullName();
   }
 
+  /** \brief Return the implicit SHA-256 digest of the stored Data.
+   *
+   *  The digest is computed on first use and cached in the entry, so that Data packets
+   *  that are never requested by full name are never hashed.
+   *
+   *  \param counters if not null, counts the request and, if needed, the computation
+   */
+  span<const uint8_t>
+  getImplicitDigest(DigestCounters* counters = nullptr) const;
+
   /** \brief Return whether the stored Data is unsolicited.
    */
   bool
@@ -75,9 +98,10 @@ public: // exposed through ContentStore enumeration
   isFresh() const;
 
   /** \brief Determine whether Interest can be satisified by the stored Data.
+   *  \param counters if not null, counts the implicit digest if one is needed
    */
   bool
-  canSatisfy(const Interest& interest) const;
+  canSatisfy(const Interest& interest, DigestCounters* counters = nullptr) const;
 
 public: // used by ContentStore implementation
   Entry(shared_ptr<const Data> data, bool isUnsolicited);
@@ -97,6 +121,7 @@ public: // used by ContentStore implementation
 
 private:
   shared_ptr<const Data> m_data;
+  mutable ndn::ConstBufferPtr m_digest; ///< cached implicit digest, nullptr if not yet computed
   bool m_isUnsolicited;
   time::steady_clock::time_point m_freshUntil;
 };
@@ -110,11 +135,38 @@ operator<(const Name& queryName, const Entry& entry);
 bool
 operator<(const Entry& lhs, const Entry& rhs);
 
-/** \brief An ordered container of ContentStore entries.
+/** \brief Orders ContentStore entries by full name, and enables lookup with queryName.
  *
- *  This container uses std::less<> comparator to enable lookup with queryName.
+ *  Implicit digests needed by the comparisons are counted in the DigestCounters
+ *  passed to the constructor, if any.
+ */
+class EntryCompare
+{
+public:
+  using is_transparent = void;
+
+  explicit
+  EntryCompare(DigestCounters* counters = nullptr) noexcept
+    : m_counters(counters)
+  {
+  }
+
+  bool
+  operator()(const Entry& lhs, const Entry& rhs) const;
+
+  bool
+  operator()(const Entry& entry, const Name& queryName) const;
+
+  bool
+  operator()(const Name& queryName, const Entry& entry) const;
+
+private:
+  DigestCounters* m_counters;
+};
+
+/** \brief An ordered container of ContentStore entries.
  */
-using Table = std::set<Entry, std::less<>>;
+using Table = std::set<Entry, EntryCompare>;
 
 inline bool
 operator<(Table::const_iterator lhs, Table::const_iterator rhs)
@@ -40,6 +40,7 @@ makeDefaultPolicy()
 }
 
 Cs::Cs(size_t nMaxPackets)
+  : m_table(EntryCompare(&m_digestCounters))
 {
   setPolicyImpl(makeDefaultPolicy());
   m_policy->setLimit(nMaxPackets);
@@ -114,8 +115,9 @@ Cs::findImpl(const Interest& interest) const
 
   const Name& prefix = interest.getName();
   auto range = findPrefixRange(prefix);
-  auto match = std::find_if(range.first, range.second,
-                            [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+  auto match = std::find_if(range.first, range.second, [&] (const auto& entry) {
+    return entry.canSatisfy(interest, &m_digestCounters);
+  });
 
   if (match == range.second) {
     NFD_LOG_DEBUG("find " << prefix << " no-match");
@@ -96,6 +96,14 @@ public:
     return m_table.size();
   }
 
+  /** \brief Get counters of implicit digests needed by insertions and lookups.
+   */
+  const DigestCounters&
+  getDigestCounters() const noexcept
+  {
+    return m_digestCounters;
+  }
+
 public: // configuration
   /** \brief Get capacity (in number of packets).
    */
@@ -190,6 +198,7 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   dump();
 
 private:
+  mutable DigestCounters m_digestCounters; ///< updated by m_table comparisons and lookups
   Table m_table;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
@@ -28,6 +28,8 @@
 #include "common/global.hpp"
 #include "common/logger.hpp"
 
+#include <array>
+
 namespace nfd {
 
 NFD_LOG_INIT(DeadNonceList);
@@ -46,6 +48,8 @@ DeadNonceList::DeadNonceList(time::nanoseconds lifetime)
     m_queue.push_back(MARK);
   }
 
+  rebuildFilter();
+
   m_markEvent = getScheduler().schedule(m_markInterval, [this] { mark(); });
   m_adjustCapacityEvent = getScheduler().schedule(m_adjustCapacityInterval, [this] { adjustCapacity(); });
 
@@ -71,7 +75,7 @@ bool
 DeadNonceList::has(const Name& name, Interest::Nonce nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  return isInFilter(entry) && m_ht.find(entry) != m_ht.end();
 }
 
 void
@@ -88,6 +92,7 @@ DeadNonceList::add(const Name& name, Interest::Nonce nonce)
   }
   else {
     m_queue.push_back(entry);
+    addToFilter(entry);
     evictEntries();
   }
 }
@@ -139,6 +144,7 @@ DeadNonceList::adjustCapacity()
 
   m_actualMarkCounts.clear();
   evictEntries();
+  rebuildFilter();
 
   m_adjustCapacityEvent = getScheduler().schedule(m_adjustCapacityInterval, [this] { adjustCapacity(); });
 }
@@ -151,6 +157,9 @@ DeadNonceList::evictEntries()
 
   auto nEvict = std::min(m_queue.size() - m_capacity, EVICT_LIMIT);
   for (size_t i = 0; i < nEvict; i++) {
+    if (m_queue.front() != MARK) {
+      removeFromFilter(m_queue.front());
+    }
     m_queue.pop_front();
   }
   BOOST_ASSERT(m_queue.size() >= m_capacity);
@@ -158,4 +167,75 @@ DeadNonceList::evictEntries()
   NFD_LOG_TRACE("evicted=" << nEvict << " size=" << size() << " capacity=" << m_capacity);
 }
 
+void
+DeadNonceList::rebuildFilter()
+{
+  size_t nWords = 1;
+  while (nWords * 2 < m_capacity) {
+    nWords <<= 1;
+  }
+  // rebuilding is O(size), so only do it when the capacity has moved to another power of two
+  if (nWords == m_filter.size()) {
+    return;
+  }
+
+  m_filter.assign(nWords, 0);
+  for (Entry entry : m_queue) {
+    if (entry != MARK) {
+      addToFilter(entry);
+    }
+  }
+  NFD_LOG_TRACE("filter words=" << nWords);
+}
+
+// The entry is a 64-bit hash: the low bits select a word, and the high bits select three
+// distinct 4-bit counters within that word.
+static std::array<unsigned, 3>
+getFilterShifts(uint64_t entry) noexcept
+{
+  unsigned p0 = static_cast<unsigned>(entry >> 60);
+  unsigned p1 = (p0 + 1 + static_cast<unsigned>((entry >> 52) & 0xFF) % 7) & 0xF;
+  unsigned p2 = (p1 + 1 + static_cast<unsigned>((entry >> 44) & 0xFF) % 7) & 0xF;
+  return {p0 * 4, p1 * 4, p2 * 4};
+}
+
+constexpr uint64_t FILTER_COUNTER_MAX = 0xF;
+
+bool
+DeadNonceList::isInFilter(Entry entry) const
+{
+  uint64_t word = m_filter[entry & (m_filter.size() - 1)];
+  for (unsigned shift : getFilterShifts(entry)) {
+    if (((word >> shift) & FILTER_COUNTER_MAX) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+DeadNonceList::addToFilter(Entry entry)
+{
+  uint64_t& word = m_filter[entry & (m_filter.size() - 1)];
+  for (unsigned shift : getFilterShifts(entry)) {
+    // a saturated counter stays saturated until the next rebuild
+    if (((word >> shift) & FILTER_COUNTER_MAX) != FILTER_COUNTER_MAX) {
+      word += uint64_t(1) << shift;
+    }
+  }
+}
+
+void
+DeadNonceList::removeFromFilter(Entry entry)
+{
+  uint64_t& word = m_filter[entry & (m_filter.size() - 1)];
+  for (unsigned shift : getFilterShifts(entry)) {
+    uint64_t counter = (word >> shift) & FILTER_COUNTER_MAX;
+    BOOST_ASSERT(counter > 0);
+    if (counter != FILTER_COUNTER_MAX) {
+      word -= uint64_t(1) << shift;
+    }
+  }
+}
+
 } // namespace nfd
@@ -52,6 +52,9 @@ namespace nfd {
  * At fixed intervals, a MARK (an entry with a special value) is inserted into the container.
  * The number of MARKs stored in the container reflects the lifetime of the entries,
  * because MARKs are inserted at fixed intervals.
+ *
+ * Most Interests are not looping, so most lookups are negative. A counting Bloom filter over
+ * the stored hashes answers them with a single memory access, without probing the hash table.
  */
 class DeadNonceList : noncopyable
 {
@@ -96,11 +99,6 @@ public:
   }
 
 private:
-  using Entry = uint64_t;
-
-  static Entry
-  makeEntry(const Name& name, Interest::Nonce nonce);
-
   /** \brief Return the number of MARKs in the index
    */
   size_t
@@ -124,6 +122,11 @@ private:
   void
   evictEntries();
 
+  /** \brief Resize the filter according to the current capacity and refill it from the index
+   */
+  void
+  rebuildFilter();
+
 public:
   /// Default entry lifetime
   static constexpr time::nanoseconds DEFAULT_LIFETIME = 6_s;
@@ -149,6 +152,30 @@ private:
   Container::index<Hashtable>::type& m_ht = m_index.get<Hashtable>();
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  using Entry = uint64_t;
+
+  static Entry
+  makeEntry(const Name& name, Interest::Nonce nonce);
+
+  // ---- counting Bloom filter
+
+  /** \brief Return false if \p entry is definitely not in the index
+   */
+  bool
+  isInFilter(Entry entry) const;
+
+  void
+  addToFilter(Entry entry);
+
+  void
+  removeFromFilter(Entry entry);
+
+  /** \brief Filter words, each holding 16 saturating 4-bit counters
+   *
+   *  All counters of an entry are in the same word, so that a lookup touches one cache line.
+   *  The number of words is kept around one word per two entries of capacity.
+   */
+  std::vector<uint64_t> m_filter;
 
   // ---- current capacity and hard limits
 
@@ -81,6 +81,16 @@ Fib::findExactMatch(const Name& prefix)
   return nullptr;
 }
 
+std::vector<Entry*>
+Fib::findEntriesWithNextHop(const Face& face) const
+{
+  auto it = m_faceEntries.find(&face);
+  if (it == m_faceEntries.end()) {
+    return {};
+  }
+  return {it->second.begin(), it->second.end()};
+}
+
 std::pair<Entry*, bool>
 Fib::insert(const Name& prefix)
 {
@@ -91,6 +101,7 @@ Fib::insert(const Name& prefix)
   }
 
   nte.setFibEntry(make_unique<Entry>(prefix));
+  m_orderedEntries.insert(nte.getFibEntry());
   ++m_nItems;
   return {nte.getFibEntry(), true};
 }
@@ -100,6 +111,12 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
 {
   BOOST_ASSERT(nte != nullptr);
 
+  if (Entry* entry = nte->getFibEntry(); entry != nullptr) {
+    for (const auto& nexthop : entry->getNextHops()) {
+      this->unindexNextHop(*entry, nexthop.getFace());
+    }
+    m_orderedEntries.erase(entry);
+  }
   nte->setFibEntry(nullptr);
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
@@ -131,8 +148,10 @@ void
 Fib::addOrUpdateNextHop(Entry& entry, Face& face, uint64_t cost)
 {
   auto [it, isNew] = entry.addOrUpdateNextHop(face, cost);
-  if (isNew)
+  if (isNew) {
+    m_faceEntries[&face].insert(&entry);
     this->afterNewNextHop(entry.getPrefix(), *it);
+  }
 }
 
 Fib::RemoveNextHopResult
@@ -143,7 +162,9 @@ Fib::removeNextHop(Entry& entry, const Face& face)
   if (!isRemoved) {
     return RemoveNextHopResult::NO_SUCH_NEXTHOP;
   }
-  else if (!entry.hasNextHops()) {
+
+  this->unindexNextHop(entry, face);
+  if (!entry.hasNextHops()) {
     name_tree::Entry* nte = m_nameTree.getEntry(entry);
     this->erase(nte, false);
     return RemoveNextHopResult::FIB_ENTRY_REMOVED;
@@ -153,6 +174,17 @@ Fib::removeNextHop(Entry& entry, const Face& face)
   }
 }
 
+void
+Fib::unindexNextHop(Entry& entry, const Face& face)
+{
+  auto it = m_faceEntries.find(&face);
+  BOOST_ASSERT(it != m_faceEntries.end());
+  it->second.erase(&entry);
+  if (it->second.empty()) {
+    m_faceEntries.erase(it);
+  }
+}
+
 Fib::Range
 Fib::getRange() const
 {
@@ -160,4 +192,11 @@ Fib::getRange() const
          boost::adaptors::transformed(name_tree::GetTableEntry<Entry>(&name_tree::Entry::getFibEntry));
 }
 
+Fib::OrderedRange
+Fib::getOrderedRange(const std::optional<Name>& after) const
+{
+  auto first = after ? m_orderedEntries.upper_bound(*after) : m_orderedEntries.begin();
+  return boost::make_iterator_range(first, m_orderedEntries.end()) | boost::adaptors::indirected;
+}
+
 } // namespace nfd::fib
@@ -29,8 +29,14 @@
 #include "fib-entry.hpp"
 #include "name-tree.hpp"
 
+#include <boost/range/adaptor/indirected.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace nfd {
 
 namespace measurements {
@@ -84,6 +90,14 @@ public: // lookup
   Entry*
   findExactMatch(const Name& prefix);
 
+  /** \brief Returns the entries that have a NextHop record for \p face.
+   *
+   *  The entries are found through a per-face index, so the cost is proportional to the
+   *  number of entries returned rather than to the size of the FIB.
+   */
+  std::vector<Entry*>
+  findEntriesWithNextHop(const Face& face) const;
+
 public: // mutation
   /** \brief Maximum number of components in a FIB entry prefix.
    */
@@ -148,6 +162,66 @@ public: // enumeration
     return this->getRange().end();
   }
 
+private:
+  /// orders entries by their prefixes, in canonical name order
+  struct PrefixCompare
+  {
+    using is_transparent = void;
+
+    bool
+    operator()(const Entry* a, const Entry* b) const
+    {
+      return a->getPrefix() < b->getPrefix();
+    }
+
+    bool
+    operator()(const Entry* a, const Name& b) const
+    {
+      return a->getPrefix() < b;
+    }
+
+    bool
+    operator()(const Name& a, const Entry* b) const
+    {
+      return a < b->getPrefix();
+    }
+  };
+
+  using OrderedIndex = std::set<const Entry*, PrefixCompare>;
+
+public:
+  using OrderedRange =
+    boost::indirected_range<const boost::iterator_range<OrderedIndex::const_iterator>>;
+
+  /** \brief Enumerate entries in canonical order of their prefixes.
+   *  \param after if set, the range starts with the first entry whose prefix follows \p after
+   *
+   *  Unlike begin() and end(), this order does not depend on the name tree hashtable.
+   *  An enumeration can be resumed from the last prefix visited, even if entries have been
+   *  inserted or erased in the meantime: every entry that exists throughout is visited once.
+   *  \warning Undefined behavior may occur if a FIB entry is inserted or erased while the
+   *           returned range is in use.
+   */
+  OrderedRange
+  getOrderedRange(const std::optional<Name>& after = std::nullopt) const;
+
+  /** \brief Visit all entries in iteration order, without allocating memory.
+   *  \tparam Visitor a callable with signature `void(const Entry&)`
+   *  \warning The visitor must not insert or erase FIB/PIT/Measurements/StrategyChoice entries.
+   *  \sa NameTree::forEachEntry
+   */
+  template<typename Visitor>
+  void
+  forEachEntry(Visitor&& visitor) const
+  {
+    m_nameTree.forEachEntry([&visitor] (const name_tree::Entry& nte) {
+      const Entry* entry = nte.getFibEntry();
+      if (entry != nullptr) {
+        visitor(*entry);
+      }
+    });
+  }
+
 public: // signal
   /** \brief Signals on Fib entry nexthop creation.
    */
@@ -163,12 +237,19 @@ private:
   void
   erase(name_tree::Entry* nte, bool canDeleteNte = true);
 
+  void
+  unindexNextHop(Entry& entry, const Face& face);
+
   Range
   getRange() const;
 
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  /// Face => entries with a NextHop record for that face
+  std::unordered_map<const Face*, std::unordered_set<Entry*>> m_faceEntries;
+  /// all entries, in canonical order of their prefixes
+  OrderedIndex m_orderedEntries;
 
   /** \brief The empty FIB entry.
    *
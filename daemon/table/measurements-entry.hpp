@@ -28,7 +28,7 @@
 
 #include "strategy-info-host.hpp"
 
-#include <ndn-cxx/util/scheduler.hpp>
+#include <boost/intrusive/list_hook.hpp>
 
 namespace nfd::name_tree {
 class Entry;
@@ -60,7 +60,7 @@ public:
 private:
   Name m_name;
   time::steady_clock::time_point m_expiry = time::steady_clock::time_point::min();
-  ndn::scheduler::EventId m_cleanup;
+  boost::intrusive::list_member_hook<> m_expiryHook;
 
   name_tree::Entry* m_nameTreeEntry = nullptr;
 
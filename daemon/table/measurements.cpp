@@ -31,6 +31,9 @@
 
 namespace nfd::measurements {
 
+/// Maximum number of entries processed by a single sweep, before yielding to the event loop.
+constexpr size_t CLEANUP_BATCH_SIZE = 2048;
+
 Measurements::Measurements(NameTree& nameTree)
   : m_nameTree(nameTree)
 {
@@ -49,7 +52,8 @@ Measurements::get(name_tree::Entry& nte)
   entry = nte.getMeasurementsEntry();
 
   entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
-  entry->m_cleanup = getScheduler().schedule(getInitialLifetime(), [=] { cleanup(*entry); });
+  this->insertExpiry(*entry);
+  this->scheduleSweep();
 
   return *entry;
 }
@@ -133,9 +137,69 @@ Measurements::extendLifetime(Entry& entry, const time::nanoseconds& lifetime)
     return;
   }
 
-  entry.m_cleanup.cancel();
+  // the entry stays in its current bucket, and is moved when that bucket is swept
   entry.m_expiry = expiry;
-  entry.m_cleanup = getScheduler().schedule(lifetime, [&] { cleanup(entry); });
+}
+
+void
+Measurements::insertExpiry(Entry& entry)
+{
+  constexpr auto granularity = getCleanupGranularity();
+  auto sinceEpoch = entry.m_expiry.time_since_epoch();
+  auto bucket = time::steady_clock::time_point((sinceEpoch + granularity - 1_ns) / granularity * granularity);
+  m_expiryBuckets[bucket].push_back(entry);
+}
+
+void
+Measurements::scheduleSweep()
+{
+  if (m_expiryBuckets.empty()) {
+    m_sweepEvent.cancel();
+    m_nextSweep = time::steady_clock::time_point::max();
+    return;
+  }
+
+  auto earliest = m_expiryBuckets.begin()->first;
+  if (m_sweepEvent && earliest >= m_nextSweep) {
+    return;
+  }
+
+  m_nextSweep = earliest;
+  auto delay = std::max(earliest - time::steady_clock::now(), time::steady_clock::duration::zero());
+  m_sweepEvent = getScheduler().schedule(delay, [this] { sweep(); });
+}
+
+void
+Measurements::sweep()
+{
+  m_nextSweep = time::steady_clock::time_point::max();
+  auto now = time::steady_clock::now();
+  size_t nProcessed = 0;
+
+  while (!m_expiryBuckets.empty() && m_expiryBuckets.begin()->first <= now) {
+    ExpiryList& bucket = m_expiryBuckets.begin()->second;
+    while (!bucket.empty()) {
+      if (nProcessed++ == CLEANUP_BATCH_SIZE) {
+        // resume on the next event loop iteration
+        m_nextSweep = now;
+        m_sweepEvent = getScheduler().schedule(0_ns, [this] { sweep(); });
+        return;
+      }
+
+      Entry& entry = bucket.front();
+      bucket.pop_front();
+      if (entry.m_expiry <= now) {
+        this->cleanup(entry);
+      }
+      else {
+        // lifetime was extended; this always goes into a later bucket
+        this->insertExpiry(entry);
+      }
+    }
+    m_expiryBuckets.erase(m_expiryBuckets.begin());
+  }
+
+  this->scheduleSweep();
 }
 
 void
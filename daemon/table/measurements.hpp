@@ -29,7 +29,12 @@
 #include "measurements-entry.hpp"
 #include "name-tree.hpp"
 
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <boost/intrusive/list.hpp>
+
 #include <functional>
+#include <map>
 
 namespace nfd {
 
@@ -147,6 +152,8 @@ public:
   /** \brief Extend lifetime of an entry.
    *
    *  The entry will be kept until at least now()+lifetime.
+   *  This only updates the expiration time of the entry; expired entries are
+   *  erased in batches by a periodic sweep, up to getCleanupGranularity() late.
    */
   void
   extendLifetime(Entry& entry, const time::nanoseconds& lifetime);
@@ -157,10 +164,38 @@ public:
     return m_nItems;
   }
 
+  /** \brief Granularity of entry expiration.
+   *
+   *  Entries expiring within the same interval of this duration are erased together.
+   */
+  static constexpr time::nanoseconds
+  getCleanupGranularity()
+  {
+    return 1_s;
+  }
+
 private:
   void
   cleanup(Entry& entry);
 
+  /** \brief Add \p entry to the expiry bucket that covers `entry.m_expiry`.
+   */
+  void
+  insertExpiry(Entry& entry);
+
+  /** \brief Schedule the next sweep at the time of the earliest expiry bucket.
+   */
+  void
+  scheduleSweep();
+
+  /** \brief Erase entries in expired buckets, a bounded number per invocation.
+   *
+   *  Entries whose lifetime has been extended since they were added to a bucket
+   *  are moved to the bucket that covers their new expiration time.
+   */
+  void
+  sweep();
+
   Entry&
   get(name_tree::Entry& nte);
 
@@ -173,6 +208,13 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+
+  using ExpiryList = boost::intrusive::list<Entry,
+    boost::intrusive::member_hook<Entry, boost::intrusive::list_member_hook<>, &Entry::m_expiryHook>>;
+  /// Entries grouped by expiration time, rounded up to getCleanupGranularity().
+  std::map<time::steady_clock::time_point, ExpiryList> m_expiryBuckets;
+  time::steady_clock::time_point m_nextSweep = time::steady_clock::time_point::max();
+  ndn::scheduler::ScopedEventId m_sweepEvent;
 };
 
 } // namespace measurements
@@ -26,25 +26,84 @@
 #include "name-tree-entry.hpp"
 #include "name-tree.hpp"
 
+#include <limits>
+
 namespace nfd::name_tree {
 
+const std::vector<shared_ptr<pit::Entry>> Entry::s_noPitEntries;
+
 Entry::Entry(const Name& name, Node* node)
-  : m_name(name)
-  , m_node(node)
+  : m_node(node)
+  , m_depth(static_cast<uint16_t>(name.size()))
 {
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(name.size() <= NameTree::getMaxDepth());
+
+  if (!name.empty()) {
+    // copy the component, so that the entry does not keep the packet buffer alive
+    const auto& comp = name[-1];
+    BOOST_ASSERT(comp.value_size() <= std::numeric_limits<uint16_t>::max());
+    m_componentType = comp.type();
+    m_componentSize = static_cast<uint16_t>(comp.value_size());
+    m_componentValue = make_unique<uint8_t[]>(m_componentSize);
+    std::copy(comp.value_begin(), comp.value_end(), m_componentValue.get());
+  }
+}
+
+Name
+Entry::getName() const
+{
+  std::vector<const Entry*> path(m_depth);
+  const Entry* entry = this;
+  for (size_t i = m_depth; i > 0; --i) {
+    BOOST_ASSERT(entry != nullptr && entry->m_depth == i);
+    path[i - 1] = entry;
+    entry = entry->m_parent;
+  }
+
+  Name name;
+  for (const Entry* e : path) {
+    name.append(e->m_componentType, {e->m_componentValue.get(), e->m_componentSize});
+  }
+  return name;
+}
+
+bool
+Entry::isNameEqual(const Name& name, size_t prefixLen) const
+{
+  BOOST_ASSERT(prefixLen <= name.size());
+
+  if (m_depth != prefixLen) {
+    return false;
+  }
+
+  const Entry* entry = this;
+  for (size_t i = prefixLen; i > 0; --i) {
+    BOOST_ASSERT(entry != nullptr);
+    const auto& comp = name[i - 1];
+    if (entry->m_componentType != comp.type() ||
+        entry->m_componentSize != comp.value_size() ||
+        !std::equal(comp.value_begin(), comp.value_end(), entry->m_componentValue.get())) {
+      return false;
+    }
+    entry = entry->m_parent;
+  }
+  return true;
 }
 
 void
 Entry::setParent(Entry& entry)
 {
   BOOST_ASSERT(this->getParent() == nullptr);
-  BOOST_ASSERT(!this->getName().empty());
-  BOOST_ASSERT(entry.getName() == this->getName().getPrefix(-1));
+  BOOST_ASSERT(m_depth > 0);
+  BOOST_ASSERT(entry.getDepth() + 1 == m_depth);
 
   m_parent = &entry;
-  m_parent->m_children.push_back(this);
+  m_nextSibling = m_parent->m_firstChild;
+  if (m_nextSibling != nullptr) {
+    m_nextSibling->m_prevSibling = this;
+  }
+  m_parent->m_firstChild = this;
 }
 
 void
@@ -52,20 +111,47 @@ Entry::unsetParent()
 {
   BOOST_ASSERT(this->getParent() != nullptr);
 
-  auto i = std::find(m_parent->m_children.begin(), m_parent->m_children.end(), this);
-  BOOST_ASSERT(i != m_parent->m_children.end());
-  m_parent->m_children.erase(i);
+  if (m_prevSibling != nullptr) {
+    m_prevSibling->m_nextSibling = m_nextSibling;
+  }
+  else {
+    BOOST_ASSERT(m_parent->m_firstChild == this);
+    m_parent->m_firstChild = m_nextSibling;
+  }
+  if (m_nextSibling != nullptr) {
+    m_nextSibling->m_prevSibling = m_prevSibling;
+  }
 
   m_parent = nullptr;
+  m_prevSibling = nullptr;
+  m_nextSibling = nullptr;
 }
 
 bool
 Entry::hasTableEntries() const
 {
-  return m_fibEntry != nullptr ||
-         !m_pitEntries.empty() ||
-         m_measurementsEntry != nullptr ||
-         m_strategyChoiceEntry != nullptr;
+  return m_tables != nullptr &&
+         (m_tables->fibEntry != nullptr ||
+          !m_tables->pitEntries.empty() ||
+          m_tables->measurementsEntry != nullptr ||
+          m_tables->strategyChoiceEntry != nullptr);
+}
+
+Entry::TableEntries&
+Entry::getTables()
+{
+  if (m_tables == nullptr) {
+    m_tables = make_unique<TableEntries>();
+  }
+  return *m_tables;
+}
+
+void
+Entry::releaseTablesIfEmpty()
+{
+  if (m_tables != nullptr && !this->hasTableEntries()) {
+    m_tables.reset();
+  }
 }
 
 void
@@ -73,14 +159,20 @@ Entry::setFibEntry(unique_ptr<fib::Entry> fibEntry)
 {
   BOOST_ASSERT(fibEntry == nullptr || fibEntry->m_nameTreeEntry == nullptr);
 
-  if (m_fibEntry != nullptr) {
-    m_fibEntry->m_nameTreeEntry = nullptr;
+  if (m_tables == nullptr && fibEntry == nullptr) {
+    return;
+  }
+
+  auto& tables = this->getTables();
+  if (tables.fibEntry != nullptr) {
+    tables.fibEntry->m_nameTreeEntry = nullptr;
   }
-  m_fibEntry = std::move(fibEntry);
+  tables.fibEntry = std::move(fibEntry);
 
-  if (m_fibEntry != nullptr) {
-    m_fibEntry->m_nameTreeEntry = this;
+  if (tables.fibEntry != nullptr) {
+    tables.fibEntry->m_nameTreeEntry = this;
   }
+  this->releaseTablesIfEmpty();
 }
 
 void
@@ -89,7 +181,7 @@ Entry::insertPitEntry(shared_ptr<pit::Entry> pitEntry)
   BOOST_ASSERT(pitEntry != nullptr);
   BOOST_ASSERT(pitEntry->m_nameTreeEntry == nullptr);
 
-  m_pitEntries.push_back(pitEntry);
+  this->getTables().pitEntries.push_back(pitEntry);
   pitEntry->m_nameTreeEntry = this;
 }
 
@@ -98,14 +190,17 @@ Entry::erasePitEntry(pit::Entry* pitEntry)
 {
   BOOST_ASSERT(pitEntry != nullptr);
   BOOST_ASSERT(pitEntry->m_nameTreeEntry == this);
+  BOOST_ASSERT(m_tables != nullptr);
 
-  auto it = std::find_if(m_pitEntries.begin(), m_pitEntries.end(),
+  auto& pitEntries = m_tables->pitEntries;
+  auto it = std::find_if(pitEntries.begin(), pitEntries.end(),
                          [pitEntry] (const auto& pitEntry2) { return pitEntry2.get() == pitEntry; });
-  BOOST_ASSERT(it != m_pitEntries.end());
+  BOOST_ASSERT(it != pitEntries.end());
 
   pitEntry->m_nameTreeEntry = nullptr; // must be done before pitEntry is deallocated
-  *it = m_pitEntries.back(); // may deallocate pitEntry
-  m_pitEntries.pop_back();
+  *it = pitEntries.back(); // may deallocate pitEntry
+  pitEntries.pop_back();
+  this->releaseTablesIfEmpty();
 }
 
 void
@@ -113,14 +208,20 @@ Entry::setMeasurementsEntry(unique_ptr<measurements::Entry> measurementsEntry)
 {
   BOOST_ASSERT(measurementsEntry == nullptr || measurementsEntry->m_nameTreeEntry == nullptr);
 
-  if (m_measurementsEntry != nullptr) {
-    m_measurementsEntry->m_nameTreeEntry = nullptr;
+  if (m_tables == nullptr && measurementsEntry == nullptr) {
+    return;
   }
-  m_measurementsEntry = std::move(measurementsEntry);
 
-  if (m_measurementsEntry != nullptr) {
-    m_measurementsEntry->m_nameTreeEntry = this;
+  auto& tables = this->getTables();
+  if (tables.measurementsEntry != nullptr) {
+    tables.measurementsEntry->m_nameTreeEntry = nullptr;
   }
+  tables.measurementsEntry = std::move(measurementsEntry);
+
+  if (tables.measurementsEntry != nullptr) {
+    tables.measurementsEntry->m_nameTreeEntry = this;
+  }
+  this->releaseTablesIfEmpty();
 }
 
 void
@@ -128,14 +229,20 @@ Entry::setStrategyChoiceEntry(unique_ptr<strategy_choice::Entry> strategyChoiceE
 {
   BOOST_ASSERT(strategyChoiceEntry == nullptr || strategyChoiceEntry->m_nameTreeEntry == nullptr);
 
-  if (m_strategyChoiceEntry != nullptr) {
-    m_strategyChoiceEntry->m_nameTreeEntry = nullptr;
+  if (m_tables == nullptr && strategyChoiceEntry == nullptr) {
+    return;
+  }
+
+  auto& tables = this->getTables();
+  if (tables.strategyChoiceEntry != nullptr) {
+    tables.strategyChoiceEntry->m_nameTreeEntry = nullptr;
   }
-  m_strategyChoiceEntry = std::move(strategyChoiceEntry);
+  tables.strategyChoiceEntry = std::move(strategyChoiceEntry);
 
-  if (m_strategyChoiceEntry != nullptr) {
-    m_strategyChoiceEntry->m_nameTreeEntry = this;
+  if (tables.strategyChoiceEntry != nullptr) {
+    tables.strategyChoiceEntry->m_nameTreeEntry = this;
   }
+  this->releaseTablesIfEmpty();
 }
 
 } // namespace nfd::name_tree
@@ -37,18 +37,41 @@ class Node;
 
 /**
  * \brief An entry in the name tree.
+ *
+ * To keep entries small, an entry stores only the last component of its name. The full name
+ * is reconstructed from the components of the entry and its ancestors when requested.
+ * Children are kept in an intrusive list, and the attached table entries are allocated
+ * together in a separate structure, only when the first table entry is attached.
  */
 class Entry : noncopyable
 {
 public:
-  Entry(const Name& prefix, Node* node);
+  /** \param name name of the entry; only its last component is stored
+   *  \param node hashtable node that owns the entry
+   */
+  Entry(const Name& name, Node* node);
 
-  const Name&
-  getName() const noexcept
+  /** \brief Returns the name of this entry.
+   *  \pre this entry is attached to its ancestors, which is the case for every entry in a NameTree
+   *  \note The name is reconstructed on every call.
+   */
+  Name
+  getName() const;
+
+  /** \brief Returns the number of components in the name of this entry.
+   */
+  size_t
+  getDepth() const noexcept
   {
-    return m_name;
+    return m_depth;
   }
 
+  /** \brief Determines whether the name of this entry equals \p name.getPrefix(prefixLen).
+   *  \pre this entry is attached to its ancestors
+   */
+  bool
+  isNameEqual(const Name& name, size_t prefixLen) const;
+
   /** \return entry of getName().getPrefix(-1)
    *  \retval nullptr this entry is the root entry, i.e. getName() == Name()
    */
@@ -62,14 +85,14 @@ public:
    *  \param entry entry of getName().getPrefix(-1)
    *  \pre getParent() == nullptr
    *  \post getParent() == &entry
-   *  \post entry.getChildren() contains this
+   *  \post this is among the children of \p entry
    */
   void
   setParent(Entry& entry);
 
   /** \brief Unset parent of this entry.
    *  \post getParent() == nullptr
-   *  \post parent.getChildren() does not contain this
+   *  \post this is not among the children of the former parent
    */
   void
   unsetParent();
@@ -78,18 +101,29 @@ public:
    * \brief Check whether this entry has any children.
    */
   bool
-  hasChildren() const
+  hasChildren() const noexcept
   {
-    return !m_children.empty();
+    return m_firstChild != nullptr;
   }
 
-  /**
-   * \brief Returns the children of this entry.
+  /** \brief Returns the first child of this entry.
+   *  \retval nullptr this entry has no children
+   *
+   *  The children of an entry are visited with getFirstChild() and getNextSibling().
    */
-  const std::vector<Entry*>&
-  getChildren() const noexcept
+  Entry*
+  getFirstChild() const noexcept
+  {
+    return m_firstChild;
+  }
+
+  /** \brief Returns the next child of this entry's parent.
+   *  \retval nullptr this is the last child
+   */
+  Entry*
+  getNextSibling() const noexcept
   {
-    return m_children;
+    return m_nextSibling;
   }
 
   /** \retval true this entry has no children and no table entries
@@ -111,7 +145,7 @@ public: // attached table entries
   fib::Entry*
   getFibEntry() const
   {
-    return m_fibEntry.get();
+    return m_tables == nullptr ? nullptr : m_tables->fibEntry.get();
   }
 
   void
@@ -126,7 +160,7 @@ public: // attached table entries
   const std::vector<shared_ptr<pit::Entry>>&
   getPitEntries() const
   {
-    return m_pitEntries;
+    return m_tables == nullptr ? s_noPitEntries : m_tables->pitEntries;
   }
 
   void
@@ -138,7 +172,7 @@ public: // attached table entries
   measurements::Entry*
   getMeasurementsEntry() const
   {
-    return m_measurementsEntry.get();
+    return m_tables == nullptr ? nullptr : m_tables->measurementsEntry.get();
   }
 
   void
@@ -147,12 +181,41 @@ public: // attached table entries
   strategy_choice::Entry*
   getStrategyChoiceEntry() const
   {
-    return m_strategyChoiceEntry.get();
+    return m_tables == nullptr ? nullptr : m_tables->strategyChoiceEntry.get();
   }
 
   void
   setStrategyChoiceEntry(unique_ptr<strategy_choice::Entry> strategyChoiceEntry);
 
+  /** \brief Get the memoized effective strategy of this entry.
+   *  \param version current version of the StrategyChoice table
+   *  \retval nullptr nothing is memoized, or the memoized value belongs to another version
+   *  \note This function is for StrategyChoice internal use.
+   */
+  fw::Strategy*
+  getEffectiveStrategy(uint64_t version) const noexcept
+  {
+    if (m_tables == nullptr || m_tables->effectiveStrategyVersion != version) {
+      return nullptr;
+    }
+    return m_tables->effectiveStrategy;
+  }
+
+  /** \brief Memoize the effective strategy of this entry.
+   *
+   *  Nothing is memoized on an entry without table entries, so that intermediate entries
+   *  stay small.
+   *  \note This function is for StrategyChoice internal use.
+   */
+  void
+  setEffectiveStrategy(fw::Strategy* strategy, uint64_t version) const noexcept
+  {
+    if (m_tables != nullptr) {
+      m_tables->effectiveStrategy = strategy;
+      m_tables->effectiveStrategyVersion = version;
+    }
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    *  \note This function is for NameTree internal use. Other components
@@ -166,15 +229,44 @@ public: // attached table entries
   }
 
 private:
-  Name m_name;
+  /** \brief Table entries attached to a name tree entry, and the memoized effective strategy.
+   */
+  struct TableEntries
+  {
+    unique_ptr<fib::Entry> fibEntry;
+    std::vector<shared_ptr<pit::Entry>> pitEntries;
+    unique_ptr<measurements::Entry> measurementsEntry;
+    unique_ptr<strategy_choice::Entry> strategyChoiceEntry;
+    fw::Strategy* effectiveStrategy = nullptr;
+    uint64_t effectiveStrategyVersion = 0;
+  };
+
+  /** \brief Returns the attached table entries, allocating them if necessary.
+   */
+  TableEntries&
+  getTables();
+
+  /** \brief Releases the table entries structure if nothing is attached.
+   */
+  void
+  releaseTablesIfEmpty();
+
+private:
   Node* m_node;
   Entry* m_parent = nullptr;
-  std::vector<Entry*> m_children;
+  Entry* m_firstChild = nullptr;
+  Entry* m_prevSibling = nullptr;
+  Entry* m_nextSibling = nullptr;
+
+  /// TLV-VALUE of the last name component, nullptr for the root entry
+  unique_ptr<uint8_t[]> m_componentValue;
+  uint32_t m_componentType = 0;
+  uint16_t m_componentSize = 0;
+  uint16_t m_depth = 0;
+
+  unique_ptr<TableEntries> m_tables;
 
-  unique_ptr<fib::Entry> m_fibEntry;
-  std::vector<shared_ptr<pit::Entry>> m_pitEntries;
-  unique_ptr<measurements::Entry> m_measurementsEntry;
-  unique_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
+  static const std::vector<shared_ptr<pit::Entry>> s_noPitEntries;
 
   friend Node* getNode(const Entry& entry);
 };
@@ -89,6 +89,25 @@ computeHashes(const Name& name, size_t prefixLen)
   return seq;
 }
 
+size_t
+computeHashes(const Name& name, size_t prefixLen, span<HashValue> hashes)
+{
+  name.wireEncode(); // ensure wire buffer exists
+
+  size_t last = std::min(prefixLen, name.size());
+  BOOST_ASSERT(hashes.size() > last);
+
+  HashValue h = 0;
+  hashes[0] = h;
+
+  for (size_t i = 0; i < last; ++i) {
+    const name::Component& comp = name[i];
+    h ^= HashFunc::compute(comp.data(), comp.size());
+    hashes[i + 1] = h;
+  }
+  return last + 1;
+}
+
 Node::Node(HashValue h, const Name& name)
   : hash(h)
   , prev(nullptr)
@@ -183,7 +202,7 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
-    if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+    if (node->hash == h && node->entry.isNameEqual(name, prefixLen)) {
       NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
       return {node, false};
     }
@@ -196,7 +215,7 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
 
   Node* node = new Node(h, name.getPrefix(prefixLen));
   this->attach(bucket, node);
-  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
+  NFD_LOG_TRACE("insert " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
   ++m_size;
 
   if (m_size > m_expandThreshold) {
@@ -220,6 +239,13 @@ Hashtable::find(const Name& name, size_t prefixLen, const HashSequence& hashes)
   return const_cast<Hashtable*>(this)->findOrInsert(name, prefixLen, hashes[prefixLen], false).first;
 }
 
+const Node*
+Hashtable::find(const Name& name, size_t prefixLen, HashValue h) const
+{
+  BOOST_ASSERT(h == computeHash(name, prefixLen));
+  return const_cast<Hashtable*>(this)->findOrInsert(name, prefixLen, h, false).first;
+}
+
 std::pair<const Node*, bool>
 Hashtable::insert(const Name& name, size_t prefixLen, const HashSequence& hashes)
 {
@@ -234,7 +260,7 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
   size_t bucket = this->computeBucketIndex(node->hash);
-  NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
+  NFD_LOG_TRACE("erase depth=" << node->entry.getDepth() << " hash=" << node->hash << " bucket=" << bucket);
 
   this->detach(bucket, node);
   delete node;
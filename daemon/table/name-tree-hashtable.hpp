@@ -54,6 +54,16 @@ computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::ma
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
+/** \brief Computes hash values for each prefix of \p name.getPrefix(prefixLen) into \p hashes.
+ *  \pre hashes.size() > min(prefixLen, name.size())
+ *  \return number of hash values written, i.e., min(prefixLen, name.size()) + 1;
+ *          the i-th hash value equals computeHash(name, i)
+ *
+ *  Unlike the overload that returns a HashSequence, this overload does not allocate memory.
+ */
+size_t
+computeHashes(const Name& name, size_t prefixLen, span<HashValue> hashes);
+
 /** \brief A hashtable node.
  *
  *  Zero or more nodes can be added to a hashtable bucket. They are organized as
@@ -62,7 +72,7 @@ computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::
 class Node : noncopyable
 {
 public:
-  /** \post entry.getName() == name
+  /** \post entry.getDepth() == name.size(), and entry stores the last component of name
    *  \post getNode(entry) == this
    */
   Node(HashValue h, const Name& name);
@@ -146,6 +156,11 @@ struct HashtableOptions
  * Each node is placed into a bucket determined by a hash value computed from its name.
  * Hash collision is resolved through a doubly linked list in each bucket.
  * The number of buckets is adjusted according to how many nodes are stored.
+ *
+ * Since an entry stores only the last component of its name, a name is compared against
+ * an entry by walking the entry's ancestors. Therefore, every node whose name has more
+ * than one component must have its entry attached to the parent entry (see Entry::setParent)
+ * before another lookup of the same hash value is performed.
  */
 class Hashtable
 {
@@ -206,6 +221,13 @@ public:
   const Node*
   find(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
 
+  /** \brief Find node for name.getPrefix(prefixLen).
+   *  \pre name.size() > prefixLen
+   *  \pre h == computeHash(name, prefixLen)
+   */
+  const Node*
+  find(const Name& name, size_t prefixLen, HashValue h) const;
+
   /** \brief Find or insert node for name.getPrefix(prefixLen).
    *  \pre name.size() > prefixLen
    *  \pre hashes == computeHashes(name)
@@ -161,7 +161,7 @@ PartialEnumerationImpl::advance(Iterator& i)
   // pre-order traversal
   while (i.m_entry != i.m_ref || (wantChildren && i.m_entry->hasChildren())) {
     if (wantChildren && i.m_entry->hasChildren()) { // process children of m_entry
-      i.m_entry = i.m_entry->getChildren().front();
+      i.m_entry = i.m_entry->getFirstChild();
       std::tie(wantSelf, wantChildren) = m_pred(*i.m_entry);
       if (wantSelf) { // visit first child
         i.m_state = wantChildren;
@@ -170,12 +170,9 @@ PartialEnumerationImpl::advance(Iterator& i)
       // first child rejected, let while loop process other children (siblings of new m_entry)
     }
     else { // process siblings of m_entry
-      const Entry* parent = i.m_entry->getParent();
-      const std::vector<Entry*>& siblings = parent->getChildren();
-      auto sibling = std::find(siblings.begin(), siblings.end(), i.m_entry);
-      BOOST_ASSERT(sibling != siblings.end());
-      while (++sibling != siblings.end()) {
-        i.m_entry = *sibling;
+      const Entry* sibling = i.m_entry->getNextSibling();
+      for (; sibling != nullptr; sibling = sibling->getNextSibling()) {
+        i.m_entry = sibling;
         std::tie(wantSelf, wantChildren) = m_pred(*i.m_entry);
         if (wantSelf) { // visit sibling
           i.m_state = wantChildren;
@@ -186,8 +183,8 @@ PartialEnumerationImpl::advance(Iterator& i)
         }
         // process next sibling
       }
-      if (sibling == siblings.end()) { // no more sibling
-        i.m_entry = parent;
+      if (sibling == nullptr) { // no more sibling
+        i.m_entry = i.m_entry->getParent();
         wantChildren = false;
       }
     }
@@ -160,17 +160,7 @@ NameTree::findExactMatch(const Name& name, size_t prefixLen) const
 Entry*
 NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector) const
 {
-  size_t depth = std::min(name.size(), getMaxDepth());
-  HashSequence hashes = computeHashes(name, depth);
-
-  for (ssize_t i = depth; i >= 0; --i) {
-    const Node* node = m_ht.find(name, i, hashes);
-    if (node != nullptr && entrySelector(node->entry)) {
-      return &node->entry;
-    }
-  }
-
-  return nullptr;
+  return this->findLongestPrefixMatchImpl(name, entrySelector);
 }
 
 Entry*
@@ -194,9 +184,9 @@ NameTree::findLongestPrefixMatch(const pit::Entry& pitEntry, const EntrySelector
 
   const Name& name = pitEntry.getName();
   size_t depth = std::min(name.size(), getMaxDepth());
-  if (nte->getName().size() < pitEntry.getName().size()) {
+  if (nte->getDepth() < pitEntry.getName().size()) {
     // PIT entry name either exceeds depth limit or ends with an implicit digest: go deeper
-    for (size_t i = nte->getName().size() + 1; i <= depth; ++i) {
+    for (size_t i = nte->getDepth() + 1; i <= depth; ++i) {
       const Entry* exact = this->findExactMatch(name, i);
       if (exact == nullptr) {
         break;
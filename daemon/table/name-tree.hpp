@@ -28,6 +28,9 @@
 
 #include "name-tree-iterator.hpp"
 
+#include <array>
+#include <type_traits>
+
 namespace nfd {
 namespace name_tree {
 
@@ -213,6 +216,32 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Visit every entry whose name is a prefix of \p name
+   *  \tparam Visitor a callable with signature `void(const Entry&)`
+   *
+   *  Entries are visited from the longest prefix up to the root entry.
+   *  Unlike findAllMatches(), this function does not allocate memory, and the visitor
+   *  is called directly, so that it can be inlined.
+   *
+   *  Example:
+   *  \code
+   *  nt.forEachMatch(name, [&] (const Entry& nte) {
+   *    BOOST_ASSERT(nte.getName().isPrefixOf(name));
+   *    ...
+   *  });
+   *  \endcode
+   *  \warning The visitor must not insert or delete name tree entries.
+   */
+  template<typename Visitor>
+  void
+  forEachMatch(const Name& name, Visitor&& visitor) const
+  {
+    const Entry* nte = this->findLongestPrefixMatchImpl(name, AnyEntry());
+    for (; nte != nullptr; nte = nte->getParent()) {
+      visitor(*nte);
+    }
+  }
+
 public: // enumeration
   using const_iterator = Iterator;
 
@@ -254,6 +283,77 @@ public: // enumeration
   partialEnumerate(const Name& prefix,
                    const EntrySubTreeSelector& entrySubTreeSelector = AnyEntrySubTree()) const;
 
+  /** \brief Visit all entries
+   *  \tparam Visitor a callable with signature `void(const Entry&)`
+   *
+   *  Entries are visited in the same order as fullEnumerate(), but without allocating memory.
+   *  \warning The visitor must not insert or delete name tree entries.
+   */
+  template<typename Visitor>
+  void
+  forEachEntry(Visitor&& visitor) const
+  {
+    for (size_t bucket = 0; bucket < m_ht.getNBuckets(); ++bucket) {
+      for (const Node* node = m_ht.getBucket(bucket); node != nullptr; node = node->next) {
+        visitor(node->entry);
+      }
+    }
+  }
+
+  /** \brief Visit \p root and its descendants in pre-order
+   *  \tparam Visitor a callable with signature `void(const Entry&)` or `bool(const Entry&)`
+   *
+   *  If the visitor returns bool, its return value indicates whether the children of the
+   *  entry should be visited; this is selected at compile time, so that a visitor returning
+   *  void does not pay for pruning. No memory is allocated during the walk.
+   *  \warning The visitor must not insert or delete name tree entries.
+   */
+  template<typename Visitor>
+  void
+  forEachInSubTree(const Entry& root, Visitor&& visitor) const
+  {
+    using Result = std::invoke_result_t<Visitor&, const Entry&>;
+    static_assert(std::is_void_v<Result> || std::is_same_v<Result, bool>,
+                  "Visitor must return void or bool");
+
+    const Entry* entry = &root;
+    while (true) {
+      bool wantChildren = true;
+      if constexpr (std::is_void_v<Result>) {
+        visitor(*entry);
+      }
+      else {
+        wantChildren = visitor(*entry);
+      }
+
+      if (wantChildren && entry->hasChildren()) {
+        entry = entry->getFirstChild();
+        continue;
+      }
+
+      while (entry != &root && entry->getNextSibling() == nullptr) {
+        entry = entry->getParent();
+      }
+      if (entry == &root) {
+        return;
+      }
+      entry = entry->getNextSibling();
+    }
+  }
+
+  /** \brief Visit the entry of \p prefix and its descendants in pre-order
+   *  \sa forEachInSubTree(const Entry&, Visitor&&)
+   */
+  template<typename Visitor>
+  void
+  forEachInSubTree(const Name& prefix, Visitor&& visitor) const
+  {
+    const Entry* root = this->findExactMatch(prefix);
+    if (root != nullptr) {
+      this->forEachInSubTree(*root, std::forward<Visitor>(visitor));
+    }
+  }
+
   /** \return an iterator to the beginning
    *  \sa fullEnumerate
    */
@@ -272,6 +372,26 @@ public: // enumeration
     return Iterator();
   }
 
+private:
+  /** \brief Longest prefix matching without memory allocation
+   *  \tparam Pred a callable with signature `bool(const Entry&)`
+   */
+  template<typename Pred>
+  Entry*
+  findLongestPrefixMatchImpl(const Name& name, const Pred& pred) const
+  {
+    std::array<HashValue, getMaxDepth() + 1> hashes;
+    size_t nHashes = computeHashes(name, getMaxDepth(), hashes);
+
+    for (size_t i = nHashes; i-- > 0;) {
+      const Node* node = m_ht.find(name, i, hashes[i]);
+      if (node != nullptr && pred(node->entry)) {
+        return &node->entry;
+      }
+    }
+    return nullptr;
+  }
+
 private:
   Hashtable m_ht;
 
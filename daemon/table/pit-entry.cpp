@@ -77,11 +77,27 @@ Entry::canMatch(const Interest& interest, size_t nEqualNameComps) const
   /// \todo #3162 match ForwardingHint field
 }
 
+bool
+Entry::canMatchData(const Data& data, size_t nEqualNameComps) const
+{
+  const Name& interestName = m_interest->getName();
+  if (interestName.size() != nEqualNameComps) {
+    // Interest name ends with an implicit digest, exceeds NameTree depth limit,
+    // or has components that are not known to be equal
+    return m_interest->matchesData(data);
+  }
+
+  BOOST_ASSERT(interestName.isPrefixOf(data.getName()));
+  if (!m_interest->getCanBePrefix() && nEqualNameComps != data.getName().size()) {
+    return false;
+  }
+  return !m_interest->getMustBeFresh() || data.getFreshnessPeriod() > 0_ms;
+}
+
 InRecordCollection::iterator
 Entry::findInRecord(const Face& face) noexcept
 {
-  return std::find_if(m_inRecords.begin(), m_inRecords.end(),
-                      [&face] (const InRecord& inRecord) { return &inRecord.getFace() == &face; });
+  return m_inKeys.find(face, m_inRecords.end());
 }
 
 InRecordCollection::iterator
@@ -93,17 +109,21 @@ Entry::insertOrUpdateInRecord(Face& face, const Interest& interest)
   if (it == m_inRecords.end()) {
     m_inRecords.emplace_front(face);
     it = m_inRecords.begin();
+    m_inKeys.insert(it);
+    if (m_faceRecordIndex != nullptr) {
+      m_faceRecordIndex->insert(*this, *it);
+    }
   }
 
   it->update(interest);
+  m_inKeys.update(it);
   return it;
 }
 
 OutRecordCollection::iterator
 Entry::findOutRecord(const Face& face) noexcept
 {
-  return std::find_if(m_outRecords.begin(), m_outRecords.end(),
-                      [&face] (const OutRecord& outRecord) { return &outRecord.getFace() == &face; });
+  return m_outKeys.find(face, m_outRecords.end());
 }
 
 OutRecordCollection::iterator
@@ -115,20 +135,53 @@ Entry::insertOrUpdateOutRecord(Face& face, const Interest& interest)
   if (it == m_outRecords.end()) {
     m_outRecords.emplace_front(face);
     it = m_outRecords.begin();
+    m_outKeys.insert(it);
+    if (m_faceRecordIndex != nullptr) {
+      m_faceRecordIndex->insert(*this, *it);
+    }
   }
 
   it->update(interest);
+  m_outKeys.update(it);
   return it;
 }
 
 void
 Entry::deleteOutRecord(const Face& face)
 {
-  auto it = std::find_if(m_outRecords.begin(), m_outRecords.end(),
-                         [&face] (const OutRecord& outRecord) { return &outRecord.getFace() == &face; });
+  auto it = findOutRecord(face);
   if (it != m_outRecords.end()) {
+    m_outKeys.erase(face);
     m_outRecords.erase(it);
   }
 }
 
+void
+FaceRecordIndex::insert(Entry& entry, FaceRecord& record)
+{
+  BOOST_ASSERT(!record.m_faceHook.is_linked());
+  record.m_entry = &entry;
+  m_lists[&record.getFace()].push_back(record);
+}
+
+Entry*
+FaceRecordIndex::findEntry(const Face& face) const
+{
+  auto it = m_lists.find(&face);
+  if (it == m_lists.end() || it->second.empty()) {
+    return nullptr;
+  }
+  return it->second.front().m_entry;
+}
+
+void
+FaceRecordIndex::erase(const Face& face)
+{
+  auto it = m_lists.find(&face);
+  if (it != m_lists.end()) {
+    BOOST_ASSERT(it->second.empty());
+    m_lists.erase(it);
+  }
+}
+
 } // namespace nfd::pit
@@ -30,7 +30,13 @@
 
 #include <ndn-cxx/util/scheduler.hpp>
 
+#include <boost/container/small_vector.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <algorithm>
+#include <cstring>
 #include <list>
+#include <unordered_map>
 
 namespace nfd {
 
@@ -45,6 +51,9 @@ class Entry;
 
 namespace pit {
 
+class Entry;
+class FaceRecordIndex;
+
 /**
  * \brief Contains information about an Interest on an incoming or outgoing face.
  * \note This class is an implementation detail to extract common functionality
@@ -98,6 +107,12 @@ private:
   Interest::Nonce m_lastNonce{0, 0, 0, 0};
   time::steady_clock::time_point m_lastRenewed = time::steady_clock::time_point::min();
   time::steady_clock::time_point m_expiry = time::steady_clock::time_point::min();
+
+  // links the record into the FaceRecordIndex list of its face; unlinked automatically on destruction
+  boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> m_faceHook;
+  Entry* m_entry = nullptr;
+
+  friend FaceRecordIndex;
 };
 
 /**
@@ -182,6 +197,154 @@ using InRecordCollection = std::list<InRecord>;
  */
 using OutRecordCollection = std::list<OutRecord>;
 
+/**
+ * \brief The face and last Nonce of each record in a record collection, in a contiguous array.
+ *
+ * Looking up a record by face or by Nonce scans this array instead of walking the list nodes,
+ * which matters when a PIT entry has many records, e.g., with multicast. The Nonce scan has no
+ * data-dependent branches. The first few keys are stored inline, so that the common case of
+ * one or two records per PIT entry does not allocate. The order of the array is unrelated to
+ * the order of the list.
+ */
+template<typename Record>
+class RecordKeys
+{
+public:
+  using Iterator = typename std::list<Record>::iterator;
+
+  Iterator
+  find(const Face& face, Iterator end) const noexcept
+  {
+    auto it = findKey(face);
+    return it == m_keys.end() ? end : it->record;
+  }
+
+  /**
+   * \brief Compares \p nonce with the last Nonce of every record.
+   * \return whether a record of \p face has this Nonce,
+   *         and whether a record of another face has this Nonce
+   */
+  std::pair<bool, bool>
+  matchNonce(Interest::Nonce nonce, const Face& face) const noexcept
+  {
+    uint32_t nonceKey = toKey(nonce);
+    bool isSameFace = false;
+    bool isOtherFace = false;
+    for (const auto& key : m_keys) {
+      bool isMatch = key.nonce == nonceKey;
+      bool isFace = key.face == &face;
+      isSameFace |= isMatch & isFace;
+      isOtherFace |= isMatch & !isFace;
+    }
+    return {isSameFace, isOtherFace};
+  }
+
+  void
+  insert(Iterator record)
+  {
+    m_keys.push_back({&record->getFace(), toKey(record->getLastNonce()), record});
+  }
+
+  void
+  update(Iterator record) noexcept
+  {
+    auto it = findKey(record->getFace());
+    BOOST_ASSERT(it != m_keys.end());
+    it->nonce = toKey(record->getLastNonce());
+  }
+
+  void
+  erase(const Face& face) noexcept
+  {
+    auto it = findKey(face);
+    if (it == m_keys.end()) {
+      return;
+    }
+    *it = m_keys.back();
+    m_keys.pop_back();
+  }
+
+  void
+  clear() noexcept
+  {
+    m_keys.clear();
+  }
+
+private:
+  struct Key
+  {
+    const Face* face;
+    uint32_t nonce;
+    Iterator record;
+  };
+
+  using KeyVector = boost::container::small_vector<Key, 2>;
+
+  typename KeyVector::const_iterator
+  findKey(const Face& face) const noexcept
+  {
+    return std::find_if(m_keys.begin(), m_keys.end(),
+                        [&face] (const Key& key) { return key.face == &face; });
+  }
+
+  typename KeyVector::iterator
+  findKey(const Face& face) noexcept
+  {
+    return std::find_if(m_keys.begin(), m_keys.end(),
+                        [&face] (const Key& key) { return key.face == &face; });
+  }
+
+  static uint32_t
+  toKey(Interest::Nonce nonce) noexcept
+  {
+    uint32_t key;
+    static_assert(sizeof(key) == sizeof(nonce));
+    std::memcpy(&key, nonce.data(), sizeof(key));
+    return key;
+  }
+
+private:
+  KeyVector m_keys;
+};
+
+/**
+ * \brief Per-face lists of the in-records and out-records in a PIT.
+ *
+ * This allows finding the PIT entries that refer to a face without enumerating the PIT.
+ * Records are linked into the list of their face when they are created, and unlink themselves
+ * when they are destroyed.
+ */
+class FaceRecordIndex : noncopyable
+{
+public:
+  /**
+   * \brief Links \p record, which belongs to \p entry, into the list of its face.
+   */
+  void
+  insert(Entry& entry, FaceRecord& record);
+
+  /**
+   * \brief Returns a PIT entry that has an in-record or out-record for \p face,
+   *        or nullptr if there is none.
+   */
+  Entry*
+  findEntry(const Face& face) const;
+
+  /**
+   * \brief Releases the list of \p face.
+   * \pre The list is empty.
+   */
+  void
+  erase(const Face& face);
+
+private:
+  using RecordList = boost::intrusive::list<FaceRecord,
+    boost::intrusive::member_hook<FaceRecord, decltype(FaceRecord::m_faceHook), &FaceRecord::m_faceHook>,
+    boost::intrusive::constant_time_size<false>>;
+
+  std::unordered_map<const Face*, RecordList> m_lists;
+};
+
 /**
  * \brief Represents an entry in the %Interest table (PIT).
  *
@@ -225,6 +388,17 @@ public:
   bool
   canMatch(const Interest& interest, size_t nEqualNameComps = 0) const;
 
+  /** \return whether \p data satisfies the Interest of this entry
+   *  \param data the Data
+   *  \param nEqualNameComps number of initial name components guaranteed to be equal
+   *
+   *  This is equivalent to `getInterest().matchesData(data)`, but skips comparing the
+   *  name components that are known to be equal, e.g., the components of the NameTree
+   *  entry on which this PIT entry is attached.
+   */
+  bool
+  canMatchData(const Data& data, size_t nEqualNameComps = 0) const;
+
 public: // in-record
   /**
    * \brief Returns the collection of in-records.
@@ -277,6 +451,17 @@ public: // in-record
   InRecordCollection::iterator
   findInRecord(const Face& face) noexcept;
 
+  /**
+   * \brief Compares \p nonce with the last Nonce of every in-record.
+   * \return whether the in-record of \p face has this Nonce,
+   *         and whether an in-record of another face has this Nonce
+   */
+  std::pair<bool, bool>
+  matchInRecordNonce(Interest::Nonce nonce, const Face& face) const noexcept
+  {
+    return m_inKeys.matchNonce(nonce, face);
+  }
+
   /**
    * \brief Insert or update an in-record.
    * \return an iterator to the new or updated in-record
@@ -291,6 +476,7 @@ public: // in-record
   void
   deleteInRecord(InRecordCollection::const_iterator pos)
   {
+    m_inKeys.erase(pos->getFace());
     m_inRecords.erase(pos);
   }
 
@@ -300,6 +486,7 @@ public: // in-record
   void
   clearInRecords() noexcept
   {
+    m_inKeys.clear();
     m_inRecords.clear();
   }
 
@@ -356,6 +543,17 @@ public: // out-record
   OutRecordCollection::iterator
   findOutRecord(const Face& face) noexcept;
 
+  /**
+   * \brief Compares \p nonce with the last Nonce of every out-record.
+   * \return whether the out-record of \p face has this Nonce,
+   *         and whether an out-record of another face has this Nonce
+   */
+  std::pair<bool, bool>
+  matchOutRecordNonce(Interest::Nonce nonce, const Face& face) const noexcept
+  {
+    return m_outKeys.matchNonce(nonce, face);
+  }
+
   /**
    * \brief Insert or update an out-record.
    * \return an iterator to the new or updated out-record
@@ -389,10 +587,14 @@ private:
   shared_ptr<const Interest> m_interest;
   InRecordCollection m_inRecords;
   OutRecordCollection m_outRecords;
+  RecordKeys<InRecord> m_inKeys;
+  RecordKeys<OutRecord> m_outKeys;
 
   name_tree::Entry* m_nameTreeEntry = nullptr;
+  FaceRecordIndex* m_faceRecordIndex = nullptr;
 
   friend ::nfd::name_tree::Entry;
+  friend class Pit;
 };
 
 } // namespace pit
@@ -84,6 +84,7 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   }
 
   auto entry = make_shared<Entry>(interest);
+  entry->m_faceRecordIndex = &m_faceRecordIndex;
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
@@ -98,15 +99,14 @@ nteHasPitEntries(const name_tree::Entry& nte)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
-
   DataMatchResult matches;
-  for (const auto& nte : ntMatches) {
+  m_nameTree.forEachMatch(data.getName(), [&] (const name_tree::Entry& nte) {
     for (const auto& pitEntry : nte.getPitEntries()) {
-      if (pitEntry->getInterest().matchesData(data))
+      // NameTree guarantees the first nte.getDepth() components are equal
+      if (pitEntry->canMatchData(data, nte.getDepth()))
         matches.emplace_back(pitEntry);
     }
-  }
+  });
 
   return matches;
 }
@@ -138,6 +138,15 @@ Pit::deleteInOutRecords(Entry* entry, const Face& face)
   /// \todo decide whether to delete PIT entry if there's no more in/out-record left
 }
 
+void
+Pit::deleteInOutRecords(const Face& face)
+{
+  while (Entry* entry = m_faceRecordIndex.findEntry(face)) {
+    this->deleteInOutRecords(entry, face);
+  }
+  m_faceRecordIndex.erase(face);
+}
+
 Pit::const_iterator
 Pit::begin() const
 {
@@ -136,6 +136,14 @@ public:
   void
   deleteInOutRecords(Entry* entry, const Face& face);
 
+  /** \brief Deletes in-records and out-records for \p face in all entries
+   *
+   *  The entries are found through a per-face index, so the cost is proportional to the
+   *  number of entries that refer to \p face rather than to the size of the PIT.
+   */
+  void
+  deleteInOutRecords(const Face& face);
+
 public: // enumeration
   using const_iterator = Iterator;
 
@@ -174,6 +182,7 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  FaceRecordIndex m_faceRecordIndex;
 };
 
 } // namespace pit
@@ -60,6 +60,7 @@ StrategyChoice::setDefaultStrategy(const Name& strategyName)
   name_tree::Entry& nte = m_nameTree.lookup(Name());
   nte.setStrategyChoiceEntry(std::move(entry));
   ++m_nItems;
+  this->invalidateEffectiveStrategies();
 }
 
 StrategyChoice::InsertResult
@@ -106,6 +107,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(std::move(strategy));
+  this->invalidateEffectiveStrategies();
   return InsertResult::OK;
 }
 
@@ -155,6 +157,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(nullptr);
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
+  this->invalidateEffectiveStrategies();
 }
 
 std::pair<bool, Name>
@@ -182,22 +185,49 @@ StrategyChoice::findEffectiveStrategyImpl(const K& key) const
   return nte->getStrategyChoiceEntry()->getStrategy();
 }
 
+Strategy&
+StrategyChoice::findEffectiveStrategyImpl(const name_tree::Entry& nte) const
+{
+  Strategy* strategy = nte.getEffectiveStrategy(m_version);
+  if (strategy == nullptr) {
+    const name_tree::Entry* owner = m_nameTree.findLongestPrefixMatch(nte, &nteHasStrategyChoiceEntry);
+    BOOST_ASSERT(owner != nullptr);
+    strategy = &owner->getStrategyChoiceEntry()->getStrategy();
+    nte.setEffectiveStrategy(strategy, m_version);
+  }
+  return *strategy;
+}
+
 Strategy&
 StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 {
+  // a NameTree entry usually exists (e.g., the PIT entry of an Interest); its memoized
+  // effective strategy saves walking the NameTree with a hash computation per level
+  const name_tree::Entry* nte = m_nameTree.findExactMatch(prefix);
+  if (nte != nullptr) {
+    return this->findEffectiveStrategyImpl(*nte);
+  }
   return this->findEffectiveStrategyImpl(prefix);
 }
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
 {
+  const name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  BOOST_ASSERT(nte != nullptr);
+  if (nte->getDepth() == pitEntry.getName().size()) {
+    return this->findEffectiveStrategyImpl(*nte);
+  }
+  // PIT entry name either exceeds depth limit or ends with an implicit digest
   return this->findEffectiveStrategyImpl(pitEntry);
 }
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const measurements::Entry& measurementsEntry) const
 {
-  return this->findEffectiveStrategyImpl(measurementsEntry);
+  const name_tree::Entry* nte = m_nameTree.getEntry(measurementsEntry);
+  BOOST_ASSERT(nte != nullptr);
+  return this->findEffectiveStrategyImpl(*nte);
 }
 
 static inline void
@@ -238,19 +268,13 @@ StrategyChoice::changeStrategy(Entry& entry, Strategy& oldStrategy, Strategy& ne
   // where entry's effective strategy is covered by the changing StrategyChoice entry
   const name_tree::Entry* rootNte = m_nameTree.getEntry(entry);
   BOOST_ASSERT(rootNte != nullptr);
-  const auto& ntChanged = m_nameTree.partialEnumerate(entry.getPrefix(),
-    [&rootNte] (const name_tree::Entry& nte) -> std::pair<bool, bool> {
-      if (&nte == rootNte) {
-        return {true, true};
-      }
-      if (nte.getStrategyChoiceEntry() != nullptr) {
-        return {false, false};
-      }
-      return {true, true};
-    });
-  for (const auto& nte : ntChanged) {
+  m_nameTree.forEachInSubTree(*rootNte, [rootNte] (const name_tree::Entry& nte) {
+    if (&nte != rootNte && nte.getStrategyChoiceEntry() != nullptr) {
+      return false;
+    }
     clearStrategyInfo(nte);
-  }
+    return true;
+  });
 }
 
 StrategyChoice::Range
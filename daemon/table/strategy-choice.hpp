@@ -187,6 +187,21 @@ private:
   fw::Strategy&
   findEffectiveStrategyImpl(const K& key) const;
 
+  /** \brief Get effective strategy for \p nte, using the value memoized on \p nte if it is current
+   */
+  fw::Strategy&
+  findEffectiveStrategyImpl(const name_tree::Entry& nte) const;
+
+  /** \brief Invalidate effective strategies memoized on NameTree entries
+   *
+   *  This must be called whenever a StrategyChoice entry is added, removed, or changed.
+   */
+  void
+  invalidateEffectiveStrategies() noexcept
+  {
+    ++m_version;
+  }
+
   Range
   getRange() const;
 
@@ -194,6 +209,9 @@ private:
   Forwarder& m_forwarder;
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  /// Incremented on every change; effective strategies memoized under an older version are stale.
+  /// Starts at 1 so that a default-initialized NameTree entry never matches.
+  uint64_t m_version = 1;
 };
 
 std::ostream&
@@ -88,6 +88,39 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveNormal, T, DatagramTransportFixtures, T)
                     isUnicast);
 }
 
+using UnicastDatagramTransportFixtures = boost::mp11::mp_list<
+  GENERATE_IP_TRANSPORT_FIXTURE_INSTANTIATIONS(UnicastUdpTransportFixture)
+>;
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveQueued, T, UnicastDatagramTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // queue more datagrams than one receive batch before the transport gets to run,
+  // so that the socket is drained over several completions and ends on would_block
+  const size_t nPackets = 40;
+  std::vector<Block> pkts;
+  for (size_t i = 0; i < nPackets; ++i) {
+    pkts.push_back(ndn::encoding::makeNonNegativeIntegerBlock(300, i));
+    this->remoteSocket.send(boost::asio::buffer(pkts.back().data(), pkts.back().size()));
+  }
+  this->limitedIo.defer(1_s);
+
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, nPackets);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), nPackets);
+  for (size_t i = 0; i < nPackets; ++i) {
+    BOOST_CHECK(this->receivedPackets->at(i).packet == pkts[i]);
+  }
+
+  // the transport keeps receiving after the queue has been drained
+  auto last = ndn::encoding::makeStringBlock(301, "after");
+  this->remoteWrite(ndn::Buffer(last.begin(), last.end()));
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), nPackets + 1);
+  BOOST_CHECK(this->receivedPackets->back().packet == last);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveIncomplete, T, DatagramTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -72,6 +72,18 @@ public:
     m_sendQueueLength = sendQueueLength;
   }
 
+  std::optional<time::nanoseconds>
+  getSendQueueSojournTime() override
+  {
+    return m_sendQueueSojournTime;
+  }
+
+  void
+  setSendQueueSojournTime(std::optional<time::nanoseconds> sojournTime)
+  {
+    m_sendQueueSojournTime = sojournTime;
+  }
+
   void
   receivePacket(const Block& block)
   {
@@ -104,6 +116,7 @@ public:
 
 private:
   ssize_t m_sendQueueLength = 0;
+  std::optional<time::nanoseconds> m_sendQueueSojournTime;
 };
 
 using DummyTransport = DummyTransportBase<true>;
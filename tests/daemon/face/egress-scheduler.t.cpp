@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/egress-scheduler.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+#include <algorithm>
+
+namespace nfd::tests {
+
+using namespace nfd::face;
+
+class EgressSchedulerFixture : public GlobalIoTimeFixture
+{
+protected:
+  EgressSchedulerFixture()
+  {
+    options.rate = 10000;
+    options.burst = 2000;
+    options.queueLimit = 20000;
+    options.classes.push_back({"/A", 1});
+    options.classes.push_back({"/A/B", 3});
+  }
+
+  /** \brief Makes a packet with the given TLV-TYPE and a total size of 1000 octets.
+   */
+  static Block
+  makePacket(uint32_t type = 0xC8)
+  {
+    std::vector<uint8_t> value(996);
+    return ndn::makeBinaryBlock(type, value);
+  }
+
+  size_t
+  countSent(uint32_t type) const
+  {
+    return std::count_if(sentPackets.begin(), sentPackets.end(),
+                         [type] (const Block& b) { return b.type() == type; });
+  }
+
+protected:
+  EgressScheduler::Options options;
+  std::vector<Block> sentPackets;
+  EgressScheduler scheduler{{}, [this] (const Block& packet) { sentPackets.push_back(packet); }};
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestEgressScheduler, EgressSchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  BOOST_CHECK(!scheduler.isEnabled());
+  for (int i = 0; i < 100; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(), 0));
+  }
+  BOOST_CHECK_EQUAL(sentPackets.size(), 100);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Classify)
+{
+  scheduler.setOptions(options);
+  BOOST_CHECK_EQUAL(scheduler.classify("/"), 0);
+  BOOST_CHECK_EQUAL(scheduler.classify("/C/A"), 0);
+  BOOST_CHECK_EQUAL(scheduler.classify("/A"), 1);
+  BOOST_CHECK_EQUAL(scheduler.classify("/A/C"), 1);
+  BOOST_CHECK_EQUAL(scheduler.classify("/A/B"), 2);
+  BOOST_CHECK_EQUAL(scheduler.classify("/A/B/C"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(RateLimit)
+{
+  scheduler.setOptions(options);
+  BOOST_CHECK(scheduler.isEnabled());
+
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(), 0));
+  }
+  // the full bucket allows a burst of two packets
+  BOOST_CHECK_EQUAL(sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 8000);
+
+  // one packet per 100 ms afterwards
+  this->advanceClocks(10_ms, 100_ms);
+  BOOST_CHECK_EQUAL(sentPackets.size(), 3);
+  this->advanceClocks(10_ms, 700_ms);
+  BOOST_CHECK_EQUAL(sentPackets.size(), 10);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 0);
+
+  // the bucket does not grow beyond its depth while idle
+  this->advanceClocks(100_ms, 5_s);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(), 0));
+  }
+  BOOST_CHECK_EQUAL(sentPackets.size(), 12);
+}
+
+BOOST_AUTO_TEST_CASE(QueueLimit)
+{
+  scheduler.setOptions(options);
+
+  for (int i = 0; i < 22; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(), 0));
+  }
+  BOOST_CHECK_EQUAL(sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 20000);
+
+  // the default class is full, but other classes have their own limits
+  BOOST_CHECK(!scheduler.enqueue(makePacket(), 0));
+  BOOST_CHECK(scheduler.enqueue(makePacket(), 1));
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 21000);
+}
+
+BOOST_AUTO_TEST_CASE(WeightedShare)
+{
+  options.rate = 100000;
+  options.burst = ndn::MAX_NDN_PACKET_SIZE;
+  options.queueLimit = 200000;
+  scheduler.setOptions(options);
+
+  // a bulk transfer in the default class fills the link before other traffic arrives
+  for (int i = 0; i < 200; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(0xC8), 0));
+  }
+  for (int i = 0; i < 200; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(0xC9), 2));
+  }
+  sentPackets.clear();
+
+  this->advanceClocks(10_ms, 2_s);
+  size_t nDefault = countSent(0xC8);
+  size_t nWeighted = countSent(0xC9);
+  BOOST_CHECK_EQUAL(nDefault + nWeighted, 200);
+  // 1:3 share, within one round of the schedule
+  BOOST_CHECK_GE(nWeighted, 140);
+  BOOST_CHECK_LE(nWeighted, 160);
+
+  // all queued packets are eventually sent
+  this->advanceClocks(10_ms, 2_s);
+  BOOST_CHECK_EQUAL(countSent(0xC8), 192);
+  BOOST_CHECK_EQUAL(countSent(0xC9), 200);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SetOptionsFlushes)
+{
+  scheduler.setOptions(options);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(), 0));
+  }
+  BOOST_CHECK_EQUAL(sentPackets.size(), 2);
+
+  scheduler.setOptions({});
+  BOOST_CHECK(!scheduler.isEnabled());
+  BOOST_CHECK_EQUAL(sentPackets.size(), 10);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 0);
+
+  // no further transmission is scheduled from the old queues
+  this->advanceClocks(100_ms, 2_s);
+  BOOST_CHECK_EQUAL(sentPackets.size(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(SetOptionsUnchanged)
+{
+  scheduler.setOptions(options);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(), 0));
+  }
+  BOOST_CHECK_EQUAL(sentPackets.size(), 2);
+
+  // e.g., a config reload: the backlog stays queued and the bucket is not refilled
+  scheduler.setOptions(options);
+  BOOST_CHECK_EQUAL(sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 8000);
+
+  this->advanceClocks(10_ms, 100_ms);
+  BOOST_CHECK_EQUAL(sentPackets.size(), 3);
+  this->advanceClocks(10_ms, 700_ms);
+  BOOST_CHECK_EQUAL(sentPackets.size(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(SetOptionsRemovedClass)
+{
+  scheduler.setOptions(options);
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK(scheduler.enqueue(makePacket(0xC8), 0));
+    BOOST_CHECK(scheduler.enqueue(makePacket(0xC9), 1));
+    BOOST_CHECK(scheduler.enqueue(makePacket(0xCA), 2));
+  }
+  BOOST_CHECK_EQUAL(sentPackets.size(), 2);
+  sentPackets.clear();
+  size_t queued = scheduler.getQueueLength();
+
+  // class /A is removed, class /A/B moves to a different index
+  options.classes.erase(options.classes.begin());
+  scheduler.setOptions(options);
+  BOOST_CHECK_EQUAL(countSent(0xC8), 0);
+  BOOST_CHECK_EQUAL(countSent(0xCA), 0);
+  size_t nFlushed = countSent(0xC9);
+  BOOST_CHECK_GT(nFlushed, 0);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), queued - nFlushed * 1000);
+  BOOST_CHECK_EQUAL(scheduler.classify("/A/B"), 1);
+
+  // the remaining packets are sent at the configured rate
+  this->advanceClocks(10_ms, 100_ms);
+  BOOST_CHECK_EQUAL(sentPackets.size(), nFlushed + 1);
+  this->advanceClocks(10_ms, 2_s);
+  BOOST_CHECK_EQUAL(countSent(0xC8), 3);
+  BOOST_CHECK_EQUAL(countSent(0xCA), 4);
+  BOOST_CHECK_EQUAL(scheduler.getQueueLength(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestEgressScheduler
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -24,7 +24,9 @@
  */
 
 #include "face/face-system.hpp"
+#include "face/generic-link-service.hpp"
 #include "face-system-fixture.hpp"
+#include "dummy-transport.hpp"
 
 #include "tests/test-common.hpp"
 
@@ -159,6 +161,134 @@ BOOST_AUTO_TEST_CASE(ChangeProvidedSchemes)
   BOOST_CHECK_EQUAL(faceSystem.getFactoryByScheme("s3"), f1);
 }
 
+BOOST_AUTO_TEST_CASE(Egress)
+{
+  auto makeFace = [] (ndn::nfd::FaceScope scope) {
+    return make_shared<Face>(make_unique<GenericLinkService>(),
+                             make_unique<DummyTransport>("dummy://", "dummy://", scope));
+  };
+  auto getEgressOptions = [] (const Face& face) {
+    return static_cast<GenericLinkService*>(face.getLinkService())->getOptions().egressOptions;
+  };
+
+  auto nonLocalFace = makeFace(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto localFace = makeFace(ndn::nfd::FACE_SCOPE_LOCAL);
+  faceTable.add(nonLocalFace);
+  faceTable.add(localFace);
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      egress
+      {
+        rate 1250000
+        burst 20000
+        queue_limit 100000
+        class
+        {
+          prefix /A
+          weight 4
+        }
+        class
+        {
+          prefix /B
+        }
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(getEgressOptions(*nonLocalFace).rate, 0);
+
+  parseConfig(CONFIG, false);
+  auto options = getEgressOptions(*nonLocalFace);
+  BOOST_CHECK_EQUAL(options.rate, 1250000);
+  BOOST_CHECK_EQUAL(options.burst, 20000);
+  BOOST_CHECK_EQUAL(options.queueLimit, 100000);
+  BOOST_REQUIRE_EQUAL(options.classes.size(), 2);
+  BOOST_CHECK_EQUAL(options.classes[0].prefix, "/A");
+  BOOST_CHECK_EQUAL(options.classes[0].weight, 4);
+  BOOST_CHECK_EQUAL(options.classes[1].prefix, "/B");
+  BOOST_CHECK_EQUAL(options.classes[1].weight, 1);
+  BOOST_CHECK_EQUAL(getEgressOptions(*localFace).rate, 0);
+
+  // faces created after the configuration is loaded get the same options
+  auto newFace = makeFace(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  faceTable.add(newFace);
+  BOOST_CHECK_EQUAL(getEgressOptions(*newFace).rate, 1250000);
+
+  // omitting the section disables egress scheduling
+  parseConfig("face_system\n{\n}\n", false);
+  BOOST_CHECK_EQUAL(getEgressOptions(*nonLocalFace).rate, 0);
+  BOOST_CHECK_EQUAL(getEgressOptions(*newFace).rate, 0);
+}
+
+BOOST_AUTO_TEST_CASE(CongestionDetection)
+{
+  auto face = make_shared<Face>(make_unique<GenericLinkService>(),
+                                make_unique<DummyTransport>("dummy://", "dummy://",
+                                                            ndn::nfd::FACE_SCOPE_LOCAL));
+  faceTable.add(face);
+  auto linkService = static_cast<GenericLinkService*>(face->getLinkService());
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        congestion_detection sojourn_time
+        congestion_target_delay 20
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  BOOST_CHECK(!linkService->getOptions().wantSojournTimeCongestionDetection);
+
+  parseConfig(CONFIG, false);
+  BOOST_CHECK(linkService->getOptions().wantSojournTimeCongestionDetection);
+  BOOST_CHECK_EQUAL(linkService->getOptions().congestionTargetDelay, 20_ms);
+
+  const std::string BAD_MODE = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        congestion_detection pie
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(BAD_MODE, true), ConfigFile::Error);
+
+  const std::string BAD_TARGET = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        congestion_target_delay 0
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(BAD_TARGET, true), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(BadEgress)
+{
+  auto checkBad = [this] (const std::string& egressSection) {
+    const std::string config = "face_system\n{\n  egress\n  {\n" + egressSection + "\n  }\n}\n";
+    BOOST_CHECK_THROW(parseConfig(config, true), ConfigFile::Error);
+    BOOST_CHECK_THROW(parseConfig(config, false), ConfigFile::Error);
+  };
+
+  checkBad("rate -1");
+  checkBad("burst 100");
+  checkBad("queue_limit 100");
+  checkBad("class\n{\nweight 2\n}");
+  checkBad("class\n{\nprefix /A\nweight 0\n}");
+  checkBad("class\n{\nprefix /A\nshare 2\n}");
+  checkBad("unknown 1");
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestFaceSystem
@@ -898,8 +898,142 @@ BOOST_AUTO_TEST_CASE(DefaultThreshold)
   BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
 }
 
+BOOST_AUTO_TEST_CASE(SojournTime)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = true;
+  options.baseCongestionMarkingInterval = 100_ms;
+  options.wantSojournTimeCongestionDetection = true;
+  options.congestionTargetDelay = 5_ms;
+  initialize(options, MTU_UNLIMITED, 65536);
+
+  auto interest = makeInterest("/12345678");
+
+  // a long queue that drains quickly is not congested
+  transport->setSendQueueLength(500000);
+  transport->setSendQueueSojournTime(4_ms);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::time_point::max());
+
+  // a short queue whose packets wait longer than the target is congested
+  transport->setSendQueueLength(1000);
+  transport->setSendQueueSojournTime(6_ms);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::now() + 100_ms);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+
+  this->advanceClocks(1_ms, 100_ms);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 3);
+  lp::Packet pkt(transport->sentPackets.back());
+  BOOST_CHECK_EQUAL(pkt.count<lp::CongestionMarkField>(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 1);
+
+  // congestion ends when the sojourn time drops below the target
+  transport->setSendQueueSojournTime(1_ms);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::time_point::max());
+  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
+}
+
+BOOST_AUTO_TEST_CASE(SojournTimeEstimated)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = true;
+  options.baseCongestionMarkingInterval = 100_ms;
+  options.wantSojournTimeCongestionDetection = true;
+  options.congestionTargetDelay = 5_ms;
+  initialize(options, MTU_UNLIMITED, 65536);
+
+  auto interest = makeInterest("/12345678");
+
+  // the transport reports only the queue length, e.g., from SIOCOUTQ on a UDP socket;
+  // the delay is unknown until the drain rate has been measured
+  transport->setSendQueueLength(20000);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(service->m_drainRate, 0.0);
+  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::time_point::max());
+
+  // 10000 bytes plus one Interest drained in 10 ms: about 1 MB/s, so 10000 bytes take 10 ms
+  this->advanceClocks(10_ms);
+  transport->setSendQueueLength(10000);
+  face->sendInterest(*interest);
+  BOOST_CHECK_GT(service->m_drainRate, 1000000.0);
+  BOOST_CHECK_LT(service->m_drainRate, 1010000.0);
+  BOOST_CHECK_NE(service->m_nextMarkTime, time::steady_clock::time_point::max());
+
+  // 4000 bytes take about 4 ms, which is below the target
+  transport->setSendQueueLength(4000);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::time_point::max());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // CongestionMark
 
+BOOST_AUTO_TEST_SUITE(Egress)
+
+BOOST_AUTO_TEST_CASE(RateLimitAndClasses)
+{
+  GenericLinkService::Options options;
+  options.egressOptions.rate = 1000;
+  options.egressOptions.burst = 1000;
+  options.egressOptions.queueLimit = 500;
+  options.egressOptions.classes.push_back({"/voice", 4});
+  initialize(options);
+
+  auto bulk = makeInterest("/bulk");
+  for (int i = 0; i < 100; ++i) {
+    face->sendInterest(*bulk);
+  }
+  size_t nSentImmediately = transport->sentPackets.size();
+  BOOST_CHECK_GT(nSentImmediately, 0);
+  BOOST_CHECK_LT(nSentImmediately, 100);
+  BOOST_CHECK_GT(service->getCounters().nEgressDropped, 0);
+  BOOST_CHECK_LT(nSentImmediately + service->getCounters().nEgressDropped, 100);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutInterests, 100);
+
+  // the /voice class has its own queue, which is not full
+  size_t nDropped = service->getCounters().nEgressDropped;
+  face->sendInterest(*makeInterest("/voice/frame"));
+  BOOST_CHECK_EQUAL(service->getCounters().nEgressDropped, nDropped);
+
+  // queued packets leave at the configured rate
+  this->advanceClocks(100_ms, 5_s);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size() + nDropped, 101);
+  auto isVoice = [] (const Block& packet) {
+    auto [begin, end] = lp::Packet(packet).get<lp::FragmentField>();
+    Interest interest(Block(span<const uint8_t>(&*begin, std::distance(begin, end))));
+    return interest.getName() == "/voice/frame";
+  };
+  BOOST_CHECK_EQUAL(std::count_if(transport->sentPackets.begin(), transport->sentPackets.end(), isVoice), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SetOptionsKeepsBacklog)
+{
+  GenericLinkService::Options options;
+  options.egressOptions.rate = 1000;
+  options.egressOptions.burst = 1000;
+  initialize(options);
+
+  auto interest = makeInterest("/bulk");
+  for (int i = 0; i < 100; ++i) {
+    face->sendInterest(*interest);
+  }
+  size_t nSent = transport->sentPackets.size();
+  BOOST_CHECK_LT(nSent, 100);
+
+  // reapplying the same options, as a config reload does, must not release the backlog
+  service->setOptions(options);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), nSent);
+
+  // disabling the scheduler does
+  options.egressOptions.rate = 0;
+  service->setOptions(options);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Egress
+
 BOOST_AUTO_TEST_SUITE(LpFields)
 
 BOOST_AUTO_TEST_CASE(ReceiveNextHopFaceId)
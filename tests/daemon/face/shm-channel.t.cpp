@@ -0,0 +1,326 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "face/shm-channel.hpp"
+#include "face/shm-segment.hpp"
+
+#include "channel-fixture.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace nfd::tests {
+
+namespace fs = boost::filesystem;
+namespace local = boost::asio::local;
+using face::ShmChannel;
+using face::shm::Ring;
+using face::shm::SegmentHeader;
+
+/**
+ * \brief The application side of a shared-memory face.
+ */
+class ShmClient : noncopyable
+{
+public:
+  explicit
+  ShmClient(boost::asio::io_context& io)
+    : socket(io)
+  {
+  }
+
+  ~ShmClient()
+  {
+    if (header != nullptr) {
+      ::munmap(header, segmentSize);
+    }
+    for (int fd : fds) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+  }
+
+  /**
+   * \brief Receives the segment from the channel, blocking until it arrives.
+   */
+  void
+  receiveSegment()
+  {
+    uint64_t payload = 0;
+    iovec iov{&payload, sizeof(payload)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    BOOST_REQUIRE_EQUAL(::recvmsg(socket.native_handle(), &msg, 0), sizeof(payload));
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    BOOST_REQUIRE(cmsg != nullptr);
+    BOOST_REQUIRE_EQUAL(cmsg->cmsg_type, SCM_RIGHTS);
+    BOOST_REQUIRE_EQUAL(cmsg->cmsg_len, CMSG_LEN(sizeof(fds)));
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+    segmentSize = payload;
+    void* addr = ::mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    BOOST_REQUIRE(addr != MAP_FAILED);
+    header = static_cast<SegmentHeader*>(addr);
+    BOOST_REQUIRE_EQUAL(header->magic, face::shm::MAGIC);
+    nSlots = header->nSlots;
+  }
+
+  Ring
+  getRing(Ring::Direction direction)
+  {
+    return Ring(*header, direction, nSlots);
+  }
+
+  void
+  send(const Block& packet)
+  {
+    Ring ring = getRing(Ring::TO_FORWARDER);
+    BOOST_REQUIRE(ring.push(packet));
+    if (ring.needsNotify()) {
+      ::eventfd_write(fds[1 + Ring::TO_FORWARDER], 1);
+    }
+  }
+
+  std::optional<Block>
+  receive()
+  {
+    Ring ring = getRing(Ring::FROM_FORWARDER);
+    auto packet = ring.front();
+    if (packet.empty()) {
+      return std::nullopt;
+    }
+    Block block(packet);
+    ring.pop();
+    return block;
+  }
+
+  bool
+  wasNotified()
+  {
+    eventfd_t count = 0;
+    return ::eventfd_read(fds[1 + Ring::FROM_FORWARDER], &count) == 0 && count > 0;
+  }
+
+public:
+  local::stream_protocol::socket socket;
+  /// memfd, eventfd of TO_FORWARDER, eventfd of FROM_FORWARDER
+  int fds[3] = {-1, -1, -1};
+  SegmentHeader* header = nullptr;
+  size_t segmentSize = 0;
+  uint32_t nSlots = 0;
+};
+
+class ShmChannelFixture : public ChannelFixture<ShmChannel, face::shm::Endpoint>
+{
+protected:
+  ShmChannelFixture()
+  {
+    listenerEp = face::shm::Endpoint(socketPath.string());
+  }
+
+  ~ShmChannelFixture() override
+  {
+    boost::system::error_code ec;
+    fs::remove_all(testDir, ec); // ignore error
+  }
+
+  shared_ptr<ShmChannel>
+  makeChannel() final
+  {
+    return std::make_shared<ShmChannel>(listenerEp, 16, false);
+  }
+
+  void
+  listen()
+  {
+    listenerChannel = makeChannel();
+    listenerChannel->listen(
+      [this] (const shared_ptr<Face>& newFace) {
+        BOOST_REQUIRE(newFace != nullptr);
+        connectFaceClosedSignal(*newFace, [this] { limitedIo.afterOp(); });
+        listenerFaces.push_back(newFace);
+        limitedIo.afterOp();
+      },
+      ChannelFixture::unexpectedFailure);
+  }
+
+  void
+  clientConnect(ShmClient& client)
+  {
+    client.socket.connect(listenerEp);
+    BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+    client.receiveSegment();
+  }
+
+protected:
+  static inline const fs::path testDir = fs::path(UNIT_TESTS_TMPDIR) / "shm-channel";
+  static inline const fs::path socketPath = testDir / "test" / "foo.sock";
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestShmChannel, ShmChannelFixture)
+
+BOOST_AUTO_TEST_CASE(Uri)
+{
+  auto channel = makeChannel();
+  BOOST_CHECK_EQUAL(channel->getUri(), FaceUri("shm://" + socketPath.string()));
+}
+
+BOOST_AUTO_TEST_CASE(Listen)
+{
+  auto channel = makeChannel();
+  BOOST_CHECK_EQUAL(channel->isListening(), false);
+
+  channel->listen(nullptr, nullptr);
+  BOOST_CHECK_EQUAL(channel->isListening(), true);
+  BOOST_CHECK_EQUAL(fs::symlink_status(socketPath).type(), fs::socket_file);
+
+  // listen() is idempotent
+  channel->listen(nullptr, nullptr);
+  BOOST_CHECK_EQUAL(channel->isListening(), true);
+
+  channel.reset();
+  BOOST_CHECK_EQUAL(fs::symlink_status(socketPath).type(), fs::file_not_found);
+}
+
+BOOST_AUTO_TEST_CASE(ExchangePackets)
+{
+  this->listen();
+  ShmClient client(g_io);
+  this->clientConnect(client);
+
+  BOOST_REQUIRE_EQUAL(listenerFaces.size(), 1);
+  auto face = listenerFaces.front();
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 1);
+  BOOST_CHECK_EQUAL(face->getScope(), ndn::nfd::FACE_SCOPE_LOCAL);
+  BOOST_CHECK_EQUAL(face->getPersistency(), ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+  BOOST_CHECK_EQUAL(face->getLinkType(), ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  BOOST_CHECK_EQUAL(face->getLocalUri(), listenerChannel->getUri());
+  BOOST_CHECK_EQUAL(face->getChannel().lock(), listenerChannel);
+
+  // application to NFD
+  std::vector<Interest> receivedInterests;
+  face->afterReceiveInterest.connect([&] (const Interest& interest, const EndpointId&) {
+    receivedInterests.push_back(interest);
+    limitedIo.afterOp();
+  });
+  // fill the ring twice, so that it wraps around
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < 16; ++i) {
+      client.send(makeInterest(Name("/shm").appendNumber(round * 16 + i))->wireEncode());
+    }
+    BOOST_CHECK_EQUAL(limitedIo.run(16, 1_s), LimitedIo::EXCEED_OPS);
+  }
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 32);
+  BOOST_CHECK_EQUAL(receivedInterests.back().getName(), Name("/shm").appendNumber(31));
+
+  // NFD to application, without notification while the application is busy
+  face->sendData(*makeData("/shm/data1"));
+  BOOST_CHECK(!client.wasNotified());
+  auto received = client.receive();
+  BOOST_REQUIRE(received);
+  lp::Packet lpPacket(*received);
+  auto [begin, end] = lpPacket.get<lp::FragmentField>();
+  Block fragment(span<const uint8_t>(&*begin, static_cast<size_t>(end - begin)));
+  BOOST_CHECK_EQUAL(Data(fragment).getName(), "/shm/data1");
+  BOOST_CHECK(!client.receive());
+
+  // NFD to application, with notification once the application waits
+  client.getRing(Ring::FROM_FORWARDER).prepareWait();
+  face->sendData(*makeData("/shm/data2"));
+  BOOST_CHECK(client.wasNotified());
+  BOOST_CHECK(client.receive());
+}
+
+BOOST_AUTO_TEST_CASE(CorruptedRing)
+{
+  this->listen();
+  ShmClient client(g_io);
+  this->clientConnect(client);
+  BOOST_REQUIRE_EQUAL(listenerFaces.size(), 1);
+
+  client.header->rings[Ring::TO_FORWARDER].head = 1000;
+  ::eventfd_write(client.fds[1 + Ring::TO_FORWARDER], 1);
+
+  BOOST_CHECK_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(listenerFaces.front()->getState(), face::FaceState::CLOSED);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AlteredSlotCount)
+{
+  this->listen();
+  ShmClient client(g_io);
+  this->clientConnect(client);
+  BOOST_REQUIRE_EQUAL(listenerFaces.size(), 1);
+  auto face = listenerFaces.front();
+
+  // NFD keeps using the slot count it created the segment with
+  client.header->nSlots = 0xFFFFFFFF;
+  for (int i = 0; i < 20; ++i) {
+    face->sendData(*makeData(Name("/shm").appendNumber(i)));
+  }
+  int nReceived = 0;
+  while (client.receive()) {
+    ++nReceived;
+  }
+  BOOST_CHECK_EQUAL(nReceived, 16);
+
+  client.header->nSlots = 0;
+  face->sendData(*makeData("/shm/after"));
+  BOOST_CHECK(client.receive());
+  BOOST_CHECK_EQUAL(face->getState(), face::FaceState::UP);
+}
+
+BOOST_AUTO_TEST_CASE(ApplicationDisconnects)
+{
+  this->listen();
+  ShmClient client(g_io);
+  this->clientConnect(client);
+  BOOST_REQUIRE_EQUAL(listenerFaces.size(), 1);
+
+  client.socket.close();
+  BOOST_CHECK_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(listenerFaces.front()->getState(), face::FaceState::CLOSED);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmChannel
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "face/shm-factory.hpp"
+
+#include "face-system-fixture.hpp"
+#include "factory-test-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace nfd::tests {
+
+using ShmFactoryFixture = FaceSystemFactoryFixture<face::ShmFactory>;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestShmFactory, ShmFactoryFixture)
+
+BOOST_AUTO_TEST_SUITE(ProcessConfig)
+
+BOOST_AUTO_TEST_CASE(Normal)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      shm
+      {
+        path nfd-shm-test.sock
+        ring_size 1024
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  BOOST_REQUIRE_EQUAL(factory.getChannels().size(), 1);
+  BOOST_TEST(factory.getChannels().front()->isListening());
+
+  const auto& uri = factory.getChannels().front()->getUri();
+  BOOST_TEST(uri.getScheme() == "shm");
+  boost::filesystem::path path(uri.getPath());
+  BOOST_TEST(path.filename() == "nfd-shm-test.sock");
+  BOOST_TEST(boost::filesystem::equivalent(path, "nfd-shm-test.sock"));
+}
+
+BOOST_AUTO_TEST_CASE(Omitted)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  BOOST_CHECK_EQUAL(factory.getChannels().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(BadRingSize)
+{
+  auto makeConfig = [] (const std::string& ringSize) {
+    return R"CONFIG(
+      face_system
+      {
+        shm
+        {
+          path nfd-shm-test.sock
+          ring_size )CONFIG" + ringSize + R"CONFIG(
+        }
+      }
+    )CONFIG";
+  };
+
+  BOOST_CHECK_THROW(parseConfig(makeConfig("8"), true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(makeConfig("131072"), true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(makeConfig("8192"), true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(makeConfig("1000"), true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(makeConfig("foo"), true), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(UnknownOption)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      shm
+      {
+        hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
+
+BOOST_AUTO_TEST_CASE(CreateChannel)
+{
+  auto channel1 = factory.createChannel("shm-test.1.sock");
+  auto channel1a = factory.createChannel("./shm-test.1.sock");
+  BOOST_CHECK_EQUAL(channel1, channel1a);
+
+  auto channel2 = factory.createChannel("shm-test.2.sock");
+  BOOST_CHECK_NE(channel1, channel2);
+  BOOST_CHECK_EQUAL(factory.getChannels().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(CreateFace)
+{
+  createFace(factory,
+             FaceUri("shm:///run/nfd/nfd-shm.sock"),
+             {},
+             {ndn::nfd::FACE_PERSISTENCY_PERSISTENT, {}, {}, {}, false, false, false},
+             {CreateFaceExpectedResult::FAILURE, 406, "Unsupported protocol"});
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmFactory
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
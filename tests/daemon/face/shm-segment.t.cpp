@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "face/shm-segment.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <sys/mman.h>
+
+namespace nfd::tests {
+
+using namespace nfd::face::shm;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestShmSegment)
+
+BOOST_AUTO_TEST_CASE(Layout)
+{
+  Segment segment(16);
+  BOOST_CHECK_EQUAL(segment.getNSlots(), 16);
+  BOOST_CHECK_EQUAL(segment.size(), computeSegmentSize(16));
+  BOOST_CHECK_GE(Ring::getSlotCapacity(), ndn::MAX_NDN_PACKET_SIZE);
+  BOOST_CHECK_GE(segment.getMemfd(), 0);
+  BOOST_CHECK_GE(segment.getEventFd(Ring::TO_FORWARDER), 0);
+  BOOST_CHECK_GE(segment.getEventFd(Ring::FROM_FORWARDER), 0);
+
+  // the memfd is what the application maps
+  void* addr = ::mmap(nullptr, segment.size(), PROT_READ, MAP_SHARED, segment.getMemfd(), 0);
+  BOOST_REQUIRE(addr != MAP_FAILED);
+  const auto* header = static_cast<const SegmentHeader*>(addr);
+  BOOST_CHECK_EQUAL(header->magic, MAGIC);
+  BOOST_CHECK_EQUAL(header->version, VERSION);
+  BOOST_CHECK_EQUAL(header->nSlots, 16);
+  BOOST_CHECK_EQUAL(header->slotSize, SLOT_SIZE);
+  ::munmap(addr, segment.size());
+}
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  Segment segment(16);
+  Ring producer = segment.getRing(Ring::TO_FORWARDER);
+  Ring consumer = segment.getRing(Ring::TO_FORWARDER);
+  Ring other = segment.getRing(Ring::FROM_FORWARDER);
+
+  BOOST_CHECK(consumer.front().empty());
+
+  // wrap around several times
+  for (uint8_t i = 0; i < 40; ++i) {
+    const uint8_t packet[] = {0x05, 0x01, i};
+    BOOST_REQUIRE(producer.push(packet));
+    auto received = consumer.front();
+    BOOST_TEST(received == packet, boost::test_tools::per_element());
+    consumer.pop();
+    BOOST_CHECK(consumer.front().empty());
+  }
+  BOOST_CHECK_EQUAL(producer.getTail(), 40);
+  BOOST_CHECK(other.front().empty());
+}
+
+BOOST_AUTO_TEST_CASE(Full)
+{
+  Segment segment(16);
+  Ring ring = segment.getRing(Ring::FROM_FORWARDER);
+
+  const uint8_t packet[] = {0x06, 0x00};
+  for (int i = 0; i < 16; ++i) {
+    BOOST_CHECK(ring.push(packet));
+  }
+  BOOST_CHECK(!ring.push(packet));
+
+  ring.pop();
+  BOOST_CHECK(ring.push(packet));
+  BOOST_CHECK(!ring.push(packet));
+}
+
+BOOST_AUTO_TEST_CASE(Notify)
+{
+  Segment segment(16);
+  Ring ring = segment.getRing(Ring::TO_FORWARDER);
+  const uint8_t packet[] = {0x05, 0x00};
+
+  BOOST_CHECK(!ring.needsNotify());
+  BOOST_CHECK(ring.prepareWait());
+  BOOST_CHECK(ring.needsNotify());
+  ring.cancelWait();
+  BOOST_CHECK(!ring.needsNotify());
+
+  // a packet that arrives before the consumer waits withdraws the request
+  BOOST_CHECK(ring.push(packet));
+  BOOST_CHECK(!ring.prepareWait());
+  BOOST_CHECK(!ring.needsNotify());
+}
+
+BOOST_AUTO_TEST_CASE(Corrupted)
+{
+  Segment segment(16);
+  void* addr = ::mmap(nullptr, segment.size(), PROT_READ | PROT_WRITE, MAP_SHARED, segment.getMemfd(), 0);
+  BOOST_REQUIRE(addr != MAP_FAILED);
+  auto* header = static_cast<SegmentHeader*>(addr);
+  Ring ring = segment.getRing(Ring::TO_FORWARDER);
+
+  header->rings[Ring::TO_FORWARDER].head = 17;
+  BOOST_CHECK_THROW(ring.front(), Ring::Error);
+
+  const uint8_t packet[] = {0x05, 0x00};
+  header->rings[Ring::TO_FORWARDER].head = 0;
+  BOOST_REQUIRE(ring.push(packet));
+  auto* slot = reinterpret_cast<uint8_t*>(header + 1);
+  uint32_t length = SLOT_SIZE;
+  std::memcpy(slot, &length, sizeof(length));
+  BOOST_CHECK_THROW(ring.front(), Ring::Error);
+
+  ::munmap(addr, segment.size());
+}
+
+BOOST_AUTO_TEST_CASE(PrivateSlotCount)
+{
+  Segment segment(16);
+  void* addr = ::mmap(nullptr, segment.size(), PROT_READ | PROT_WRITE, MAP_SHARED, segment.getMemfd(), 0);
+  BOOST_REQUIRE(addr != MAP_FAILED);
+  auto* header = static_cast<SegmentHeader*>(addr);
+
+  // the peer can write the slot count, but the segment does not read it back
+  header->nSlots = 0xFFFFFFFF;
+  BOOST_CHECK_EQUAL(segment.getNSlots(), 16);
+
+  Ring ring = segment.getRing(Ring::FROM_FORWARDER);
+  const uint8_t packet[] = {0x05, 0x00};
+  for (int i = 0; i < 16; ++i) {
+    BOOST_CHECK(ring.push(packet));
+  }
+  BOOST_CHECK(!ring.push(packet));
+
+  ::munmap(addr, segment.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmSegment
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -69,6 +69,32 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Send, T, StreamTransportFixtures, T)
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendMany, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // packets queued behind a pending write are written together
+  std::vector<Block> blocks;
+  std::vector<uint8_t> expected;
+  for (int i = 0; i < 200; ++i) {
+    blocks.push_back(ndn::encoding::makeNonNegativeIntegerBlock(300, i));
+    expected.insert(expected.end(), blocks.back().begin(), blocks.back().end());
+    this->transport->send(blocks.back());
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutPackets, 200);
+
+  std::vector<uint8_t> readBuf(expected.size());
+  boost::asio::async_read(this->remoteSocket, boost::asio::buffer(readBuf),
+    [this] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE_EQUAL(error, boost::system::errc::success);
+      this->limitedIo.afterOp();
+    });
+
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_TEST(readBuf == expected, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveNormal, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -136,6 +162,31 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveMultipleBlocks, T, StreamTransportFixtur
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveManyLarge, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // large packets share the receive buffers, which are replaced while the packets are alive
+  std::vector<Block> pkts;
+  ndn::Buffer buf;
+  for (int i = 0; i < 10; ++i) {
+    const std::vector<uint8_t> bytes(5000 + i, static_cast<uint8_t>(i));
+    pkts.push_back(ndn::encoding::makeBinaryBlock(300, bytes));
+    buf.insert(buf.end(), pkts.back().begin(), pkts.back().end());
+  }
+  buf.push_back(0x05); // beginning of the next packet
+
+  this->remoteWrite(buf);
+
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 10);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBytes, buf.size() - 1);
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 10);
+  for (size_t i = 0; i < pkts.size(); ++i) {
+    BOOST_CHECK(this->receivedPackets->at(i).packet == pkts[i]);
+  }
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveTooLarge, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -232,6 +283,19 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendQueueLength, T, StreamTransportFixtures, T)
   BOOST_CHECK_EQUAL(this->transport->getSendQueueLength(), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendQueueSojournTime, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  BOOST_CHECK(!this->transport->getSendQueueSojournTime());
+
+  // the packet stays in the send queue until the write completes
+  this->transport->send(ndn::encoding::makeStringBlock(300, "hello"));
+  auto sojournTime = this->transport->getSendQueueSojournTime();
+  BOOST_REQUIRE(sojournTime);
+  BOOST_CHECK_GE(*sojournTime, 0_ns);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestStreamTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
@@ -113,6 +113,44 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(PermanentReconnect, T, TcpTransportFixtures, T)
   BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(PermanentReconnectKeepsReceivedPackets, T, TcpTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+
+  // a large packet shares the receive slab
+  const std::vector<uint8_t> bytes1(5000, 0xAA);
+  auto pkt1 = ndn::encoding::makeBinaryBlock(300, bytes1);
+  this->remoteWrite(ndn::Buffer(pkt1.begin(), pkt1.end()));
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 1);
+  Block held = this->receivedPackets->at(0).packet;
+  BOOST_CHECK(held == pkt1);
+
+  tcp::endpoint remoteEp(this->address, 7070);
+  this->stopAccept();
+  this->transport->afterStateChange.connectSingleShot([this] (auto, auto newState) {
+    BOOST_CHECK_EQUAL(newState, TransportState::DOWN);
+    this->limitedIo.afterOp();
+  });
+  this->remoteSocket.close();
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+
+  this->startAccept(remoteEp);
+  this->transport->afterStateChange.connectSingleShot([this] (auto, auto newState) {
+    BOOST_CHECK_EQUAL(newState, TransportState::UP);
+    this->limitedIo.afterOp();
+  });
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(2, 5_s), LimitedIo::EXCEED_OPS); // async_accept, UP
+
+  // packets received after the reconnection must not be written over the held packet
+  const std::vector<uint8_t> bytes2(6000, 0x55);
+  auto pkt2 = ndn::encoding::makeBinaryBlock(301, bytes2);
+  this->remoteWrite(ndn::Buffer(pkt2.begin(), pkt2.end()));
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 2);
+  BOOST_CHECK(this->receivedPackets->at(1).packet == pkt2);
+  BOOST_CHECK(held == pkt1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(held.value_begin(), held.value_end(), bytes1.begin(), bytes1.end());
+}
+
 class PermanentTcpTransportReconnectObserver : public TcpTransport
 {
 public:
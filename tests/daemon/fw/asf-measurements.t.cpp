@@ -37,7 +37,7 @@ BOOST_AUTO_TEST_SUITE(TestAsfMeasurements)
 BOOST_FIXTURE_TEST_CASE(FaceInfo, GlobalIoTimeFixture)
 {
   using fw::asf::FaceInfo;
-  FaceInfo info(nullptr);
+  fw::asf::PrivateFaceInfo info(nullptr);
 
   BOOST_CHECK_EQUAL(info.getLastRtt(), FaceInfo::RTT_NO_MEASUREMENT);
   BOOST_CHECK_EQUAL(info.getSrtt(), FaceInfo::RTT_NO_MEASUREMENT);
@@ -86,6 +86,45 @@ BOOST_FIXTURE_TEST_CASE(NamespaceInfo, GlobalIoTimeFixture)
   BOOST_CHECK(info.getFaceInfo(1234) == nullptr); // expired
 }
 
+BOOST_FIXTURE_TEST_CASE(SharedRttEstimator, GlobalIoTimeFixture)
+{
+  using fw::asf::FaceInfo;
+  using fw::asf::NamespaceInfo;
+  auto pool = make_shared<fw::asf::RttEstimatorPool>();
+  pool->setShared(true);
+
+  auto infoA = make_unique<NamespaceInfo>(pool);
+  NamespaceInfo infoB(pool);
+  BOOST_CHECK_EQUAL(pool->nNamespaceInfos, 2);
+
+  auto& faceA1 = infoA->getOrCreateFaceInfo(1);
+  auto& faceB1 = infoB.getOrCreateFaceInfo(1);
+  auto& faceB2 = infoB.getOrCreateFaceInfo(2);
+  BOOST_CHECK_EQUAL(pool->nFaceInfos, 3);
+  BOOST_CHECK_EQUAL(pool->getNSharedEstimators(), 2);
+  BOOST_CHECK(&faceA1.getRttEstimator() == &faceB1.getRttEstimator());
+  BOOST_CHECK(&faceA1.getRttEstimator() != &faceB2.getRttEstimator());
+
+  // SRTT is shared by all namespaces, while the last RTT is kept per namespace
+  faceA1.recordRtt(100_ms);
+  BOOST_CHECK_EQUAL(faceA1.getLastRtt(), 100_ms);
+  BOOST_CHECK_EQUAL(faceB1.getLastRtt(), FaceInfo::RTT_NO_MEASUREMENT);
+  BOOST_CHECK_EQUAL(faceB1.getSrtt(), 100_ms);
+  BOOST_CHECK_EQUAL(faceB2.getSrtt(), FaceInfo::RTT_NO_MEASUREMENT);
+
+  infoA.reset();
+  BOOST_CHECK_EQUAL(pool->nNamespaceInfos, 1);
+  BOOST_CHECK_EQUAL(pool->nFaceInfos, 2);
+  BOOST_CHECK_EQUAL(pool->getNSharedEstimators(), 2);
+  BOOST_CHECK_EQUAL(faceB1.getSrtt(), 100_ms);
+
+  this->advanceClocks(fw::asf::AsfMeasurements::MEASUREMENTS_LIFETIME + 1_s);
+  BOOST_CHECK(infoB.getFaceInfo(1) == nullptr); // expired
+  BOOST_CHECK(infoB.getFaceInfo(2) == nullptr);
+  BOOST_CHECK_EQUAL(pool->nFaceInfos, 0);
+  BOOST_CHECK_EQUAL(pool->getNSharedEstimators(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestAsfStrategy
 BOOST_AUTO_TEST_SUITE_END() // Fw
 
@@ -561,6 +561,12 @@ BOOST_AUTO_TEST_CASE(Parameters)
   auto strategy = checkValidity("", true);
   BOOST_TEST(strategy->m_probing.getProbingInterval() == 60_s);
   BOOST_TEST(strategy->m_nMaxTimeouts == 3);
+  BOOST_TEST(strategy->m_measurements.isSharedRttEstimation() == false);
+  strategy = checkValidity("/shared-rtt~1", true);
+  BOOST_TEST(strategy->m_measurements.isSharedRttEstimation() == true);
+  strategy = checkValidity("/shared-rtt~0/max-timeouts~2", true);
+  BOOST_TEST(strategy->m_measurements.isSharedRttEstimation() == false);
+  BOOST_TEST(strategy->m_nMaxTimeouts == 2);
   strategy = checkValidity("/probing-interval~30000/max-timeouts~5", true);
   BOOST_TEST(strategy->m_probing.getProbingInterval() == 30_s);
   BOOST_TEST(strategy->m_nMaxTimeouts == 5);
@@ -585,6 +591,43 @@ BOOST_AUTO_TEST_CASE(Parameters)
   checkValidity("/max-timeouts~1/probing-interval~-30000", false);
   checkValidity("/probing-interval~foo", false);
   checkValidity("/max-timeouts~1~2", false);
+  checkValidity("/shared-rtt~yes", false);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryReport)
+{
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  auto& privateAsf = choose<AsfStrategy>(forwarder, "/A");
+  auto& sharedAsf = choose<AsfStrategy>(forwarder, "/B",
+                                        Name(AsfStrategy::getStrategyName()).append("shared-rtt~1"));
+  Fib& fib = forwarder.getFib();
+
+  auto report = privateAsf.m_measurements.getMemoryReport();
+  BOOST_TEST(report.nNamespaceInfos == 0);
+  BOOST_TEST(report.nBytes == 0);
+
+  // one namespace, each FaceInfo holds its own estimator
+  const fib::Entry& entryA = *fib.insert("/A").first;
+  privateAsf.m_measurements.getOrCreateFaceInfo(entryA, "/A/1", 1);
+  privateAsf.m_measurements.getOrCreateFaceInfo(entryA, "/A/1", 2);
+  report = privateAsf.m_measurements.getMemoryReport();
+  BOOST_TEST(report.nNamespaceInfos == 1);
+  BOOST_TEST(report.nFaceInfos == 2);
+  BOOST_TEST(report.nRttEstimators == 2);
+  BOOST_TEST(report.nBytes > 0);
+  BOOST_TEST(boost::lexical_cast<std::string>(report) ==
+             "namespaces=1 face-infos=2 rtt-estimators=2 bytes=" + std::to_string(report.nBytes));
+
+  // two namespaces use the same face, and share its estimator
+  const fib::Entry& entryB1 = *fib.insert("/B/1").first;
+  const fib::Entry& entryB2 = *fib.insert("/B/2").first;
+  sharedAsf.m_measurements.getOrCreateFaceInfo(entryB1, "/B/1", 1);
+  sharedAsf.m_measurements.getOrCreateFaceInfo(entryB2, "/B/2", 1);
+  report = sharedAsf.m_measurements.getMemoryReport();
+  BOOST_TEST(report.nNamespaceInfos == 2);
+  BOOST_TEST(report.nFaceInfos == 2);
+  BOOST_TEST(report.nRttEstimators == 1);
 }
 
 BOOST_AUTO_TEST_CASE(FaceRankingForForwarding)
@@ -920,6 +920,60 @@ BOOST_AUTO_TEST_CASE(NewNextHop)
   BOOST_TEST(strategy.afterNewNextHopCalls[1] == "/A");
 }
 
+BOOST_AUTO_TEST_CASE(SegmentPrefetch)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  auto face3 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entry = fib.insert("/V").first;
+  fib.addOrUpdateNextHop(*entry, *face1, 0);
+  fib.addOrUpdateNextHop(*entry, *face2, 10);
+
+  fw::SegmentPrefetcher::Config config;
+  config.prefixes = {"/V"};
+  config.window = 2;
+  config.rate = 1000;
+  forwarder.getSegmentPrefetcher().setConfig(config);
+
+  // first segment: no pattern yet
+  face1->receiveInterest(*makeInterest(Name("/V/movie").appendSegment(0)));
+  this->advanceClocks(1_ms, 5_ms);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 1);
+
+  // second segment: consumer Interest is forwarded by the strategy, and segments 2 and 3
+  // are prefetched via face2, the cheapest nexthop that is not the downstream
+  face1->sentInterests.clear();
+  face2->sentInterests.clear();
+  face1->receiveInterest(*makeInterest(Name("/V/movie").appendSegment(1)));
+  this->advanceClocks(1_ms, 5_ms);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face2->sentInterests[1].getName(), Name("/V/movie").appendSegment(2));
+  BOOST_CHECK_EQUAL(face2->sentInterests[2].getName(), Name("/V/movie").appendSegment(3));
+  BOOST_CHECK_EQUAL(face1->sentInterests.size(), 0);
+  BOOST_CHECK_EQUAL(face3->sentInterests.size(), 0);
+
+  // prefetched Data is admitted into the CS but not sent to any downstream
+  auto data2 = makeData(Name("/V/movie").appendSegment(2));
+  face2->receiveData(*data2);
+  this->advanceClocks(1_ms, 5_ms);
+  BOOST_CHECK_EQUAL(face1->sentData.size(), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 1);
+
+  // consumer request for segment 2 is now a CS hit
+  face1->receiveInterest(*makeInterest(Name("/V/movie").appendSegment(2)));
+  this->advanceClocks(1_ms, 5_ms);
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face1->sentData[0].getName(), data2->getName());
+  BOOST_CHECK_EQUAL(counters.nCsHits, 1);
+
+  // segment 3 is still pending, so only segment 4 is prefetched
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(face2->sentInterests[3].getName(), Name("/V/movie").appendSegment(4));
+  BOOST_CHECK_EQUAL(forwarder.getSegmentPrefetcher().getNPrefetched(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE(ProcessConfig)
 
 BOOST_AUTO_TEST_CASE(DefaultHopLimit)
@@ -996,6 +1050,115 @@ BOOST_AUTO_TEST_CASE(BadDefaultHopLimit)
   BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(CsPrefetch)
+{
+  ConfigFile cf;
+  forwarder.setConfigFile(cf);
+  const auto& prefetchConfig = forwarder.getSegmentPrefetcher().getConfig();
+
+  std::string config = R"CONFIG(
+    forwarder
+    {
+      cs_prefetch
+      {
+        prefix /video
+        prefix /audio
+        window 8
+        rate 50
+      }
+    }
+  )CONFIG";
+
+  // disabled by default
+  BOOST_TEST(prefetchConfig.prefixes.empty());
+
+  cf.parse(config, true, "dummy-config");
+  BOOST_TEST(prefetchConfig.prefixes.empty());
+
+  cf.parse(config, false, "dummy-config");
+  BOOST_TEST(prefetchConfig.prefixes == std::vector<Name>({"/video", "/audio"}),
+             boost::test_tools::per_element());
+  BOOST_TEST(prefetchConfig.window == 8);
+  BOOST_TEST(prefetchConfig.rate == 50);
+
+  // removing the subsection disables prefetching and restores the defaults
+  config = R"CONFIG(
+    forwarder
+    {
+    }
+  )CONFIG";
+
+  cf.parse(config, false, "dummy-config");
+  BOOST_TEST(prefetchConfig.prefixes.empty());
+  BOOST_TEST(prefetchConfig.window == fw::SegmentPrefetcher::DEFAULT_WINDOW);
+  BOOST_TEST(prefetchConfig.rate == fw::SegmentPrefetcher::DEFAULT_RATE);
+}
+
+BOOST_AUTO_TEST_CASE(BadCsPrefetch)
+{
+  ConfigFile cf;
+  forwarder.setConfigFile(cf);
+
+  // missing prefix
+  std::string config = R"CONFIG(
+    forwarder
+    {
+      cs_prefetch
+      {
+        window 4
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+  BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
+
+  // window out of range
+  config = R"CONFIG(
+    forwarder
+    {
+      cs_prefetch
+      {
+        prefix /video
+        window 65
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+  BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
+
+  // zero rate
+  config = R"CONFIG(
+    forwarder
+    {
+      cs_prefetch
+      {
+        prefix /video
+        rate 0
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+  BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
+
+  // unknown option
+  config = R"CONFIG(
+    forwarder
+    {
+      cs_prefetch
+      {
+        prefix /video
+        depth 4
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+  BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestForwarder
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/segment-prefetcher.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd::tests {
+
+using fw::SegmentPrefetcher;
+
+class SegmentPrefetcherFixture : public GlobalIoTimeFixture
+{
+protected:
+  SegmentPrefetcherFixture()
+  {
+    SegmentPrefetcher::Config config;
+    config.prefixes = {"/V"};
+    config.window = 3;
+    config.rate = 10;
+    prefetcher.setConfig(config);
+  }
+
+  void
+  request(uint64_t segment, const Data* data = nullptr, const Name& prefix = "/V/movie")
+  {
+    auto interest = makeInterest(Name(prefix).appendSegment(segment));
+    prefetcher.afterContentStoreLookup(*interest, DOWNSTREAM, data);
+  }
+
+  std::vector<uint64_t>
+  sentSegments() const
+  {
+    std::vector<uint64_t> segments;
+    for (const auto& name : sent) {
+      segments.push_back(name[-1].toSegment());
+    }
+    return segments;
+  }
+
+protected:
+  static constexpr FaceId DOWNSTREAM = 300;
+
+  NameTree nameTree;
+  Measurements measurements{nameTree};
+  std::vector<Name> sent;
+  SegmentPrefetcher prefetcher{measurements, [this] (const Interest& interest, FaceId downstream) {
+    BOOST_CHECK_EQUAL(downstream, DOWNSTREAM);
+    sent.push_back(interest.getName());
+  }};
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestSegmentPrefetcher, SegmentPrefetcherFixture)
+
+BOOST_AUTO_TEST_CASE(Sequential)
+{
+  request(5);
+  BOOST_TEST(sent.empty());
+
+  request(6);
+  BOOST_TEST(sentSegments() == std::vector<uint64_t>({7, 8, 9}), boost::test_tools::per_element());
+  BOOST_TEST(sent.front().getPrefix(-1) == "/V/movie");
+
+  // window slides by one segment
+  this->advanceClocks(100_ms, 1_s);
+  sent.clear();
+  request(7);
+  BOOST_TEST(sentSegments() == std::vector<uint64_t>({10}), boost::test_tools::per_element());
+
+  // a seek resets the pattern
+  this->advanceClocks(100_ms, 1_s);
+  sent.clear();
+  request(100);
+  BOOST_TEST(sent.empty());
+  request(101);
+  BOOST_TEST(sentSegments() == std::vector<uint64_t>({102, 103, 104}),
+             boost::test_tools::per_element());
+  BOOST_TEST(prefetcher.getNPrefetched() == 7);
+}
+
+BOOST_AUTO_TEST_CASE(Scope)
+{
+  // outside configured prefixes
+  request(1, nullptr, "/W/movie");
+  request(2, nullptr, "/W/movie");
+  BOOST_TEST(sent.empty());
+
+  // last component is not a segment number
+  auto interest = makeInterest("/V/movie/index");
+  prefetcher.afterContentStoreLookup(*interest, DOWNSTREAM, nullptr);
+  prefetcher.afterContentStoreLookup(*interest, DOWNSTREAM, nullptr);
+  BOOST_TEST(sent.empty());
+  BOOST_TEST(measurements.size() == 0);
+
+  // disabled
+  prefetcher.setConfig({});
+  request(1);
+  request(2);
+  BOOST_TEST(sent.empty());
+}
+
+BOOST_AUTO_TEST_CASE(PerPrefixState)
+{
+  request(1, nullptr, "/V/a");
+  request(7, nullptr, "/V/b");
+  request(2, nullptr, "/V/a");
+  BOOST_TEST(sent.size() == 3);
+  BOOST_TEST(sent.back() == Name("/V/a").appendSegment(5));
+
+  auto* info = measurements.findExactMatch("/V/b")
+                 ->getStrategyInfo<SegmentPrefetcher::SegmentInfo>();
+  BOOST_REQUIRE(info != nullptr);
+  BOOST_TEST(info->lastSegment.value() == 7);
+
+  // state is dropped once the consumer goes away
+  this->advanceClocks(1_s, SegmentPrefetcher::STATE_LIFETIME + Measurements::getCleanupGranularity());
+  BOOST_TEST(measurements.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(FinalBlock)
+{
+  auto data = makeData(Name("/V/movie").appendSegment(1));
+  data->setFinalBlock(name::Component::fromSegment(3));
+
+  request(0);
+  request(1, data.get());
+  BOOST_TEST(sentSegments() == std::vector<uint64_t>({2, 3}), boost::test_tools::per_element());
+
+  this->advanceClocks(100_ms, 1_s);
+  sent.clear();
+  request(2);
+  request(3);
+  BOOST_TEST(sent.empty());
+}
+
+BOOST_AUTO_TEST_CASE(RateLimit)
+{
+  // bucket starts full with `window` tokens and refills at 10 per second
+  request(0);
+  request(1);
+  BOOST_TEST(sent.size() == 3);
+
+  // no tokens left
+  request(2);
+  BOOST_TEST(sent.size() == 3);
+
+  this->advanceClocks(10_ms, 110_ms);
+  request(3);
+  BOOST_TEST(sentSegments() == std::vector<uint64_t>({2, 3, 4, 5}), boost::test_tools::per_element());
+
+  // refill is capped at the window size
+  this->advanceClocks(100_ms, 10_s);
+  request(4);
+  request(5);
+  BOOST_TEST(sent.size() == 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSegmentPrefetcher
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace nfd::tests
@@ -442,6 +442,45 @@ BOOST_AUTO_TEST_CASE(FaceEventDestroyed)
   BOOST_CHECK_EQUAL(m_manager.m_faceStateChangeConn.count(faceId), 0);
 }
 
+BOOST_AUTO_TEST_CASE(CounterChanges)
+{
+  auto face1 = addFace(REMOVE_LAST_NOTIFICATION);
+  auto face2 = addFace(REMOVE_LAST_NOTIFICATION);
+  BOOST_REQUIRE(m_responses.empty());
+
+  // no notification if no counter has changed
+  m_manager.notifyCounterChanges();
+  BOOST_CHECK(m_responses.empty());
+
+  auto receivePacket = [] (const shared_ptr<Face>& face) {
+    dynamic_cast<DummyTransport*>(face->getTransport())->receivePacket(makeInterest("/A")->wireEncode());
+  };
+
+  receivePacket(face2);
+  m_manager.notifyCounterChanges();
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 1);
+  Block content = m_responses.back().getContent();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 1);
+  ndn::nfd::FaceStatus status(content.elements().front());
+  BOOST_CHECK_EQUAL(status.getFaceId(), face2->getId());
+  BOOST_CHECK_EQUAL(status.getNInBytes(), face2->getCounters().nInBytes);
+
+  // changes are also posted periodically
+  m_responses.clear();
+  receivePacket(face1);
+  receivePacket(face2);
+  advanceClocks(1_s, 5_s);
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 1);
+  content = m_responses.back().getContent();
+  content.parse();
+  BOOST_CHECK_EQUAL(content.elements().size(), 2);
+
+  m_responses.clear();
+  advanceClocks(1_s, 5_s);
+  BOOST_CHECK(m_responses.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Notifications
 
 BOOST_AUTO_TEST_SUITE_END() // TestFaceManager
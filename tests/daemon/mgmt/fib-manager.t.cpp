@@ -398,6 +398,83 @@ BOOST_AUTO_TEST_CASE(RecordNotExist)
 
 BOOST_AUTO_TEST_SUITE_END() // RemoveNextHop
 
+BOOST_AUTO_TEST_CASE(ApplyUpdates)
+{
+  FaceId face1 = addFace();
+  FaceId face2 = addFace();
+  fib::Entry* entry = m_fib.insert("/hello").first;
+  m_fib.addOrUpdateNextHop(*entry, *m_faceTable.get(face2), 3);
+
+  using rib::FibUpdate;
+  auto responses = m_manager.applyUpdates({
+    FibUpdate::createAddUpdate("/hello", face1, 1),
+    FibUpdate::createRemoveUpdate("/hello", face2),
+    FibUpdate::createAddUpdate("/world", face2, 5),
+  });
+  BOOST_REQUIRE_EQUAL(responses.size(), 3);
+  for (const auto& response : responses) {
+    BOOST_CHECK_EQUAL(response.getCode(), 200);
+  }
+  BOOST_CHECK_EQUAL(checkNextHop("/hello", 1, face1, 1), CheckNextHopResult::OK);
+  BOOST_CHECK_EQUAL(checkNextHop("/world", 1, face2, 5), CheckNextHopResult::OK);
+
+  // a face that has disappeared fails only its own update
+  responses = m_manager.applyUpdates({
+    FibUpdate::createAddUpdate("/a", face1, 1),
+    FibUpdate::createAddUpdate("/b", face1 + 100, 1),
+    FibUpdate::createAddUpdate("/c", face1, 1),
+    FibUpdate::createRemoveUpdate("/a", face1),
+  });
+  BOOST_REQUIRE_EQUAL(responses.size(), 4);
+  BOOST_CHECK_EQUAL(responses[0].getCode(), 200);
+  BOOST_CHECK_EQUAL(responses[1].getCode(), 410);
+  BOOST_CHECK_EQUAL(responses[2].getCode(), 200);
+  BOOST_CHECK_EQUAL(responses[3].getCode(), 200);
+  BOOST_CHECK_EQUAL(checkNextHop("/a"), CheckNextHopResult::NO_FIB_ENTRY);
+  BOOST_CHECK_EQUAL(checkNextHop("/b"), CheckNextHopResult::NO_FIB_ENTRY);
+  BOOST_CHECK_EQUAL(checkNextHop("/c", 1, face1, 1), CheckNextHopResult::OK);
+  BOOST_CHECK(m_responses.empty()); // no command responses are generated
+}
+
+BOOST_AUTO_TEST_CASE(EntryChangeNotifications)
+{
+  FaceId face1 = addFace();
+  FaceId face2 = addFace();
+
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/fib/add-nexthop",
+                                            makeParameters("/hello", face1, 10)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/fib/add-nexthop",
+                                            makeParameters("/hello", face2, 20)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/fib/add-nexthop",
+                                            makeParameters("/world", face1, 30)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/fib/remove-nexthop",
+                                            makeParameters("/world", face1)));
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 4);
+
+  // changes are coalesced into a single notification
+  m_responses.clear();
+  advanceClocks(100_ms, 2_s);
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 1);
+  Block content = m_responses.back().getContent();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 2);
+
+  ndn::nfd::FibEntry hello(content.elements()[0]);
+  BOOST_CHECK_EQUAL(hello.getPrefix(), "/hello");
+  BOOST_CHECK_EQUAL(hello.getNextHopRecords().size(), 2);
+  ndn::nfd::FibEntry world(content.elements()[1]);
+  BOOST_CHECK_EQUAL(world.getPrefix(), "/world");
+  BOOST_CHECK_EQUAL(world.getNextHopRecords().size(), 0);
+
+  // removing a nonexistent nexthop does not change the FIB
+  m_responses.clear();
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/fib/remove-nexthop",
+                                            makeParameters("/world", face1)));
+  m_responses.clear();
+  advanceClocks(100_ms, 2_s);
+  BOOST_CHECK(m_responses.empty());
+}
+
 BOOST_AUTO_TEST_SUITE(List)
 
 BOOST_AUTO_TEST_CASE(FibDataset)
@@ -441,6 +518,109 @@ BOOST_AUTO_TEST_CASE(FibDataset)
   BOOST_TEST(receivedRecords == expectedRecords, boost::test_tools::per_element());
 }
 
+class FibDatasetPageFixture : public FibManagerFixture
+{
+protected:
+  /** \brief Fetches one page of the FIB dataset.
+   *  \return prefixes of the entries in the page
+   */
+  std::vector<Name>
+  fetchPage(const std::optional<Name>& after)
+  {
+    Name request("/localhost/nfd/fib/list/page");
+    if (after) {
+      request.append(after->wireEncode());
+    }
+
+    m_responses.clear();
+    receiveInterest(Interest(request).setCanBePrefix(true));
+    Block content = concatenateResponses();
+    content.parse();
+
+    std::vector<Name> prefixes;
+    for (const auto& element : content.elements()) {
+      prefixes.push_back(ndn::nfd::FibEntry(element).getPrefix());
+    }
+    BOOST_CHECK_LE(prefixes.size(), ManagerBase::DATASET_PAGE_SIZE);
+    BOOST_CHECK(std::is_sorted(prefixes.begin(), prefixes.end()));
+    return prefixes;
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(FibDatasetPaged, FibDatasetPageFixture)
+{
+  const size_t nEntries = 2 * ManagerBase::DATASET_PAGE_SIZE + 10;
+  std::set<Name> expectedPrefixes;
+  for (size_t i = 0; i < nEntries; ++i) {
+    Name prefix = Name("test").appendSegment(i);
+    expectedPrefixes.insert(prefix);
+    m_fib.insert(prefix);
+  }
+
+  std::set<Name> receivedPrefixes;
+  std::optional<Name> after;
+  size_t nPages = 0;
+  while (true) {
+    auto page = fetchPage(after);
+    ++nPages;
+    for (const auto& prefix : page) {
+      BOOST_CHECK(receivedPrefixes.insert(prefix).second);
+    }
+    if (page.size() < ManagerBase::DATASET_PAGE_SIZE) {
+      break;
+    }
+    after = page.back();
+  }
+
+  BOOST_CHECK_EQUAL(nPages, 3);
+  BOOST_TEST(receivedPrefixes == expectedPrefixes, boost::test_tools::per_element());
+
+  m_responses.clear();
+  receiveInterest(Interest("/localhost/nfd/fib/list/unknown-suffix").setCanBePrefix(true));
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 1);
+  ControlResponse response(m_responses.back().getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(response.getCode(), 400);
+}
+
+BOOST_FIXTURE_TEST_CASE(FibDatasetPagedChurn, FibDatasetPageFixture)
+{
+  const size_t nEntries = 2 * ManagerBase::DATASET_PAGE_SIZE + 10;
+  std::set<Name> expectedPrefixes;
+  for (size_t i = 0; i < nEntries; ++i) {
+    Name prefix = Name("test").appendSegment(i);
+    expectedPrefixes.insert(prefix);
+    m_fib.insert(prefix);
+  }
+
+  auto page = fetchPage(std::nullopt);
+  BOOST_REQUIRE_EQUAL(page.size(), ManagerBase::DATASET_PAGE_SIZE);
+  std::set<Name> receivedPrefixes(page.begin(), page.end());
+
+  // erase the entry at the cursor, and grow the name tree enough to resize its hashtable
+  m_fib.erase(page.back());
+  expectedPrefixes.erase(page.back());
+  receivedPrefixes.erase(page.back());
+  for (size_t i = 0; i < 4 * nEntries; ++i) {
+    m_fib.insert(Name("churn").appendSegment(i));
+  }
+
+  std::optional<Name> after = page.back();
+  do {
+    page = fetchPage(after);
+    for (const auto& prefix : page) {
+      if (Name("churn").isPrefixOf(prefix)) {
+        continue;
+      }
+      BOOST_CHECK(receivedPrefixes.insert(prefix).second);
+    }
+    if (!page.empty()) {
+      after = page.back();
+    }
+  } while (page.size() == ManagerBase::DATASET_PAGE_SIZE);
+
+  BOOST_TEST(receivedPrefixes == expectedPrefixes, boost::test_tools::per_element());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // List
 
 BOOST_AUTO_TEST_SUITE_END() // TestFibManager
@@ -512,6 +512,71 @@ BOOST_FIXTURE_TEST_CASE(RibDataset, UnauthorizedRibManagerFixture)
   BOOST_TEST(receivedRecords == expectedRecords, boost::test_tools::per_element());
 }
 
+BOOST_FIXTURE_TEST_CASE(RibDatasetPaged, UnauthorizedRibManagerFixture)
+{
+  const size_t nEntries = ManagerBase::DATASET_PAGE_SIZE + 10;
+  for (size_t i = 0; i < nEntries; ++i) {
+    m_rib.insert(Name("/test-dataset").appendNumber(i), createRoute(i + 1, ndn::nfd::ROUTE_ORIGIN_APP, 10));
+  }
+
+  auto fetchPage = [this] (const Name& request) {
+    m_responses.clear();
+    receiveInterest(*makeInterest(request, true));
+    Block content = concatenateResponses();
+    content.parse();
+    std::vector<Name> names;
+    for (const auto& element : content.elements()) {
+      names.push_back(ndn::nfd::RibEntry(element).getName());
+    }
+    return names;
+  };
+
+  auto page1 = fetchPage("/localhost/nfd/rib/list/page");
+  BOOST_REQUIRE_EQUAL(page1.size(), ManagerBase::DATASET_PAGE_SIZE);
+  auto page2 = fetchPage(Name("/localhost/nfd/rib/list/page").append(page1.back().wireEncode()));
+  BOOST_REQUIRE_EQUAL(page2.size(), m_rib.size() - page1.size());
+
+  // pages are in canonical order, and together contain every entry exactly once
+  std::vector<Name> expected;
+  for (const auto& [name, entry] : m_rib) {
+    expected.push_back(name);
+  }
+  page1.insert(page1.end(), page2.begin(), page2.end());
+  BOOST_TEST(page1 == expected, boost::test_tools::per_element());
+}
+
+BOOST_FIXTURE_TEST_CASE(EntryChangeNotifications, LocalhostAuthorizedRibManagerFixture)
+{
+  // flush changes made by the fixture
+  advanceClocks(100_ms, 2_s);
+  m_responses.clear();
+
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/hello", 1)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/hello", 2)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/world", 1)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/unregister",
+                                            makeUnregisterParameters("/world", 1)));
+  advanceClocks(1_ms);
+
+  // changes are coalesced into a single notification
+  m_responses.clear();
+  advanceClocks(100_ms, 2_s);
+  BOOST_REQUIRE_EQUAL(m_responses.size(), 1);
+  Block content = m_responses.back().getContent();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 2);
+
+  ndn::nfd::RibEntry hello(content.elements()[0]);
+  BOOST_CHECK_EQUAL(hello.getName(), "/hello");
+  BOOST_CHECK_EQUAL(hello.getRoutes().size(), 2);
+  ndn::nfd::RibEntry world(content.elements()[1]);
+  BOOST_CHECK_EQUAL(world.getName(), "/world");
+  BOOST_CHECK_EQUAL(world.getRoutes().size(), 0);
+}
+
 BOOST_FIXTURE_TEST_SUITE(FaceMonitor, LocalhostAuthorizedRibManagerFixture)
 
 BOOST_AUTO_TEST_CASE(FetchActiveFacesEvent)
@@ -573,6 +638,214 @@ BOOST_AUTO_TEST_CASE(OnNotification)
 
 BOOST_AUTO_TEST_SUITE_END() // FaceMonitor
 
+BOOST_FIXTURE_TEST_CASE(SaveRestoreSnapshot, LocalhostAuthorizedRibManagerFixture)
+{
+  const std::string path = std::string(UNIT_TESTS_TMPDIR) + "/rib-manager-snapshot";
+
+  auto makeFaceStatus = [] (uint64_t faceId, const std::string& remoteUri,
+                            ndn::nfd::FacePersistency persistency) {
+    return ndn::nfd::FaceStatus()
+      .setFaceId(faceId)
+      .setRemoteUri(remoteUri)
+      .setLocalUri("udp4://192.0.2.1:6363")
+      .setFacePersistency(persistency);
+  };
+
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/persistent", 300)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/expiring", 300, 1_h)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/on-demand", 301)));
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/gone", 302)));
+  BOOST_REQUIRE_EQUAL(m_rib.size(), 4);
+
+  m_manager.removeInvalidFaces({
+    makeFaceStatus(300, "udp4://192.0.2.2:6363", ndn::nfd::FACE_PERSISTENCY_PERMANENT),
+    makeFaceStatus(301, "udp4://192.0.2.3:6363", ndn::nfd::FACE_PERSISTENCY_ON_DEMAND),
+    makeFaceStatus(302, "udp4://192.0.2.4:6363", ndn::nfd::FACE_PERSISTENCY_PERSISTENT),
+  });
+  advanceClocks(100_ms);
+  m_manager.saveSnapshot(path);
+
+  // simulate a restart: the RIB is empty and faces have new FaceIds
+  while (!m_rib.empty()) {
+    m_rib.erase(m_rib.begin()->first, *m_rib.begin()->second->begin());
+  }
+  m_face.sentInterests.clear();
+
+  m_manager.restoreSnapshot(path);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(m_face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(m_face.sentInterests.back().getName().getPrefix(4), "/localhost/nfd/faces/list");
+  BOOST_CHECK_EQUAL(m_rib.size(), 0);
+
+  advanceClocks(10_min);
+  m_manager.removeInvalidFaces({
+    makeFaceStatus(400, "udp4://192.0.2.2:6363", ndn::nfd::FACE_PERSISTENCY_PERMANENT),
+    makeFaceStatus(401, "udp4://192.0.2.3:6363", ndn::nfd::FACE_PERSISTENCY_ON_DEMAND),
+  });
+  advanceClocks(100_ms);
+
+  BOOST_REQUIRE_EQUAL(m_rib.size(), 2);
+  auto persistent = m_rib.find("/persistent");
+  BOOST_REQUIRE(persistent != m_rib.end());
+  BOOST_CHECK(persistent->second->hasFaceId(400));
+  BOOST_CHECK_EQUAL(persistent->second->getRoutes().front().cost, 10);
+  BOOST_CHECK_EQUAL(persistent->second->getRoutes().front().origin, ndn::nfd::ROUTE_ORIGIN_NLSR);
+  BOOST_CHECK(!persistent->second->getRoutes().front().expires);
+
+  auto expiring = m_rib.find("/expiring");
+  BOOST_REQUIRE(expiring != m_rib.end());
+  BOOST_CHECK(expiring->second->hasFaceId(400));
+  BOOST_REQUIRE(expiring->second->getRoutes().front().expires);
+
+  // the remaining lifetime is preserved across the restart
+  advanceClocks(1_min, 51_min);
+  BOOST_CHECK_EQUAL(m_rib.size(), 1);
+  BOOST_CHECK(m_rib.find("/expiring") == m_rib.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(SnapshotBeforeFaceDataset, LocalhostAuthorizedRibManagerFixture)
+{
+  const std::string path = std::string(UNIT_TESTS_TMPDIR) + "/rib-manager-snapshot-first-start";
+  std::remove(path.data());
+
+  // first start: there is no snapshot, but the face dataset is still requested
+  BOOST_CHECK_THROW(m_manager.restoreSnapshot(path), rib::snapshot::Error);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(m_face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(m_face.sentInterests.back().getName().getPrefix(4), "/localhost/nfd/faces/list");
+
+  receiveInterest(makeControlCommandRequest("/localhost/nfd/rib/register",
+                                            makeRegisterParameters("/persistent", 300)));
+  BOOST_REQUIRE_EQUAL(m_rib.size(), 1);
+
+  // face URIs are not known yet, so nothing is saved rather than an empty snapshot
+  m_manager.saveSnapshot(path);
+  BOOST_CHECK_THROW(rib::snapshot::load(path), rib::snapshot::Error);
+
+  m_manager.removeInvalidFaces({
+    ndn::nfd::FaceStatus()
+      .setFaceId(300)
+      .setRemoteUri("udp4://192.0.2.2:6363")
+      .setLocalUri("udp4://192.0.2.1:6363")
+      .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_PERSISTENT),
+  });
+  advanceClocks(100_ms);
+  m_manager.saveSnapshot(path);
+  auto records = rib::snapshot::load(path);
+  BOOST_REQUIRE_EQUAL(records.size(), 1);
+  BOOST_CHECK_EQUAL(records.front().name, "/persistent");
+}
+
+static rib::snapshot::Record
+makeSnapshotRecord(const Name& name, const std::string& remoteUri, uint64_t cost,
+                   uint64_t flags = ndn::nfd::ROUTE_FLAGS_NONE)
+{
+  rib::snapshot::Record record;
+  record.name = name;
+  record.remoteUri = remoteUri;
+  record.localUri = "udp4://192.0.2.1:6363";
+  record.origin = ndn::nfd::ROUTE_ORIGIN_STATIC;
+  record.cost = cost;
+  record.flags = flags;
+  return record;
+}
+
+static ndn::nfd::FaceStatus
+makeSnapshotFaceStatus(uint64_t faceId, const std::string& remoteUri)
+{
+  return ndn::nfd::FaceStatus()
+    .setFaceId(faceId)
+    .setRemoteUri(remoteUri)
+    .setLocalUri("udp4://192.0.2.1:6363")
+    .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
+}
+
+static ndn::nfd::FaceEventNotification
+makeSnapshotFaceCreated(uint64_t faceId, const std::string& remoteUri)
+{
+  return ndn::nfd::FaceEventNotification()
+    .setKind(ndn::nfd::FACE_EVENT_CREATED)
+    .setFaceId(faceId)
+    .setRemoteUri(remoteUri)
+    .setLocalUri("udp4://192.0.2.1:6363")
+    .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
+}
+
+BOOST_FIXTURE_TEST_CASE(SnapshotWaitsForFace, LocalhostAuthorizedRibManagerFixture)
+{
+  const std::string path = std::string(UNIT_TESTS_TMPDIR) + "/rib-manager-snapshot-pending";
+  rib::snapshot::save(path, {
+    makeSnapshotRecord("/early", "udp4://192.0.2.2:6363", 10),
+    makeSnapshotRecord("/late", "udp4://192.0.2.3:6363", 20),
+    makeSnapshotRecord("/never", "udp4://192.0.2.4:6363", 30),
+  });
+
+  m_manager.restoreSnapshot(path);
+  m_manager.removeInvalidFaces({makeSnapshotFaceStatus(400, "udp4://192.0.2.2:6363")});
+  advanceClocks(100_ms);
+  BOOST_CHECK_EQUAL(m_rib.size(), 1);
+  BOOST_CHECK(m_rib.find("/early") != m_rib.end());
+
+  // routes waiting for their faces are kept in the next snapshot
+  m_manager.saveSnapshot(path);
+  BOOST_CHECK_EQUAL(rib::snapshot::load(path).size(), 3);
+
+  // the face of /late is created after the face dataset has been retrieved
+  m_manager.onNotification(makeSnapshotFaceCreated(401, "udp4://192.0.2.3:6363"));
+  advanceClocks(100_ms);
+  BOOST_CHECK_EQUAL(m_rib.size(), 2);
+  auto late = m_rib.find("/late");
+  BOOST_REQUIRE(late != m_rib.end());
+  BOOST_CHECK(late->second->hasFaceId(401));
+  BOOST_CHECK_EQUAL(late->second->getRoutes().front().cost, 20);
+
+  // the face of /never appears too late, its route has been discarded
+  advanceClocks(1_min, RibManager::SNAPSHOT_RESTORE_TIMEOUT);
+  m_manager.onNotification(makeSnapshotFaceCreated(402, "udp4://192.0.2.4:6363"));
+  advanceClocks(100_ms);
+  BOOST_CHECK_EQUAL(m_rib.size(), 2);
+  BOOST_CHECK(m_rib.find("/never") == m_rib.end());
+
+  m_manager.saveSnapshot(path);
+  BOOST_CHECK_EQUAL(rib::snapshot::load(path).size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(SnapshotRestoreBatches, LocalhostAuthorizedRibManagerFixture)
+{
+  const std::string path = std::string(UNIT_TESTS_TMPDIR) + "/rib-manager-snapshot-batches";
+  // /a, /c and /a/b share a face; /a/b needs a later batch because /a is its prefix
+  rib::snapshot::save(path, {
+    makeSnapshotRecord("/a/b/c", "udp4://192.0.2.3:6363", 40),
+    makeSnapshotRecord("/a/b", "udp4://192.0.2.2:6363", 20),
+    makeSnapshotRecord("/c", "udp4://192.0.2.2:6363", 30),
+    makeSnapshotRecord("/a", "udp4://192.0.2.2:6363", 10, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT),
+  });
+
+  m_manager.restoreSnapshot(path);
+  m_fibUpdater.updates.clear();
+  m_manager.removeInvalidFaces({
+    makeSnapshotFaceStatus(400, "udp4://192.0.2.2:6363"),
+    makeSnapshotFaceStatus(401, "udp4://192.0.2.3:6363"),
+  });
+  advanceClocks(100_ms);
+  BOOST_CHECK_EQUAL(m_rib.size(), 4);
+
+  // same FIB as if the routes had been registered one by one
+  m_fibUpdater.sortUpdates();
+  rib::FibUpdater::FibUpdateList expected{
+    rib::FibUpdate::createAddUpdate("/a", 400, 10),
+    rib::FibUpdate::createAddUpdate("/a/b", 400, 20),
+    rib::FibUpdate::createAddUpdate("/a/b/c", 400, 10),
+    rib::FibUpdate::createAddUpdate("/a/b/c", 401, 40),
+    rib::FibUpdate::createAddUpdate("/c", 400, 30),
+  };
+  BOOST_TEST(m_fibUpdater.updates == expected, boost::test_tools::per_element());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestRibManager
 BOOST_AUTO_TEST_SUITE_END() // Mgmt
 
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mgmt/stats-shm-exporter.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nfd::tests {
+
+class StatsShmExporterFixture : public GlobalIoTimeFixture
+{
+protected:
+  StatsShmExporterFixture()
+  {
+    exporter.setConfigFile(configFile);
+  }
+
+  /**
+   * \brief Map the shared memory object read-only, as an external monitor would.
+   */
+  std::optional<stats_shm::Snapshot>
+  readSegment() const
+  {
+    int fd = ::shm_open(SHM_NAME.data(), O_RDONLY, 0);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+    struct stat st;
+    ::fstat(fd, &st);
+    void* segment = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (segment == MAP_FAILED) {
+      return std::nullopt;
+    }
+    auto snapshot = stats_shm::readSnapshot(segment, st.st_size);
+    ::munmap(segment, st.st_size);
+    return snapshot;
+  }
+
+protected:
+  const std::string SHM_NAME = "/nfd-test-stats-" + std::to_string(::getpid());
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  StatsShmExporter exporter{forwarder, faceTable};
+  ConfigFile configFile;
+};
+
+BOOST_AUTO_TEST_SUITE(Mgmt)
+BOOST_FIXTURE_TEST_SUITE(TestStatsShmExporter, StatsShmExporterFixture)
+
+BOOST_AUTO_TEST_CASE(Config)
+{
+  const std::string CONFIG = R"CONFIG(
+    stats_export
+    {
+      shm_name )CONFIG" + SHM_NAME + R"CONFIG(
+      interval 500
+    }
+  )CONFIG";
+
+  configFile.parse(CONFIG, true, "dummy-config");
+  BOOST_CHECK_EQUAL(exporter.isEnabled(), false);
+
+  configFile.parse(CONFIG, false, "dummy-config");
+  BOOST_CHECK_EQUAL(exporter.isEnabled(), true);
+  BOOST_CHECK_EQUAL(exporter.getShmName(), SHM_NAME);
+  BOOST_CHECK(readSegment().has_value());
+
+  exporter.disable();
+  BOOST_CHECK_EQUAL(exporter.isEnabled(), false);
+  BOOST_CHECK(!readSegment().has_value());
+}
+
+BOOST_AUTO_TEST_CASE(BadConfig)
+{
+  const std::string CONFIG_NO_NAME = R"CONFIG(
+    stats_export
+    {
+      interval 500
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(configFile.parse(CONFIG_NO_NAME, true, "dummy-config"), ConfigFile::Error);
+
+  const std::string CONFIG_BAD_NAME = R"CONFIG(
+    stats_export
+    {
+      shm_name /nfd/stats
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(configFile.parse(CONFIG_BAD_NAME, true, "dummy-config"), ConfigFile::Error);
+
+  const std::string CONFIG_BAD_INTERVAL = R"CONFIG(
+    stats_export
+    {
+      shm_name /nfd-stats
+      interval 0
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(configFile.parse(CONFIG_BAD_INTERVAL, true, "dummy-config"), ConfigFile::Error);
+
+  const std::string CONFIG_UNKNOWN_OPTION = R"CONFIG(
+    stats_export
+    {
+      shm_name /nfd-stats
+      foo bar
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(configFile.parse(CONFIG_UNKNOWN_OPTION, true, "dummy-config"), ConfigFile::Error);
+
+  BOOST_CHECK_EQUAL(exporter.isEnabled(), false);
+}
+
+BOOST_AUTO_TEST_CASE(PeriodicUpdate)
+{
+  auto face1 = make_shared<DummyFace>();
+  faceTable.add(face1);
+  exporter.enable(SHM_NAME, 1_s);
+
+  auto snapshot = readSegment();
+  BOOST_REQUIRE(snapshot.has_value());
+  BOOST_CHECK_EQUAL(snapshot->forwarder.nInInterests, 0);
+  BOOST_REQUIRE_EQUAL(snapshot->faces.size(), 1);
+  BOOST_CHECK_EQUAL(snapshot->faces[0].faceId, face1->getId());
+  BOOST_CHECK_EQUAL(snapshot->faces[0].nInInterests, 0);
+
+  face1->receiveInterest(*makeInterest("/A", false, std::nullopt, 1));
+  face1->receiveInterest(*makeInterest("/B", false, std::nullopt, 2));
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 2);
+
+  // not refreshed until the next update
+  snapshot = readSegment();
+  BOOST_REQUIRE(snapshot.has_value());
+  BOOST_CHECK_EQUAL(snapshot->forwarder.nInInterests, 0);
+
+  this->advanceClocks(100_ms, 1_s);
+  snapshot = readSegment();
+  BOOST_REQUIRE(snapshot.has_value());
+  BOOST_CHECK_EQUAL(snapshot->forwarder.nInInterests, 2);
+  BOOST_CHECK_EQUAL(snapshot->forwarder.nPitEntries, forwarder.getPit().size());
+  BOOST_CHECK_EQUAL(snapshot->forwarder.nCsDigestRequests,
+                    forwarder.getCs().getDigestCounters().nRequests);
+  BOOST_CHECK_EQUAL(snapshot->faces[0].nInInterests, 2);
+  BOOST_CHECK_GT(snapshot->forwarder.updateTimestamp, snapshot->forwarder.startTimestamp);
+}
+
+BOOST_AUTO_TEST_CASE(Grow)
+{
+  exporter.enable(SHM_NAME, 1_s);
+
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 300; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    faceTable.add(faces.back());
+  }
+  exporter.update();
+
+  auto snapshot = readSegment();
+  BOOST_REQUIRE(snapshot.has_value());
+  BOOST_CHECK_EQUAL(snapshot->faces.size(), 300);
+  BOOST_CHECK_EQUAL(snapshot->faces.back().faceId, faces.back()->getId());
+}
+
+BOOST_AUTO_TEST_CASE(ReadSnapshot)
+{
+  std::vector<uint64_t> buffer(stats_shm::computeSegmentSize(1) / sizeof(uint64_t));
+  auto* header = new (buffer.data()) stats_shm::Header{};
+  header->magic = stats_shm::MAGIC;
+  header->version = stats_shm::VERSION;
+  header->segmentSize = stats_shm::computeSegmentSize(1);
+  header->faceCapacity = 1;
+  header->nFaces = 1;
+  header->forwarder.nInData = 42;
+  const size_t size = buffer.size() * sizeof(uint64_t);
+
+  auto snapshot = stats_shm::readSnapshot(buffer.data(), size);
+  BOOST_REQUIRE(snapshot.has_value());
+  BOOST_CHECK_EQUAL(snapshot->forwarder.nInData, 42);
+  BOOST_CHECK_EQUAL(snapshot->faces.size(), 1);
+
+  // update in progress
+  header->sequence = 1;
+  BOOST_CHECK(!stats_shm::readSnapshot(buffer.data(), size, 3).has_value());
+  header->sequence = 2;
+
+  // segment has grown beyond the mapping
+  header->segmentSize = size + 1;
+  BOOST_CHECK(!stats_shm::readSnapshot(buffer.data(), size).has_value());
+  header->segmentSize = size;
+
+  // layout version mismatch
+  header->version = stats_shm::VERSION + 1;
+  BOOST_CHECK(!stats_shm::readSnapshot(buffer.data(), size).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestStatsShmExporter
+BOOST_AUTO_TEST_SUITE_END() // Mgmt
+
+} // namespace nfd::tests
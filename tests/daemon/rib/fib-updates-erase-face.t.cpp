@@ -420,6 +420,44 @@ BOOST_AUTO_TEST_CASE(RemoveNamespaceWithCapture) // Bug #3404
   BOOST_CHECK_EQUAL(fibUpdater.m_inheritedRoutes.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(RemoveFaceThenUpdateSameRoute)
+{
+  insertRoute("/a", 1, 0, 10, 0);
+  insertRoute("/a", 2, 0, 20, 0);
+
+  // Clear updates generated from previous insertions
+  clearFibUpdates();
+
+  // The REMOVE_FACE update discards the pending removal of /a face 1;
+  // the REGISTER update that follows must not find it through the update index
+  rib::RibUpdateBatch batch(1);
+  batch.add(rib::RibUpdate()
+            .setAction(rib::RibUpdate::REMOVE_FACE)
+            .setName("/a")
+            .setRoute(createRoute(1, 0, 10, 0)));
+  batch.add(rib::RibUpdate()
+            .setAction(rib::RibUpdate::REGISTER)
+            .setName("/a")
+            .setRoute(createRoute(1, 0, 50, 0)));
+
+  int nSuccess = 0;
+  fibUpdater.computeAndSendFibUpdates(batch,
+    [&] (const auto&) { ++nSuccess; },
+    [] (auto&&...) { BOOST_ERROR("unexpected failure"); });
+  pollIo();
+  BOOST_CHECK_EQUAL(nSuccess, 1);
+
+  // Should generate 1 update: 1 to set the cost of /a face 1 to 50
+  FibUpdater::FibUpdateList updates = getSortedFibUpdates();
+  BOOST_REQUIRE_EQUAL(updates.size(), 1);
+
+  FibUpdater::FibUpdateList::const_iterator update = updates.begin();
+  BOOST_CHECK_EQUAL(update->name,  "/a");
+  BOOST_CHECK_EQUAL(update->faceId, 1);
+  BOOST_CHECK_EQUAL(update->cost,   50);
+  BOOST_CHECK_EQUAL(update->action, FibUpdate::ADD_NEXTHOP);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // EraseFace
 BOOST_AUTO_TEST_SUITE_END() // FibUpdates
 BOOST_AUTO_TEST_SUITE_END() // Rib
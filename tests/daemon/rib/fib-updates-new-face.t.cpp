@@ -261,6 +261,73 @@ BOOST_AUTO_TEST_CASE(CaptureTurnedOnWithChildInherit)
   BOOST_CHECK_EQUAL(update->action, FibUpdate::ADD_NEXTHOP);
 }
 
+BOOST_AUTO_TEST_CASE(DirectUpdates)
+{
+  std::vector<FibUpdater::FibUpdateList> calls;
+  uint32_t code = 200;
+  fibUpdater.setDirectUpdateFunc([&] (const auto& updates, auto done) {
+    calls.push_back(updates);
+    std::vector<ndn::nfd::ControlResponse> responses(updates.size(),
+                                                     ndn::nfd::ControlResponse(code, ""));
+    boost::asio::defer(getGlobalIoService(), [=] { done(responses); });
+  });
+
+  insertRoute("/",    1, 0, 50, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  insertRoute("/a/b", 3, 0, 10, 0);
+  insertRoute("/a/c", 4, 0, 10, 0);
+  BOOST_CHECK_EQUAL(rib.size(), 3);
+  calls.clear();
+
+  // updates for the batch face and for other faces are applied in one step each
+  insertRoute("/a", 2, 0, 10, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  BOOST_CHECK_EQUAL(rib.size(), 4);
+  BOOST_REQUIRE_EQUAL(calls.size(), 2);
+  BOOST_CHECK_EQUAL(calls[0].size(), 3); // add face 2 to /a, /a/b, /a/c
+  BOOST_CHECK_EQUAL(calls[1].size(), 1); // add face 1 to /a
+  BOOST_CHECK(getFibUpdates().empty()); // management commands are not used
+  calls.clear();
+
+  // the RIB is not changed if the batch face does not exist
+  code = 410;
+  insertRoute("/d", 5, 0, 10, 0);
+  BOOST_CHECK_EQUAL(rib.size(), 4);
+  BOOST_CHECK_EQUAL(calls.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(DirectUpdatesNonBatchFaceGone)
+{
+  // responds like FibManager::applyUpdates: one response per update
+  std::vector<FibUpdater::FibUpdateList> calls;
+  std::set<uint64_t> missingFaces;
+  fibUpdater.setDirectUpdateFunc([&] (const auto& updates, auto done) {
+    calls.push_back(updates);
+    std::vector<ndn::nfd::ControlResponse> responses;
+    for (const auto& update : updates) {
+      responses.emplace_back(missingFaces.count(update.faceId) > 0 ? 410 : 200, "");
+    }
+    boost::asio::defer(getGlobalIoService(), [=] { done(responses); });
+  });
+
+  insertRoute("/", 1, 0, 50, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  insertRoute("/", 5, 0, 50, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  insertRoute("/", 6, 0, 50, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  calls.clear();
+
+  // face 1 has disappeared; the updates after it are still applied
+  missingFaces = {1};
+  insertRoute("/a", 2, 0, 10, 0);
+  BOOST_CHECK_EQUAL(rib.size(), 2);
+  BOOST_REQUIRE_EQUAL(calls.size(), 2);
+  BOOST_CHECK_EQUAL(calls[0].size(), 1); // add face 2 to /a
+  BOOST_CHECK_EQUAL(calls[1].size(), 3); // add faces 1, 5, 6 to /a
+  calls.clear();
+
+  // the RIB update queue is not stalled
+  insertRoute("/b", 3, 0, 10, 0);
+  BOOST_CHECK_EQUAL(rib.size(), 3);
+  BOOST_CHECK_EQUAL(calls.size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // NewFace
 BOOST_AUTO_TEST_SUITE_END() // FibUpdates
 BOOST_AUTO_TEST_SUITE_END() // Rib
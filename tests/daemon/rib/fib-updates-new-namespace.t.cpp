@@ -189,6 +189,33 @@ BOOST_AUTO_TEST_CASE(Capture)
   BOOST_CHECK_EQUAL(update->action, FibUpdate::REMOVE_NEXTHOP);
 }
 
+BOOST_AUTO_TEST_CASE(ManyDescendants)
+{
+  const size_t nDescendants = 1000;
+  for (size_t i = 0; i < nDescendants; ++i) {
+    insertRoute(Name("/a/b").appendNumber(i), 1, 0, 10, 0);
+  }
+  // names that sort next to /a/b's descendants but are not under /a/b
+  insertRoute("/a/a", 1, 0, 10, 0);
+  insertRoute("/a/c", 1, 0, 10, 0);
+
+  clearFibUpdates();
+
+  // Should generate 1 update for the inserted route and 1 for each descendant
+  insertRoute("/a/b", 2, 0, 50, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+
+  FibUpdater::FibUpdateList updates = getSortedFibUpdates();
+  BOOST_REQUIRE_EQUAL(updates.size(), nDescendants + 1);
+  for (const auto& update : updates) {
+    BOOST_CHECK(Name("/a/b").isPrefixOf(update.name));
+    BOOST_CHECK_EQUAL(update.faceId, 2);
+    BOOST_CHECK_EQUAL(update.cost, 50);
+    BOOST_CHECK_EQUAL(update.action, FibUpdate::ADD_NEXTHOP);
+  }
+
+  BOOST_CHECK_EQUAL(rib.find("/a/b")->second->getChildren().size(), nDescendants);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // NewNamespace
 BOOST_AUTO_TEST_SUITE_END() // FibUpdates
 BOOST_AUTO_TEST_SUITE_END() // Rib
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rib/rib-snapshot.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <fstream>
+
+namespace nfd::tests {
+
+using namespace nfd::rib::snapshot;
+namespace fs = boost::filesystem;
+
+BOOST_AUTO_TEST_SUITE(Rib)
+BOOST_AUTO_TEST_SUITE(TestRibSnapshot)
+
+static std::vector<Record>
+makeRecords()
+{
+  std::vector<Record> records(2);
+  records[0].name = "/A";
+  records[0].remoteUri = "udp4://192.0.2.1:6363";
+  records[0].localUri = "udp4://192.0.2.2:6363";
+  records[0].origin = ndn::nfd::ROUTE_ORIGIN_NLSR;
+  records[0].cost = 10;
+  records[0].flags = ndn::nfd::ROUTE_FLAG_CHILD_INHERIT;
+  records[1].name = "/A/B/C";
+  records[1].remoteUri = "tcp4://192.0.2.3:6363";
+  records[1].localUri = "tcp4://192.0.2.2:6363";
+  records[1].origin = ndn::nfd::ROUTE_ORIGIN_STATIC;
+  records[1].cost = 20;
+  records[1].expires = time::fromUnixTimestamp(1700000000000_ms);
+  return records;
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  auto records = makeRecords();
+  Block block = encode(records);
+  auto decoded = decode(block);
+  BOOST_TEST(decoded == records, boost::test_tools::per_element());
+
+  BOOST_CHECK_EQUAL(decode(encode({})).size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformed)
+{
+  // wrong outer type
+  BOOST_CHECK_THROW(decode("0700"_block), Error);
+  // unexpected element
+  BOOST_CHECK_THROW(decode("8003 0701FF"_block), Error);
+  // RouteRecord without the required fields
+  BOOST_CHECK_THROW(decode("8004 8102 0700"_block), Error);
+}
+
+BOOST_AUTO_TEST_CASE(SaveLoad)
+{
+  const fs::path dir = fs::path(UNIT_TESTS_TMPDIR) / "rib-snapshot";
+  const std::string path = (dir / "rib.snapshot").string();
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+
+  BOOST_CHECK_THROW(load(path), Error);
+
+  auto records = makeRecords();
+  save(path, records);
+  BOOST_CHECK(!fs::exists(path + ".tmp"));
+  auto loaded = load(path);
+  BOOST_TEST(loaded == records, boost::test_tools::per_element());
+
+  // overwrite with a different snapshot
+  records.pop_back();
+  save(path, records);
+  loaded = load(path);
+  BOOST_TEST(loaded == records, boost::test_tools::per_element());
+
+  // truncated file
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "\x80\x10";
+  }
+  BOOST_CHECK_THROW(load(path), Error);
+
+  // missing directory
+  BOOST_CHECK_THROW(save((dir / "nonexistent" / "rib.snapshot").string(), records), Error);
+
+  fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRibSnapshot
+BOOST_AUTO_TEST_SUITE_END() // Rib
+
+} // namespace nfd::tests
@@ -177,6 +177,54 @@ BOOST_AUTO_TEST_CASE(DeletePitInOutRecords)
   BOOST_CHECK_EQUAL(&foundA->getOutRecords().front().getFace(), face2.get());
 }
 
+BOOST_AUTO_TEST_CASE(RemovedBeforeCleanup)
+{
+  NameTree nameTree(16);
+  Fib fib(nameTree);
+  Pit pit(nameTree);
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+
+  fib::Entry* entryA = fib.insert("/A").first;
+  fib.addOrUpdateNextHop(*entryA, *face1, 0);
+  fib.addOrUpdateNextHop(*entryA, *face2, 0);
+  fib::Entry* entryB = fib.insert("/B").first;
+  fib.addOrUpdateNextHop(*entryB, *face1, 0);
+  fib::Entry* entryC = fib.insert("/C").first;
+  fib.addOrUpdateNextHop(*entryC, *face1, 0);
+  BOOST_CHECK_EQUAL(fib.findEntriesWithNextHop(*face1).size(), 3);
+  BOOST_CHECK_EQUAL(fib.findEntriesWithNextHop(*face2).size(), 1);
+
+  auto interestP = makeInterest("/P");
+  auto entryP = pit.insert(*interestP).first;
+  entryP->insertOrUpdateInRecord(*face1, *interestP);
+  entryP->insertOrUpdateOutRecord(*face2, *interestP);
+  auto interestQ = makeInterest("/Q");
+  auto entryQ = pit.insert(*interestQ).first;
+  entryQ->insertOrUpdateInRecord(*face1, *interestQ);
+
+  // references to face1 removed by other means must not be visited during cleanup
+  fib.erase("/B");
+  fib.removeNextHop(*entryC, *face1);
+  entryQ->clearInRecords();
+  pit.erase(entryQ.get());
+  entryQ.reset();
+  BOOST_CHECK_EQUAL(fib.findEntriesWithNextHop(*face1).size(), 1);
+
+  cleanupOnFaceRemoval(nameTree, fib, pit, *face1);
+  BOOST_CHECK_EQUAL(fib.size(), 1);
+  BOOST_CHECK(fib.findEntriesWithNextHop(*face1).empty());
+  BOOST_REQUIRE_EQUAL(entryA->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(&entryA->getNextHops().front().getFace(), face2.get());
+  BOOST_CHECK(!entryP->hasInRecords());
+  BOOST_CHECK(entryP->hasOutRecords());
+
+  cleanupOnFaceRemoval(nameTree, fib, pit, *face2);
+  BOOST_CHECK_EQUAL(fib.size(), 0);
+  BOOST_CHECK(fib.findEntriesWithNextHop(*face2).empty());
+  BOOST_CHECK(!entryP->hasOutRecords());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // FaceRemovalCleanup
 
 BOOST_AUTO_TEST_SUITE_END() // TestCleanup
@@ -141,6 +141,43 @@ BOOST_AUTO_TEST_CASE(MustBeFresh)
   CHECK_CS_FIND(0);
 }
 
+BOOST_AUTO_TEST_CASE(ImplicitDigestLazy)
+{
+  const auto& counters = cs.getDigestCounters();
+
+  insert(1, "/A/1");
+  insert(2, "/A/2");
+  Name n3 = insert(3, "/A/3");
+  insert(4, "/B");
+
+  startInterest("/A/2");
+  CHECK_CS_FIND(2);
+  startInterest("/A")
+    .setCanBePrefix(true);
+  CHECK_CS_FIND(1);
+  // no Data has been hashed for insertion or lookup by name
+  BOOST_CHECK_EQUAL(counters.nRequests, 0);
+  BOOST_CHECK_EQUAL(counters.nComputations, 0);
+
+  startInterest(n3);
+  CHECK_CS_FIND(3);
+  uint64_t nRequestsAfterFullName = counters.nRequests;
+  BOOST_CHECK_GT(nRequestsAfterFullName, 0);
+  BOOST_CHECK_EQUAL(counters.nComputations, 1);
+
+  // the digest is cached in the entry
+  startInterest(n3);
+  CHECK_CS_FIND(3);
+  BOOST_CHECK_GT(counters.nRequests, nRequestsAfterFullName);
+  BOOST_CHECK_EQUAL(counters.nComputations, 1);
+
+  // wrong digest
+  Name wrongDigest = n3.getPrefix(-1);
+  wrongDigest.appendImplicitSha256Digest(std::vector<uint8_t>(32, 0xBB));
+  startInterest(wrongDigest);
+  CHECK_CS_FIND(0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 
 BOOST_AUTO_TEST_CASE(Erase)
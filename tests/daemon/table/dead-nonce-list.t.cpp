@@ -95,6 +95,41 @@ BOOST_AUTO_TEST_CASE(NoDuplicates)
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce5), true);
 }
 
+BOOST_AUTO_TEST_CASE(Filter)
+{
+  DeadNonceList dnl;
+  dnl.m_capacity = DeadNonceList::MIN_CAPACITY;
+
+  auto sumCounters = [&dnl] {
+    size_t sum = 0;
+    for (uint64_t word : dnl.m_filter) {
+      for (; word != 0; word >>= 4) {
+        sum += word & 0xF;
+      }
+    }
+    return sum;
+  };
+  BOOST_CHECK_EQUAL(sumCounters(), 0);
+
+  // insert more entries than the capacity, so that some of them are evicted
+  const Interest::Nonce nonce(0x53b4eaa8);
+  for (uint64_t i = 0; i < 2 * DeadNonceList::MIN_CAPACITY; ++i) {
+    dnl.add(Name("/A").appendNumber(i), nonce);
+    BOOST_CHECK(dnl.has(Name("/A").appendNumber(i), nonce));
+  }
+  // each stored entry increments three counters, MARKs are not stored in the filter
+  BOOST_CHECK_EQUAL(sumCounters(), 3 * dnl.size());
+
+  // few lookups of absent entries should need to probe the hash table
+  size_t nFalsePositives = 0;
+  for (uint64_t i = 0; i < 10000; ++i) {
+    if (dnl.isInFilter(DeadNonceList::makeEntry(Name("/B").appendNumber(i), nonce))) {
+      ++nFalsePositives;
+    }
+  }
+  BOOST_CHECK_LT(nFalsePositives, 500);
+}
+
 BOOST_AUTO_TEST_CASE(MinLifetime)
 {
   BOOST_CHECK_THROW(DeadNonceList(0_ms), std::invalid_argument);
@@ -389,6 +389,42 @@ BOOST_AUTO_TEST_CASE(Iterator)
   BOOST_CHECK_EQUAL(expected.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(OrderedRange)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  fib.insert("/B");
+  fib.insert("/A/B");
+  fib.insert("/");
+  fib.insert("/A");
+  fib.insert("/A/B/C");
+
+  auto getPrefixes = [] (const Fib::OrderedRange& range) {
+    std::vector<Name> prefixes;
+    for (const auto& entry : range) {
+      prefixes.push_back(entry.getPrefix());
+    }
+    return prefixes;
+  };
+
+  std::vector<Name> expected{"/", "/A", "/A/B", "/A/B/C", "/B"};
+  BOOST_TEST(getPrefixes(fib.getOrderedRange()) == expected, boost::test_tools::per_element());
+
+  expected = {"/A/B/C", "/B"};
+  BOOST_TEST(getPrefixes(fib.getOrderedRange(Name("/A/B"))) == expected,
+             boost::test_tools::per_element());
+
+  // the cursor does not need to be in the FIB
+  fib.erase("/A/B");
+  expected = {"/A/B/C", "/B"};
+  BOOST_TEST(getPrefixes(fib.getOrderedRange(Name("/A/B"))) == expected,
+             boost::test_tools::per_element());
+
+  expected = {};
+  BOOST_TEST(getPrefixes(fib.getOrderedRange(Name("/B"))) == expected,
+             boost::test_tools::per_element());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestFib
 BOOST_AUTO_TEST_SUITE_END() // Table
 
@@ -243,6 +243,37 @@ BOOST_AUTO_TEST_CASE(Lifetime)
   BOOST_CHECK_EQUAL(measurements.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(LifetimeExtendedRepeatedly)
+{
+  Name nameA("/A");
+  Entry& entryA = measurements.get(nameA);
+
+  // keep extending for longer than the initial lifetime
+  for (int i = 0; i < 10; ++i) {
+    measurements.extendLifetime(entryA, 2_s);
+    this->advanceClocks(100_ms, 1_s);
+    BOOST_CHECK(measurements.findExactMatch(nameA) == &entryA);
+  }
+
+  this->advanceClocks(100_ms, 2_s + Measurements::getCleanupGranularity());
+  BOOST_CHECK(measurements.findExactMatch(nameA) == nullptr);
+  BOOST_CHECK_EQUAL(measurements.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CleanupManyEntries)
+{
+  const size_t nEntries = 10000;
+  for (size_t i = 0; i < nEntries; ++i) {
+    measurements.get(Name("/M").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(measurements.size(), nEntries);
+
+  // expired entries are erased in several batches
+  this->advanceClocks(Measurements::getInitialLifetime() + Measurements::getCleanupGranularity());
+  this->advanceClocks(1_ms, 100_ms);
+  BOOST_CHECK_EQUAL(measurements.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
 {
   size_t nNameTreeEntriesBefore = nameTree.size();
@@ -75,39 +75,44 @@ BOOST_AUTO_TEST_CASE(Modifiers)
 
   const Node* node = nullptr;
   bool isNew = false;
-  std::tie(node, isNew) = ht.insert(name, 2, hashes);
+  std::tie(node, isNew) = ht.insert(name, 1, hashes);
   BOOST_CHECK_EQUAL(isNew, true);
   BOOST_CHECK(node != nullptr);
   BOOST_CHECK_EQUAL(ht.size(), 1);
-  BOOST_CHECK_EQUAL(ht.find(name, 2), node);
-  BOOST_CHECK_EQUAL(ht.find(name, 2, hashes), node);
+  BOOST_CHECK_EQUAL(ht.find(name, 1), node);
+  BOOST_CHECK_EQUAL(ht.find(name, 1, hashes), node);
 
   BOOST_CHECK(ht.find(name, 0) == nullptr);
-  BOOST_CHECK(ht.find(name, 1) == nullptr);
+  BOOST_CHECK(ht.find(name, 2) == nullptr);
   BOOST_CHECK(ht.find(name, 3) == nullptr);
   BOOST_CHECK(ht.find(name, 4) == nullptr);
 
   const Node* node2 = nullptr;
-  std::tie(node2, isNew) = ht.insert(name, 2, hashes);
+  std::tie(node2, isNew) = ht.insert(name, 1, hashes);
   BOOST_CHECK_EQUAL(isNew, false);
   BOOST_CHECK_EQUAL(node2, node);
   BOOST_CHECK_EQUAL(ht.size(), 1);
 
-  std::tie(node2, isNew) = ht.insert(name, 4, hashes);
+  std::tie(node2, isNew) = ht.insert(name, 2, hashes);
   BOOST_CHECK_EQUAL(isNew, true);
   BOOST_CHECK(node2 != nullptr);
   BOOST_CHECK_NE(node2, node);
   BOOST_CHECK_EQUAL(ht.size(), 2);
+  // names are compared through ancestors, so node2 must be attached before it can be found
+  node2->entry.setParent(node->entry);
+  BOOST_CHECK_EQUAL(ht.find(name, 2), node2);
+  BOOST_CHECK_EQUAL(node2->entry.getName(), name.getPrefix(2));
 
+  node2->entry.unsetParent();
   ht.erase(const_cast<Node*>(node2));
   BOOST_CHECK_EQUAL(ht.size(), 1);
-  BOOST_CHECK(ht.find(name, 4) == nullptr);
-  BOOST_CHECK_EQUAL(ht.find(name, 2), node);
+  BOOST_CHECK(ht.find(name, 2) == nullptr);
+  BOOST_CHECK_EQUAL(ht.find(name, 1), node);
 
   ht.erase(const_cast<Node*>(node));
   BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK(ht.find(name, 1) == nullptr);
   BOOST_CHECK(ht.find(name, 2) == nullptr);
-  BOOST_CHECK(ht.find(name, 4) == nullptr);
 }
 
 BOOST_AUTO_TEST_CASE(Resize)
@@ -211,8 +216,19 @@ BOOST_AUTO_TEST_CASE(TreeRelation)
   BOOST_CHECK_EQUAL(npe.getParent(), &parent);
   BOOST_CHECK_EQUAL(parent.hasChildren(), true);
   BOOST_CHECK_EQUAL(parent.isEmpty(), false);
-  BOOST_REQUIRE_EQUAL(parent.getChildren().size(), 1);
-  BOOST_CHECK_EQUAL(parent.getChildren().front(), &npe);
+  BOOST_CHECK_EQUAL(parent.getFirstChild(), &npe);
+  BOOST_CHECK(npe.getNextSibling() == nullptr);
+
+  auto siblingNode = make_unique<Node>(2, Name(parentName).append("jkl"));
+  Entry& sibling = siblingNode->entry;
+  sibling.setParent(parent);
+  BOOST_CHECK_EQUAL(parent.getFirstChild(), &sibling);
+  BOOST_CHECK_EQUAL(sibling.getNextSibling(), &npe);
+
+  sibling.unsetParent();
+  BOOST_CHECK(sibling.getParent() == nullptr);
+  BOOST_CHECK_EQUAL(parent.getFirstChild(), &npe);
+  BOOST_CHECK(npe.getNextSibling() == nullptr);
 
   npe.unsetParent();
   BOOST_CHECK(npe.getParent() == nullptr);
@@ -225,7 +241,7 @@ BOOST_AUTO_TEST_CASE(TableEntries)
   Name name("ndn:/named-data/research/abc/def/ghi");
   Node node(0, name);
   Entry& npe = node.entry;
-  BOOST_CHECK_EQUAL(npe.getName(), name);
+  BOOST_CHECK_EQUAL(npe.getDepth(), name.size());
 
   BOOST_CHECK_EQUAL(npe.hasTableEntries(), false);
   BOOST_CHECK_EQUAL(npe.isEmpty(), true);
@@ -425,6 +441,38 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(nt.size(), 8);
 }
 
+BOOST_AUTO_TEST_CASE(EntryNameReconstruction)
+{
+  NameTree nt;
+
+  const uint8_t value1[] = {0x01, 0x02};
+  Name name("/A");
+  name.appendVersion(5).appendSegment(0).append(name::Component(100, value1));
+  {
+    // entries do not keep the Interest's name wire encoding alive
+    auto interest = makeInterest(name);
+    nt.lookup(interest->getName());
+  }
+  BOOST_CHECK_EQUAL(nt.size(), 5);
+
+  Entry* nte = nt.findExactMatch(name);
+  BOOST_REQUIRE(nte != nullptr);
+  BOOST_CHECK_EQUAL(nte->getDepth(), 4);
+  BOOST_CHECK_EQUAL(nte->getName(), name);
+  BOOST_CHECK_EQUAL(nte->getParent()->getName(), name.getPrefix(3));
+
+  // same component value but different type
+  const uint8_t value2[] = {0x05};
+  Name name2("/A");
+  name2.append(name::Component(100, value2));
+  BOOST_CHECK(nt.findExactMatch(name2) == nullptr);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(name2), nt.findExactMatch("/A"));
+
+  Entry& nte2 = nt.lookup(name2);
+  BOOST_CHECK_EQUAL(nte2.getName(), name2);
+  BOOST_CHECK_EQUAL(nt.findExactMatch(name), nte);
+}
+
 /** \brief Verify a NameTree enumeration contains expected entries.
  *
  *  Example:
@@ -692,6 +740,80 @@ BOOST_FIXTURE_TEST_CASE(IteratorFindAllMatches, EnumerationFixture)
     .end();
 }
 
+BOOST_FIXTURE_TEST_CASE(VisitorForEachMatch, EnumerationFixture)
+{
+  nt.lookup("/a/b/c/d/e/f");
+  nt.lookup("/a/a/c");
+  BOOST_CHECK_EQUAL(nt.size(), 10);
+
+  std::vector<Name> visited;
+  nt.forEachMatch("/a/b/c/d/e/x/y", [&] (const Entry& nte) { visited.push_back(nte.getName()); });
+  std::vector<Name> expected{"/a/b/c/d/e", "/a/b/c/d", "/a/b/c", "/a/b", "/a", "/"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(visited.begin(), visited.end(), expected.begin(), expected.end());
+
+  size_t nVisited = 0;
+  nt.forEachMatch("/z", [&] (const Entry& nte) {
+    BOOST_CHECK_EQUAL(nte.getDepth(), 0);
+    ++nVisited;
+  });
+  BOOST_CHECK_EQUAL(nVisited, 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(VisitorForEachEntry, EnumerationFixture)
+{
+  size_t nVisited = 0;
+  nt.forEachEntry([&] (const Entry&) { ++nVisited; });
+  BOOST_CHECK_EQUAL(nVisited, 0);
+
+  this->insertAb1Ab2Ac1Ac2();
+
+  std::unordered_set<Name> visited;
+  nt.forEachEntry([&] (const Entry& nte) { visited.insert(nte.getName()); });
+  BOOST_CHECK_EQUAL(visited.size(), 8);
+
+  // same order as fullEnumerate
+  auto it = nt.begin();
+  nt.forEachEntry([&] (const Entry& nte) {
+    BOOST_REQUIRE(it != nt.end());
+    BOOST_CHECK_EQUAL(&*it, &nte);
+    ++it;
+  });
+  BOOST_CHECK(it == nt.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(VisitorForEachInSubTree, EnumerationFixture)
+{
+  this->insertAb1Ab2Ac1Ac2();
+
+  std::unordered_set<Name> visited;
+  nt.forEachInSubTree("/a", [&] (const Entry& nte) {
+    BOOST_CHECK_MESSAGE(visited.insert(nte.getName()).second, "duplicate Name " << nte.getName());
+  });
+  BOOST_CHECK_EQUAL(visited.size(), 7);
+  BOOST_CHECK_EQUAL(visited.count("/"), 0);
+
+  // prune the subtree of /a/b
+  visited.clear();
+  nt.forEachInSubTree("/a", [&] (const Entry& nte) {
+    visited.insert(nte.getName());
+    return nte.getName() != "/a/b";
+  });
+  BOOST_CHECK_EQUAL(visited.size(), 5);
+  BOOST_CHECK_EQUAL(visited.count("/a/b"), 1);
+  BOOST_CHECK_EQUAL(visited.count("/a/b/1"), 0);
+  BOOST_CHECK_EQUAL(visited.count("/a/c/2"), 1);
+
+  // leaf entry
+  visited.clear();
+  nt.forEachInSubTree("/a/c/1", [&] (const Entry& nte) { visited.insert(nte.getName()); });
+  BOOST_CHECK_EQUAL(visited.size(), 1);
+
+  // nonexistent prefix
+  visited.clear();
+  nt.forEachInSubTree("/q", [&] (const Entry& nte) { visited.insert(nte.getName()); });
+  BOOST_CHECK_EQUAL(visited.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(HashTableResizeShrink)
 {
   size_t nBuckets = 16;
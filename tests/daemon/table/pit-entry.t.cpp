@@ -234,6 +234,56 @@ BOOST_AUTO_TEST_CASE(OutRecordNack)
   BOOST_CHECK(outR.getIncomingNack() == nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(ManyRecords)
+{
+  const size_t nFaces = 40;
+  std::vector<shared_ptr<Face>> faces;
+  for (size_t i = 0; i < nFaces; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+  }
+
+  auto interest = makeInterest("/A", false, std::nullopt, 1000);
+  Entry entry(*interest);
+  for (size_t i = 0; i < nFaces; ++i) {
+    interest->setNonce(1000 + i);
+    entry.insertOrUpdateInRecord(*faces[i], *interest);
+    entry.insertOrUpdateOutRecord(*faces[i], *interest);
+  }
+
+  // delete every third record; the remaining ones must still be found
+  for (size_t i = 0; i < nFaces; i += 3) {
+    entry.deleteInRecord(entry.findInRecord(*faces[i]));
+    entry.deleteOutRecord(*faces[i]);
+  }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), nFaces - (nFaces + 2) / 3);
+  for (size_t i = 0; i < nFaces; ++i) {
+    BOOST_TEST_INFO_SCOPE(i);
+    bool isDeleted = i % 3 == 0;
+    BOOST_CHECK_EQUAL(entry.findInRecord(*faces[i]) == entry.in_end(), isDeleted);
+    BOOST_CHECK_EQUAL(entry.findOutRecord(*faces[i]) == entry.out_end(), isDeleted);
+    if (!isDeleted) {
+      BOOST_CHECK_EQUAL(&entry.findInRecord(*faces[i])->getFace(), faces[i].get());
+    }
+
+    Interest::Nonce nonce(static_cast<uint32_t>(1000 + i));
+    auto expected = isDeleted ? std::pair(false, false) : std::pair(true, false);
+    BOOST_CHECK(entry.matchInRecordNonce(nonce, *faces[i]) == expected);
+    BOOST_CHECK(entry.matchOutRecordNonce(nonce, *faces[i]) == expected);
+    BOOST_CHECK(entry.matchInRecordNonce(nonce, *faces[(i + 1) % nFaces]) ==
+                std::pair(false, !isDeleted));
+  }
+
+  // updating a record updates its Nonce
+  interest->setNonce(1);
+  entry.insertOrUpdateInRecord(*faces[1], *interest);
+  BOOST_CHECK(entry.matchInRecordNonce(interest->getNonce(), *faces[1]) == std::pair(true, false));
+  BOOST_CHECK(entry.matchInRecordNonce(interest->getNonce(), *faces[2]) == std::pair(false, true));
+
+  entry.clearInRecords();
+  BOOST_CHECK(entry.findInRecord(*faces[1]) == entry.in_end());
+  BOOST_CHECK(entry.matchInRecordNonce(interest->getNonce(), *faces[1]) == std::pair(false, false));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestPitEntry
 BOOST_AUTO_TEST_SUITE_END() // Table
 
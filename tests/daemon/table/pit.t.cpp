@@ -248,6 +248,42 @@ BOOST_AUTO_TEST_CASE(FindAllDataMatches)
   BOOST_CHECK_EQUAL(count, 2);
 }
 
+BOOST_AUTO_TEST_CASE(FindAllDataMatchesSelectors)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+
+  auto interestA = makeInterest("/A", false);
+  auto interestAPrefix = makeInterest("/A", true);
+  auto interestABFresh = makeInterest("/A/B", false);
+  interestABFresh->setMustBeFresh(true);
+  auto entryA = pit.insert(*interestA).first;
+  auto entryAPrefix = pit.insert(*interestAPrefix).first;
+  auto entryABFresh = pit.insert(*interestABFresh).first;
+
+  auto dataA = makeData("/A");
+  DataMatchResult matches = pit.findAllDataMatches(*dataA);
+  BOOST_CHECK_EQUAL(matches.size(), 2);
+  BOOST_CHECK(std::count(matches.begin(), matches.end(), entryA) == 1);
+  BOOST_CHECK(std::count(matches.begin(), matches.end(), entryAPrefix) == 1);
+
+  // data without FreshnessPeriod cannot satisfy MustBeFresh
+  auto dataAB = makeData("/A/B");
+  matches = pit.findAllDataMatches(*dataAB);
+  BOOST_REQUIRE_EQUAL(matches.size(), 1);
+  BOOST_CHECK(matches.front() == entryAPrefix);
+
+  dataAB->setFreshnessPeriod(1_s);
+  matches = pit.findAllDataMatches(*dataAB);
+  BOOST_CHECK_EQUAL(matches.size(), 2);
+  BOOST_CHECK(std::count(matches.begin(), matches.end(), entryABFresh) == 1);
+
+  for (const auto& entry : {entryA, entryAPrefix, entryABFresh}) {
+    BOOST_CHECK_EQUAL(entry->canMatchData(*dataA), entry->getInterest().matchesData(*dataA));
+    BOOST_CHECK_EQUAL(entry->canMatchData(*dataAB), entry->getInterest().matchesData(*dataAB));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(MatchFullName) // Bug 3363
 {
   NameTree nameTree(16);
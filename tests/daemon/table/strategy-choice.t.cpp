@@ -256,6 +256,39 @@ BOOST_AUTO_TEST_CASE(FindEffectiveStrategyWithMeasurementsEntry)
   BOOST_CHECK_EQUAL(this->findInstanceName(mABCD), strategyNameQ);
 }
 
+BOOST_AUTO_TEST_CASE(FindEffectiveStrategyAfterChange)
+{
+  BOOST_CHECK(sc.insert("/", strategyNameP));
+
+  Pit& pit = forwarder.getPit();
+  shared_ptr<pit::Entry> pitABC = pit.insert(*makeInterest("/A/B/C")).first;
+  measurements::Entry& mAB = forwarder.getMeasurements().get("/A/B");
+
+  // first lookups memoize the effective strategy on NameTree entries
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), strategyNameP);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mAB), strategyNameP);
+  BOOST_CHECK_EQUAL(this->findInstanceName("/A/B/C"), strategyNameP);
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/"));
+
+  // insert on an ancestor invalidates memoized values
+  BOOST_CHECK(sc.insert("/A", strategyNameQ));
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), strategyNameQ);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mAB), strategyNameQ);
+  BOOST_CHECK_EQUAL(this->findInstanceName("/A/B/C"), strategyNameQ);
+
+  // changing the strategy of an existing entry replaces the instance
+  Name oneParamName = Name(strategyNameQ).append("param");
+  BOOST_CHECK(sc.insert("/A", oneParamName));
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), oneParamName);
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/A"));
+
+  // erase reverts to the parent's strategy
+  sc.erase("/A");
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), strategyNameP);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mAB), strategyNameP);
+  BOOST_CHECK_EQUAL(this->findInstanceName("/A/B/C"), strategyNameP);
+}
+
 BOOST_AUTO_TEST_CASE(Erase)
 {
   NameTree& nameTree = forwarder.getNameTree();
@@ -0,0 +1,579 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/internal-transport.hpp"
+#include "fw/face-table.hpp"
+#include "fw/forwarder.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+
+#include <sys/resource.h>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+// Count heap allocations, so that allocations per packet can be reported.
+// The benchmark is single-threaded, hence a plain counter suffices.
+static uint64_t g_nAllocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size); p != nullptr) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace nfd::tests {
+
+namespace po = boost::program_options;
+using Clock = std::chrono::steady_clock;
+
+struct BenchmarkOptions
+{
+  std::string traceFile;
+  size_t traceRouteLength = 2;
+  size_t nInterests = 1000000;
+  size_t nContents = 100000;
+  double zipfExponent = 0.9;
+  size_t nFibEntries = 100000;
+  size_t nConsumers = 8;
+  size_t nProducers = 4;
+  size_t batchSize = 64;
+  size_t producerDelay = 1;
+  size_t payloadSize = 256;
+  size_t csCapacity = 65536;
+  uint64_t seed = 1;
+};
+
+/**
+ * \brief Peer of an InternalForwarderTransport that hands every packet sent by NFD to a callback.
+ */
+class LoopbackPeer final : public face::InternalTransportBase
+{
+public:
+  void
+  receivePacket(const Block& packet) final
+  {
+    onReceive(packet);
+  }
+
+public:
+  std::function<void(const Block&)> onReceive;
+};
+
+/**
+ * \brief Replays a trace of Interests through a Forwarder with in-process loopback faces.
+ *
+ * Consumers inject Interests in batches. After each batch the event loop is run until idle.
+ * Producers answer every Interest with a pre-encoded Data after \c producerDelay batches,
+ * so that Interests for popular names arriving in the meantime are aggregated in the PIT.
+ */
+class ForwarderBenchmark
+{
+public:
+  explicit
+  ForwarderBenchmark(const BenchmarkOptions& options)
+    : m_options(options)
+    , m_rng(options.seed)
+  {
+    m_forwarder.getCs().setLimit(m_options.csCapacity);
+
+    for (size_t i = 0; i < m_options.nConsumers; ++i) {
+      m_consumers.push_back(makeLoopbackFace([this, i] (const Block& packet) {
+        onConsumerReceive(i, packet);
+      }));
+    }
+    for (size_t i = 0; i < m_options.nProducers; ++i) {
+      m_producers.push_back(makeLoopbackFace([this, i] (const Block& packet) {
+        onProducerReceive(i, packet);
+      }));
+    }
+
+    if (m_options.traceFile.empty()) {
+      generateTrace();
+    }
+    else {
+      loadTrace();
+    }
+    prepareCatalog();
+
+    m_pending.assign(m_options.nConsumers * m_catalog.size(), 0);
+    m_latencies.reserve(m_trace.size());
+  }
+
+  void
+  run()
+  {
+    struct rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    long setupRss = usage.ru_maxrss;
+    uint64_t nAllocationsBefore = g_nAllocations;
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = Clock::now();
+    for (size_t i = 0; i < m_trace.size(); ++i) {
+      const auto& [consumer, content] = m_trace[i];
+      auto& pending = m_pending[consumer * m_catalog.size() + content];
+      if (pending == 0) {
+        pending = Clock::now().time_since_epoch().count();
+      }
+      m_consumers[consumer].transport->receivePacket(m_interests[i]);
+
+      if ((i + 1) % m_options.batchSize == 0) {
+        endBatch();
+      }
+    }
+    while (!m_replies.empty()) {
+      endBatch();
+    }
+    endBatch();
+    auto t2 = Clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    ::getrusage(RUSAGE_SELF, &usage);
+    report(t2 - t1, g_nAllocations - nAllocationsBefore, setupRss, usage.ru_maxrss);
+  }
+
+private:
+  struct LoopbackFace
+  {
+    shared_ptr<Face> face;
+    face::InternalForwarderTransport* transport;
+    unique_ptr<LoopbackPeer> peer;
+  };
+
+  struct Reply
+  {
+    size_t batch;
+    size_t producer;
+    size_t content;
+  };
+
+  LoopbackFace
+  makeLoopbackFace(std::function<void(const Block&)> onReceive)
+  {
+    auto transport = make_unique<face::InternalForwarderTransport>(
+      FaceUri("internal://"), FaceUri("internal://"), ndn::nfd::FACE_SCOPE_NON_LOCAL);
+    LoopbackFace lf{nullptr, transport.get(), make_unique<LoopbackPeer>()};
+    lf.peer->onReceive = std::move(onReceive);
+    lf.transport->setPeer(lf.peer.get());
+    lf.face = make_shared<Face>(make_unique<face::GenericLinkService>(), std::move(transport));
+    m_faceTable.add(lf.face);
+    return lf;
+  }
+
+  std::string
+  makeComponent()
+  {
+    static constexpr std::string_view CHARS = "abcdefghijklmnopqrstuvwxyz0123456789";
+    std::uniform_int_distribution<size_t> lengthDist(3, 12);
+    std::uniform_int_distribution<size_t> charDist(0, CHARS.size() - 1);
+    std::string component(lengthDist(m_rng), '\0');
+    for (auto& c : component) {
+      c = CHARS[charDist(m_rng)];
+    }
+    return component;
+  }
+
+  Name
+  makePrefix()
+  {
+    // most routable prefixes have two or three components
+    std::discrete_distribution<size_t> lengthDist({0, 5, 35, 35, 20, 5});
+    Name prefix;
+    for (size_t i = lengthDist(m_rng); i > 0; --i) {
+      prefix.append(makeComponent().data());
+    }
+    return prefix;
+  }
+
+  void
+  addRoutes(const std::vector<Name>& prefixes)
+  {
+    Fib& fib = m_forwarder.getFib();
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+      fib::Entry* entry = fib.insert(prefixes[i]).first;
+      fib.addOrUpdateNextHop(*entry, *m_producers[i % m_producers.size()].face, 0);
+    }
+  }
+
+  void
+  addFillerRoutes(size_t nExisting)
+  {
+    std::vector<Name> prefixes;
+    for (size_t i = nExisting; i < m_options.nFibEntries; ++i) {
+      prefixes.push_back(makePrefix());
+    }
+    addRoutes(prefixes);
+  }
+
+  void
+  generateTrace()
+  {
+    std::vector<Name> prefixes;
+    prefixes.reserve(m_options.nFibEntries);
+    for (size_t i = 0; i < m_options.nFibEntries; ++i) {
+      prefixes.push_back(makePrefix());
+    }
+    addRoutes(prefixes);
+
+    std::uniform_int_distribution<size_t> prefixDist(0, prefixes.size() - 1);
+    std::uniform_int_distribution<size_t> suffixDist(1, 3);
+    m_catalog.reserve(m_options.nContents);
+    for (size_t i = 0; i < m_options.nContents; ++i) {
+      Name name = prefixes[prefixDist(m_rng)];
+      for (size_t j = suffixDist(m_rng); j > 0; --j) {
+        name.append(makeComponent().data());
+      }
+      m_catalog.push_back(name.appendSegment(i));
+    }
+
+    // Zipf-distributed popularity over the catalog
+    std::vector<double> cdf(m_catalog.size());
+    double sum = 0;
+    for (size_t i = 0; i < cdf.size(); ++i) {
+      sum += 1.0 / std::pow(static_cast<double>(i + 1), m_options.zipfExponent);
+      cdf[i] = sum;
+    }
+    std::uniform_real_distribution<double> uniform(0, sum);
+    std::uniform_int_distribution<size_t> consumerDist(0, m_options.nConsumers - 1);
+    m_trace.reserve(m_options.nInterests);
+    for (size_t i = 0; i < m_options.nInterests; ++i) {
+      size_t content = std::lower_bound(cdf.begin(), cdf.end(), uniform(m_rng)) - cdf.begin();
+      m_trace.emplace_back(consumerDist(m_rng), std::min(content, cdf.size() - 1));
+    }
+  }
+
+  void
+  loadTrace()
+  {
+    std::ifstream file(m_options.traceFile);
+    if (!file) {
+      NDN_THROW(std::runtime_error("Cannot open trace file " + m_options.traceFile));
+    }
+
+    std::map<Name, size_t> contents;
+    std::vector<Name> prefixes;
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty() || line.front() == '#') {
+        continue;
+      }
+      Name name(line);
+      auto [it, isNew] = contents.try_emplace(name, m_catalog.size());
+      if (isNew) {
+        m_catalog.push_back(name);
+        prefixes.push_back(name.getPrefix(std::min(m_options.traceRouteLength, name.size())));
+      }
+      m_trace.emplace_back(m_trace.size() % m_options.nConsumers, it->second);
+    }
+
+    std::sort(prefixes.begin(), prefixes.end());
+    prefixes.erase(std::unique(prefixes.begin(), prefixes.end()), prefixes.end());
+    addRoutes(prefixes);
+    addFillerRoutes(prefixes.size());
+  }
+
+  void
+  prepareCatalog()
+  {
+    std::vector<uint8_t> payload(m_options.payloadSize, 0xBB);
+    m_data.reserve(m_catalog.size());
+    for (size_t i = 0; i < m_catalog.size(); ++i) {
+      Data data(m_catalog[i]);
+      data.setFreshnessPeriod(10_s);
+      data.setContent(payload);
+      data.setSignatureInfo(ndn::SignatureInfo(tlv::NullSignature));
+      data.setSignatureValue(std::make_shared<ndn::Buffer>());
+      m_data.push_back(data.wireEncode());
+    }
+    // the index refers to the Name elements of m_data, which stay alive
+    m_contentIndex.reserve(m_data.size());
+    for (size_t i = 0; i < m_data.size(); ++i) {
+      m_contentIndex.emplace(getNameWire(m_data[i]), i);
+    }
+
+    m_interests.reserve(m_trace.size());
+    for (const auto& [consumer, content] : m_trace) {
+      Interest interest(m_catalog[content]);
+      interest.setNonce(Interest::Nonce(ndn::random::generateWord32()));
+      m_interests.push_back(interest.wireEncode());
+    }
+  }
+
+  /**
+   * \brief Returns the wire encoding of the Name element of an Interest or Data.
+   */
+  static std::string_view
+  getNameWire(const Block& packet)
+  {
+    auto pos = packet.value_begin();
+    auto nameBegin = pos;
+    tlv::readType(pos, packet.value_end());
+    uint64_t length = tlv::readVarNumber(pos, packet.value_end());
+    return {reinterpret_cast<const char*>(&*nameBegin),
+            static_cast<size_t>(std::distance(nameBegin, pos)) + static_cast<size_t>(length)};
+  }
+
+  std::optional<size_t>
+  findContent(const Block& packet) const
+  {
+    Block netPacket = packet;
+    if (packet.type() == lp::tlv::LpPacket) {
+      lp::Packet lpPacket(packet);
+      if (!lpPacket.has<lp::FragmentField>()) {
+        return std::nullopt;
+      }
+      auto [begin, end] = lpPacket.get<lp::FragmentField>();
+      netPacket = Block(span<const uint8_t>(&*begin, static_cast<size_t>(std::distance(begin, end))));
+    }
+    auto it = m_contentIndex.find(getNameWire(netPacket));
+    if (it == m_contentIndex.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  void
+  onConsumerReceive(size_t consumer, const Block& packet)
+  {
+    auto content = findContent(packet);
+    if (!content) {
+      return;
+    }
+    auto& pending = m_pending[consumer * m_catalog.size() + *content];
+    if (pending != 0) {
+      m_latencies.push_back(Clock::now().time_since_epoch().count() - pending);
+      pending = 0;
+    }
+  }
+
+  void
+  onProducerReceive(size_t producer, const Block& packet)
+  {
+    auto content = findContent(packet);
+    if (content) {
+      m_replies.push_back({m_nBatches, producer, *content});
+    }
+  }
+
+  void
+  endBatch()
+  {
+    auto& io = getGlobalIoService();
+    io.restart();
+    io.poll();
+
+    ++m_nBatches;
+    while (!m_replies.empty() && m_replies.front().batch + m_options.producerDelay < m_nBatches) {
+      const auto& reply = m_replies.front();
+      m_producers[reply.producer].transport->receivePacket(m_data[reply.content]);
+      m_replies.pop_front();
+    }
+    io.restart();
+    io.poll();
+  }
+
+  void
+  report(Clock::duration duration, uint64_t nAllocations, long setupRss, long peakRss)
+  {
+    double seconds = std::chrono::duration<double>(duration).count();
+    const auto& counters = m_forwarder.getCounters();
+    uint64_t nPackets = counters.nInInterests + counters.nInData;
+
+    std::sort(m_latencies.begin(), m_latencies.end());
+    auto percentile = [this] (double p) -> double {
+      if (m_latencies.empty()) {
+        return 0;
+      }
+      size_t i = std::min(m_latencies.size() - 1, static_cast<size_t>(p * m_latencies.size()));
+      return m_latencies[i] / 1000.0;
+    };
+
+    std::cout << "{\"interests\":" << m_trace.size()
+              << ",\"contents\":" << m_catalog.size()
+              << ",\"fib_entries\":" << m_forwarder.getFib().size()
+              << ",\"consumers\":" << m_options.nConsumers
+              << ",\"producers\":" << m_options.nProducers
+              << ",\"duration_s\":" << seconds
+              << ",\"interests_per_s\":" << m_trace.size() / seconds
+              << ",\"packets_per_s\":" << nPackets / seconds
+              << ",\"satisfied\":" << m_latencies.size()
+              << ",\"cs_hits\":" << counters.nCsHits
+              << ",\"out_interests\":" << counters.nOutInterests
+              << ",\"aggregated\":"
+              << counters.nInInterests - counters.nOutInterests - counters.nCsHits
+              << ",\"latency_us\":{\"p50\":" << percentile(0.5)
+              << ",\"p90\":" << percentile(0.9)
+              << ",\"p99\":" << percentile(0.99)
+              << ",\"p999\":" << percentile(0.999)
+              << ",\"max\":" << percentile(1.0) << "}"
+              << ",\"allocations_per_packet\":"
+              << (nPackets == 0 ? 0.0 : static_cast<double>(nAllocations) / nPackets)
+              << ",\"setup_rss_kib\":" << setupRss
+              << ",\"peak_rss_kib\":" << peakRss
+              << "}" << std::endl;
+  }
+
+private:
+  const BenchmarkOptions m_options;
+  std::mt19937_64 m_rng;
+
+  FaceTable m_faceTable;
+  Forwarder m_forwarder{m_faceTable};
+  std::vector<LoopbackFace> m_consumers;
+  std::vector<LoopbackFace> m_producers;
+
+  std::vector<Name> m_catalog;
+  std::vector<Block> m_data;
+  std::unordered_map<std::string_view, size_t> m_contentIndex;
+  /// (consumer, content) of each Interest
+  std::vector<std::pair<size_t, size_t>> m_trace;
+  std::vector<Block> m_interests;
+
+  /// (consumer, content) => time of the first unsatisfied Interest, in Clock ticks
+  std::vector<Clock::rep> m_pending;
+  std::vector<Clock::rep> m_latencies;
+  std::deque<Reply> m_replies;
+  size_t m_nBatches = 0;
+};
+
+} // namespace nfd::tests
+
+int
+main(int argc, char** argv)
+{
+#ifndef NDEBUG
+  std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+  namespace po = boost::program_options;
+  nfd::tests::BenchmarkOptions options;
+
+  po::options_description description("Options");
+  description.add_options()
+    ("help,h", "print this message and exit")
+    ("trace", po::value<std::string>(&options.traceFile),
+     "replay Interest names from this file, one per line, instead of generating a trace")
+    ("trace-route-length", po::value<size_t>(&options.traceRouteLength)->default_value(options.traceRouteLength),
+     "number of leading name components of each trace name that are routed")
+    ("interests", po::value<size_t>(&options.nInterests)->default_value(options.nInterests),
+     "number of Interests in a generated trace")
+    ("contents", po::value<size_t>(&options.nContents)->default_value(options.nContents),
+     "number of distinct names in a generated trace")
+    ("zipf", po::value<double>(&options.zipfExponent)->default_value(options.zipfExponent),
+     "exponent of the Zipf popularity distribution of a generated trace")
+    ("fib-size", po::value<size_t>(&options.nFibEntries)->default_value(options.nFibEntries),
+     "number of FIB entries")
+    ("consumers", po::value<size_t>(&options.nConsumers)->default_value(options.nConsumers),
+     "number of downstream faces")
+    ("producers", po::value<size_t>(&options.nProducers)->default_value(options.nProducers),
+     "number of upstream faces")
+    ("batch", po::value<size_t>(&options.batchSize)->default_value(options.batchSize),
+     "number of Interests injected per event loop turn")
+    ("producer-delay", po::value<size_t>(&options.producerDelay)->default_value(options.producerDelay),
+     "number of event loop turns before a producer replies")
+    ("payload", po::value<size_t>(&options.payloadSize)->default_value(options.payloadSize),
+     "Data payload size in bytes")
+    ("cs-capacity", po::value<size_t>(&options.csCapacity)->default_value(options.csCapacity),
+     "Content Store capacity in packets")
+    ("seed", po::value<uint64_t>(&options.seed)->default_value(options.seed),
+     "random seed for trace generation")
+    ;
+
+  try {
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, description), vm);
+    po::notify(vm);
+
+    if (vm.count("help") > 0) {
+      std::cout << "Usage: " << argv[0] << " [options]\n\n" << description;
+      return 0;
+    }
+    if (options.nConsumers == 0 || options.nProducers == 0 || options.batchSize == 0 ||
+        (options.traceFile.empty() && (options.nContents == 0 || options.nFibEntries == 0))) {
+      std::cerr << "ERROR: counts must be positive\n";
+      return 2;
+    }
+
+    nfd::tests::ForwarderBenchmark bench(options);
+    bench.run();
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << "\n\n" << description;
+    return 2;
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << boost::diagnostic_information(e);
+    return 1;
+  }
+
+  return 0;
+}
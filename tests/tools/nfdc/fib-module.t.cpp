@@ -85,7 +85,10 @@ BOOST_AUTO_TEST_CASE(Status)
   payload2.setPrefix("/localhost/nfd")
           .addNextHopRecord(NextHopRecord().setFaceId(1).setCost(0))
           .addNextHopRecord(NextHopRecord().setFaceId(274).setCost(0));
-  this->sendDataset("/localhost/nfd/fib/list", payload1, payload2);
+  this->sendDataset("/localhost/nfd/fib/list/page", payload1, payload2);
+  this->advanceClocks(1_ms);
+  this->sendEmptyDataset(Name("/localhost/nfd/fib/list/page")
+                         .append(payload2.getPrefix().wireEncode()));
   this->prepareStatusOutput();
 
   BOOST_CHECK(statusXml.is_equal(STATUS_XML));
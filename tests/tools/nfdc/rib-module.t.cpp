@@ -33,13 +33,20 @@ namespace nfd::tools::nfdc::tests {
 BOOST_AUTO_TEST_SUITE(Nfdc)
 BOOST_FIXTURE_TEST_SUITE(TestRibModule, StatusFixture<RibModule>)
 
+const Name RIB_PAGE_PREFIX("/localhost/nfd/rib/list/page");
+
 class RouteListFixture : public ExecuteCommandFixture
 {
 protected:
   bool
   respondRibDataset(const Interest& interest)
   {
-    if (!Name("/localhost/nfd/rib/list").isPrefixOf(interest.getName())) {
+    if (interest.getName() == Name(RIB_PAGE_PREFIX).append(Name("/aDPTKCio").wireEncode())) {
+      // both entries fit in the first page, so the second page is empty
+      this->sendEmptyDataset(interest.getName());
+      return true;
+    }
+    if (interest.getName() != RIB_PAGE_PREFIX) {
       return false;
     }
 
@@ -185,6 +192,54 @@ BOOST_AUTO_TEST_CASE(RouteNotExist)
   BOOST_CHECK(err.is_equal("Route not found\n"));
 }
 
+BOOST_AUTO_TEST_CASE(ListMultiplePages)
+{
+  auto makeEntry = [] (const Name& name, uint64_t faceId) {
+    RibEntry entry;
+    entry.setName(name);
+    entry.addRoute(Route().setFaceId(faceId).setOrigin(ndn::nfd::ROUTE_ORIGIN_STATIC).setCost(1));
+    return entry;
+  };
+
+  this->processInterest = [&] (const Interest& interest) {
+    if (interest.getName() == RIB_PAGE_PREFIX) {
+      this->sendDataset(interest.getName(), makeEntry("/A", 1), makeEntry("/B", 2));
+    }
+    else if (interest.getName() == Name(RIB_PAGE_PREFIX).append(Name("/B").wireEncode())) {
+      this->sendDataset(interest.getName(), makeEntry("/C", 3));
+    }
+    else if (interest.getName() == Name(RIB_PAGE_PREFIX).append(Name("/C").wireEncode())) {
+      this->sendEmptyDataset(interest.getName());
+    }
+    else {
+      BOOST_ERROR("unexpected Interest " << interest.getName());
+    }
+  };
+
+  this->execute("route list");
+  BOOST_CHECK_EQUAL(exitCode, 0);
+  BOOST_CHECK(out.is_equal("prefix=/A nexthop=1 origin=static cost=1 flags=none expires=never\n"
+                           "prefix=/B nexthop=2 origin=static cost=1 flags=none expires=never\n"
+                           "prefix=/C nexthop=3 origin=static cost=1 flags=none expires=never\n"));
+  BOOST_CHECK(err.is_empty());
+}
+
+BOOST_AUTO_TEST_CASE(ErrorPageOutOfOrder)
+{
+  this->processInterest = [this] (const Interest& interest) {
+    // a server that ignores the cursor returns the same page again
+    RibEntry entry;
+    entry.setName("/A");
+    entry.addRoute(Route().setFaceId(1).setOrigin(ndn::nfd::ROUTE_ORIGIN_STATIC).setCost(1));
+    this->sendDataset(interest.getName(), entry);
+  };
+
+  this->execute("route list");
+  BOOST_CHECK_EQUAL(exitCode, 1);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("Error 500 when fetching RIB dataset: dataset page does not follow /A\n"));
+}
+
 BOOST_AUTO_TEST_CASE(ErrorDataset)
 {
   this->processInterest = nullptr; // no response to dataset
@@ -605,7 +660,9 @@ BOOST_AUTO_TEST_CASE(Status)
                            .setOrigin(ndn::nfd::ROUTE_ORIGIN_APP)
                            .setCost(0)
                            .setFlags(ndn::nfd::ROUTE_FLAG_CHILD_INHERIT));
-  this->sendDataset("/localhost/nfd/rib/list", payload1, payload2);
+  this->sendDataset(RIB_PAGE_PREFIX, payload1, payload2);
+  this->advanceClocks(1_ms);
+  this->sendEmptyDataset(Name(RIB_PAGE_PREFIX).append(payload2.getName().wireEncode()));
   this->prepareStatusOutput();
 
   BOOST_CHECK(statusXml.is_equal(STATUS_XML));
@@ -25,8 +25,7 @@
 
 #include "fib-module.hpp"
 #include "format-helpers.hpp"
-
-#include <ndn-cxx/mgmt/nfd/status-dataset.hpp>
+#include "paged-dataset.hpp"
 
 namespace nfd::tools::nfdc {
 
@@ -36,7 +35,7 @@ FibModule::fetchStatus(ndn::nfd::Controller& controller,
                        const ndn::nfd::DatasetFailureCallback& onFailure,
                        const CommandOptions& options)
 {
-  controller.fetch<ndn::nfd::FibDataset>(
+  fetchPagedDataset<ndn::nfd::FibDataset>(controller,
     [this, onSuccess] (const std::vector<FibEntry>& result) {
       m_status = result;
       onSuccess();
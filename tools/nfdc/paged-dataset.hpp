@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_TOOLS_NFDC_PAGED_DATASET_HPP
+#define NFD_TOOLS_NFDC_PAGED_DATASET_HPP
+
+#include "core/common.hpp"
+#include "module.hpp"
+
+#include <ndn-cxx/mgmt/nfd/status-dataset.hpp>
+
+#include <optional>
+
+namespace nfd::tools::nfdc {
+
+/**
+ * \brief Describes a StatusDataset that NFD can serve in pages.
+ * \tparam Dataset the whole dataset, e.g., ndn::nfd::FibDataset
+ */
+template<typename Dataset>
+struct PagedDatasetTraits;
+
+template<>
+struct PagedDatasetTraits<ndn::nfd::FibDataset>
+{
+  static constexpr const char* DATASET_NAME = "fib/list";
+
+  static const Name&
+  getEntryName(const ndn::nfd::FibEntry& entry)
+  {
+    return entry.getPrefix();
+  }
+};
+
+template<>
+struct PagedDatasetTraits<ndn::nfd::RibDataset>
+{
+  static constexpr const char* DATASET_NAME = "rib/list";
+
+  static const Name&
+  getEntryName(const ndn::nfd::RibEntry& entry)
+  {
+    return entry.getName();
+  }
+};
+
+/**
+ * \brief One page of a StatusDataset.
+ *
+ * The page is requested by appending `page` to the dataset name, followed by a component
+ * containing the TLV encoding of the name of the last entry received, if any.
+ */
+template<typename Dataset>
+class DatasetPage : public ndn::nfd::StatusDataset
+{
+public:
+  /// name of the last entry in the previous page, or nullopt for the first page
+  using ParamType = std::optional<Name>;
+  using ResultType = typename Dataset::ResultType;
+
+  explicit
+  DatasetPage(const ParamType& after)
+    : StatusDataset(PagedDatasetTraits<Dataset>::DATASET_NAME)
+    , m_after(after)
+  {
+  }
+
+  ResultType
+  parseResult(ndn::ConstBufferPtr payload) const
+  {
+    return Dataset().parseResult(std::move(payload));
+  }
+
+private:
+  void
+  addParameters(Name& name) const final
+  {
+    name.append("page");
+    if (m_after) {
+      name.append(m_after->wireEncode());
+    }
+  }
+
+private:
+  ParamType m_after;
+};
+
+namespace detail {
+
+template<typename Dataset>
+void
+fetchPagesAfter(ndn::nfd::Controller& controller, const std::optional<Name>& after,
+                const shared_ptr<typename Dataset::ResultType>& result,
+                const std::function<void(typename Dataset::ResultType)>& onSuccess,
+                const ndn::nfd::DatasetFailureCallback& onFailure,
+                const CommandOptions& options)
+{
+  controller.fetch<DatasetPage<Dataset>>(after,
+    [=, &controller] (typename Dataset::ResultType page) {
+      if (page.empty()) {
+        onSuccess(std::move(*result));
+        return;
+      }
+
+      // each page must start after the cursor, otherwise the loop would never end
+      if (after && !(*after < PagedDatasetTraits<Dataset>::getEntryName(page.front()))) {
+        onFailure(ndn::nfd::Controller::ERROR_SERVER,
+                  "dataset page does not follow " + after->toUri());
+        return;
+      }
+
+      Name last = PagedDatasetTraits<Dataset>::getEntryName(page.back());
+      result->insert(result->end(), std::make_move_iterator(page.begin()),
+                     std::make_move_iterator(page.end()));
+      fetchPagesAfter<Dataset>(controller, last, result, onSuccess, onFailure, options);
+    },
+    onFailure, options);
+}
+
+} // namespace detail
+
+/**
+ * \brief Fetches a StatusDataset page by page.
+ *
+ * A table with millions of entries is retrieved with many short requests instead of a
+ * single long one, so that NFD keeps forwarding packets between the pages. Each page is
+ * requested after the last entry of the previous one, and the first empty page ends the
+ * retrieval. \p onSuccess receives the concatenation of all pages.
+ *
+ * \tparam Dataset the whole dataset; PagedDatasetTraits must be specialized for it
+ */
+template<typename Dataset>
+void
+fetchPagedDataset(ndn::nfd::Controller& controller,
+                  const std::function<void(typename Dataset::ResultType)>& onSuccess,
+                  const ndn::nfd::DatasetFailureCallback& onFailure,
+                  const CommandOptions& options)
+{
+  detail::fetchPagesAfter<Dataset>(controller, std::nullopt,
+                                   make_shared<typename Dataset::ResultType>(),
+                                   onSuccess, onFailure, options);
+}
+
+} // namespace nfd::tools::nfdc
+
+#endif // NFD_TOOLS_NFDC_PAGED_DATASET_HPP
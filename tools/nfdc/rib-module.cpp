@@ -27,8 +27,7 @@
 #include "face-module.hpp"
 #include "face-helpers.hpp"
 #include "format-helpers.hpp"
-
-#include <ndn-cxx/mgmt/nfd/status-dataset.hpp>
+#include "paged-dataset.hpp"
 
 namespace nfd::tools::nfdc {
 
@@ -117,8 +116,8 @@ RibModule::show(ExecuteContext& ctx)
 void
 RibModule::listRoutesImpl(ExecuteContext& ctx, const RoutePredicate& filter)
 {
-  ctx.controller.fetch<ndn::nfd::RibDataset>(
-    [&] (const auto& dataset) {
+  fetchPagedDataset<ndn::nfd::RibDataset>(ctx.controller,
+    [&] (const std::vector<RibEntry>& dataset) {
       bool hasRoute = false;
       for (const RibEntry& entry : dataset) {
         for (const Route& route : entry.getRoutes()) {
@@ -307,8 +306,8 @@ RibModule::fetchStatus(ndn::nfd::Controller& controller,
                        const ndn::nfd::DatasetFailureCallback& onFailure,
                        const CommandOptions& options)
 {
-  controller.fetch<ndn::nfd::RibDataset>(
-    [this, onSuccess] (const auto& result) {
+  fetchPagedDataset<ndn::nfd::RibDataset>(controller,
+    [this, onSuccess] (const std::vector<RibEntry>& result) {
       m_status = result;
       onSuccess();
     },